@@ -200,7 +200,8 @@ bool probeBinary(DetectionInfo &info)
           }
           if (detected != EtonyekDocument::TYPE_UNKNOWN)
             break;
-          // undecise, try to find the first ref
+          // undecise, try to find the first ref; only the fragment
+          // containing it is uncompressed
           IWAObjectIndex objIndex(info.m_fragments, info.m_package);
           objIndex.parse();
           auto type = objIndex.getObjectType(potentialRef[0]);
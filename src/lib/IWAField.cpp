@@ -27,6 +27,21 @@ bool IWAField::operator!() const
   return !is();
 }
 
+namespace detail
+{
+
+std::size_t valueMemoryUsage(const std::string &value)
+{
+  return value.capacity();
+}
+
+std::size_t valueMemoryUsage(const IWAMessage &value)
+{
+  return value.memoryUsage();
+}
+
+}
+
 const IWAUInt32Field &IWAMessageField::uint32(const std::size_t field) const
 {
   return get().uint32(field);
@@ -13,8 +13,11 @@
 #include <deque>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 
 #include <boost/container/deque.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 
 #include "IWAReader.h"
@@ -62,6 +65,9 @@ public:
   bool operator!() const;
 
   virtual void parse(const RVNGInputStreamPtr_t &input, unsigned long length, bool allowEmpty) = 0;
+
+  /// Get an estimate of the memory used by the field, including the field itself.
+  virtual std::size_t memoryUsage() const = 0;
 };
 
 typedef std::shared_ptr<IWAField> IWAFieldPtr_t;
@@ -69,10 +75,66 @@ typedef std::shared_ptr<IWAField> IWAFieldPtr_t;
 namespace detail
 {
 
+/// Can values be read by the reader directly from a contiguous buffer?
+template<typename Reader>
+struct IWAContiguousReader : std::true_type
+{
+};
+
+template<>
+struct IWAContiguousReader<IWAReader::Bytes> : std::false_type
+{
+};
+
+template<>
+struct IWAContiguousReader<IWAReader::Message> : std::false_type
+{
+};
+
+/** Container of field values.
+  *
+  * Most fields have just a single value, so keep it inline. Messages
+  * are stored in a deque, because IWAMessage is incomplete here.
+  */
+template<typename ValueT>
+struct IWAFieldContainer
+{
+  typedef boost::container::small_vector<ValueT, 1> type;
+};
+
+template<>
+struct IWAFieldContainer<IWAMessage>
+{
+  typedef boost::container::deque<IWAMessage> type;
+};
+
+template<typename ValueT, std::size_t N>
+std::size_t containerMemoryUsage(const boost::container::small_vector<ValueT, N> &values)
+{
+  return (values.capacity() > N) ? values.capacity() * sizeof(ValueT) : 0;
+}
+
+template<typename ValueT>
+std::size_t containerMemoryUsage(const boost::container::deque<ValueT> &values)
+{
+  return values.size() * sizeof(ValueT);
+}
+
+/// Get the memory a value holds outside of itself.
+template<typename ValueT>
+std::size_t valueMemoryUsage(const ValueT &)
+{
+  // NOTE: this includes bytes, as they mostly share the data of the input
+  return 0;
+}
+
+std::size_t valueMemoryUsage(const std::string &value);
+std::size_t valueMemoryUsage(const IWAMessage &value);
+
 template<IWAField::Tag TagV, typename ValueT, typename Reader>
 class IWAFieldImpl : public IWAField
 {
-  typedef boost::container::deque<ValueT> container_type;
+  typedef typename IWAFieldContainer<ValueT>::type container_type;
 
 public:
   typedef ValueT value_type;
@@ -167,12 +229,7 @@ public:
   {
     if (length != 0)
     {
-      const long start = input->tell();
-      while (!input->isEnd() && (length > static_cast<unsigned long>(input->tell() - start)))
-      {
-        const value_type value(Reader::read(input, length));
-        m_values.push_back(value);
-      }
+      parseValues(input, length, IWAContiguousReader<Reader>());
     }
     else if (allowEmpty)
     {
@@ -180,6 +237,50 @@ public:
     }
   }
 
+  std::size_t memoryUsage() const override
+  {
+    std::size_t usage = sizeof(*this) + containerMemoryUsage(m_values);
+    for (const auto &value : m_values)
+      usage += valueMemoryUsage(value);
+    return usage;
+  }
+
+private:
+  void parseValues(const RVNGInputStreamPtr_t &input, const unsigned long length, std::true_type)
+  {
+    const long start = input->tell();
+    unsigned long numBytesRead = 0;
+    const unsigned char *const data = input->read(length, numBytesRead);
+    const unsigned char *p = data;
+    if (data && (numBytesRead == length))
+    {
+      const unsigned char *const end = data + length;
+      try
+      {
+        while (p != end)
+          m_values.push_back(Reader::read(p, end));
+        return;
+      }
+      catch (const EndOfStreamException &)
+      {
+        // the last value continues past the end: let the stream handle it
+      }
+    }
+    const auto done = static_cast<unsigned long>(p - data);
+    input->seek(start + long(done), librevenge::RVNG_SEEK_SET);
+    parseValues(input, length - done, std::false_type());
+  }
+
+  void parseValues(const RVNGInputStreamPtr_t &input, const unsigned long length, std::false_type)
+  {
+    const long start = input->tell();
+    while (!input->isEnd() && (length > static_cast<unsigned long>(input->tell() - start)))
+    {
+      const value_type value(Reader::read(input, length));
+      m_values.push_back(value);
+    }
+  }
+
 private:
   container_type m_values;
 };
@@ -9,14 +9,13 @@
 
 #include "IWAMessage.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
 namespace libetonyek
 {
 
-using std::make_pair;
-
 namespace
 {
 
@@ -25,21 +24,30 @@ struct ParseError {};
 
 }
 
-IWAMessage::Field::Field(const IWAMessage::WireType wireType)
-  : m_wireType(wireType)
-  , m_pieces()
-  , m_realField()
+IWAMessage::Piece::Piece(const unsigned field, const IWAMessage::WireType wireType, const long start, const long end)
+  : m_field(field)
+  , m_wireType(wireType)
+  , m_start(start)
+  , m_end(end)
+{
+}
+
+IWAMessage::Field::Field(const unsigned field, const IWAFieldPtr_t &realField)
+  : m_field(field)
+  , m_realField(realField)
 {
 }
 
 IWAMessage::IWAMessage()
   : m_input()
+  , m_pieces()
   , m_fields()
 {
 }
 
 IWAMessage::IWAMessage(const RVNGInputStreamPtr_t &input, unsigned long length)
   : m_input(input)
+  , m_pieces()
   , m_fields()
 {
   if (length == 0)
@@ -50,6 +58,7 @@ IWAMessage::IWAMessage(const RVNGInputStreamPtr_t &input, unsigned long length)
 
 IWAMessage::IWAMessage(const RVNGInputStreamPtr_t &input, const long start, const long end)
   : m_input(input)
+  , m_pieces()
   , m_fields()
 {
   assert(end >= start);
@@ -60,10 +69,77 @@ IWAMessage::IWAMessage(const RVNGInputStreamPtr_t &input, const long start, cons
     parse(static_cast<unsigned long>(end - start));
 }
 
-void IWAMessage::parse(const unsigned long length) try
+void IWAMessage::parse(const unsigned long length)
 {
   assert(bool(m_input));
 
+  const long startPos = m_input->tell();
+
+  // Messages are normally read from a memory-backed stream, so we can
+  // get the whole message at once and decode it in place.
+  unsigned long numBytesRead = 0;
+  const unsigned char *const data = m_input->read(length, numBytesRead);
+  if (data && (numBytesRead == length))
+  {
+    parse(data, data + length, startPos);
+  }
+  else
+  {
+    m_input->seek(startPos, librevenge::RVNG_SEEK_SET);
+    parseStream(length);
+  }
+  sortPieces();
+}
+
+void IWAMessage::parse(const unsigned char *const data, const unsigned char *const dataEnd, const long startPos) try
+{
+  const unsigned char *p = data;
+  while (p != dataEnd)
+  {
+    const auto spec = unsigned(readUVar(p, dataEnd));
+    const unsigned wireType = spec & 0x7;
+
+    const unsigned char *start = p;
+
+    switch (wireType)
+    {
+    case 0:
+      readUVar(p, dataEnd);
+      break;
+    case 1:
+      if (dataEnd - p < 8)
+        throw ParseError();
+      p += 8;
+      break;
+    case 2:
+    {
+      const uint64_t len = readUVar(p, dataEnd);
+      start = p; // the field parser expects just the actual data
+      if (uint64_t(dataEnd - p) < len)
+        throw ParseError();
+      p += len;
+      break;
+    }
+    case 5:
+      if (dataEnd - p < 4)
+        throw ParseError();
+      p += 4;
+      break;
+    default:
+      ETONYEK_DEBUG_MSG(("IWAMessage::IWAMessage: unexpected wire type %d\n", wireType));
+      throw ParseError();
+    }
+
+    addPiece(spec, startPos + (start - data), startPos + (p - data));
+  }
+}
+catch (...)
+{
+  // see parseStream
+}
+
+void IWAMessage::parseStream(const unsigned long length) try
+{
   const long startPos = m_input->tell();
   while (!m_input->isEnd() && (length > static_cast<unsigned long>(m_input->tell() - startPos)))
   {
@@ -98,19 +174,7 @@ void IWAMessage::parse(const unsigned long length) try
 
     const long end = m_input->tell();
     if (length >= static_cast<unsigned long>(end - startPos))
-    {
-      const unsigned field = spec >> 3;
-      auto it = m_fields.find(field);
-      if ((it != m_fields.end()) && (it->second.m_wireType != WireType(wireType)))
-      {
-        ETONYEK_DEBUG_MSG(("IWAMessage::IWAMessage: wire type %d of field %d does not match previously seen %d\n", wireType, field, it->second.m_wireType));
-        continue;
-      }
-      if (it == m_fields.end())
-        it = m_fields.insert(make_pair(field, Field(WireType(wireType)))).first;
-      assert(it != m_fields.end());
-      it->second.m_pieces.push_back(make_pair(start, end));
-    }
+      addPiece(spec, start, end);
   }
 }
 catch (...)
@@ -121,6 +185,44 @@ catch (...)
   // to get as much data as possible, ignoring parsing errors.
 }
 
+void IWAMessage::addPiece(const unsigned spec, const long start, const long end)
+{
+  m_pieces.push_back(Piece(spec >> 3, WireType(spec & 0x7), start, end));
+}
+
+void IWAMessage::sortPieces()
+{
+  // Fields are normally written in order, so this is mostly a no-op.
+  // The sort must be stable to keep the order of repeated values.
+  const auto fieldLess = [](const Piece &left, const Piece &right)
+  {
+    return left.m_field < right.m_field;
+  };
+  if (!std::is_sorted(m_pieces.begin(), m_pieces.end(), fieldLess))
+    std::stable_sort(m_pieces.begin(), m_pieces.end(), fieldLess);
+
+  // drop pieces whose wire type does not match the first occurrence of the field
+  unsigned field = 0;
+  WireType wireType = WIRE_TYPE_VARINT;
+  bool first = true;
+  const auto mismatch = [&field, &wireType, &first](const Piece &piece)
+  {
+    if (first || (piece.m_field != field))
+    {
+      field = piece.m_field;
+      wireType = piece.m_wireType;
+      first = false;
+    }
+    else if (piece.m_wireType != wireType)
+    {
+      ETONYEK_DEBUG_MSG(("IWAMessage::IWAMessage: wire type %d of field %d does not match previously seen %d\n", piece.m_wireType, piece.m_field, wireType));
+      return true;
+    }
+    return false;
+  };
+  m_pieces.erase(std::remove_if(m_pieces.begin(), m_pieces.end(), mismatch), m_pieces.end());
+}
+
 const IWAUInt32Field &IWAMessage::uint32(const std::size_t field) const
 {
   return getField<IWAUInt32Field>(field, WIRE_TYPE_VARINT, IWAField::TAG_UINT32);
@@ -181,40 +283,55 @@ const IWAFloatField &IWAMessage::float_(const std::size_t field) const
   return getField<IWAFloatField>(field, WIRE_TYPE_32_BIT, IWAField::TAG_FLOAT);
 }
 
+std::size_t IWAMessage::memoryUsage() const
+{
+  std::size_t usage = detail::containerMemoryUsage(m_pieces) + detail::containerMemoryUsage(m_fields);
+  for (const auto &field : m_fields)
+    usage += field.m_realField->memoryUsage();
+  return usage;
+}
+
 template<typename FieldT>
 const FieldT &IWAMessage::getField(const std::size_t field, const WireType wireType, const IWAField::Tag tag) const
 {
-  const FieldList_t::iterator fieldIt = m_fields.find((unsigned) field);
+  const auto pieceIt = std::lower_bound(m_pieces.begin(), m_pieces.end(), unsigned(field),
+                                        [](const Piece &piece, const unsigned f)
+  {
+    return piece.m_field < f;
+  });
 
-  if (fieldIt == m_fields.end())
+  if ((pieceIt == m_pieces.end()) || (pieceIt->m_field != field))
   {
     static FieldT dummy;
     return dummy;
   }
 
-  if (fieldIt->second.m_wireType != wireType)
+  if (pieceIt->m_wireType != wireType)
   {
-    if (fieldIt->second.m_wireType != WIRE_TYPE_LENGTH_DELIMITED)
+    if (pieceIt->m_wireType != WIRE_TYPE_LENGTH_DELIMITED)
       throw AccessError();
   }
 
-  if (bool(fieldIt->second.m_realField))
+  for (const auto &realField : m_fields)
   {
-    if (fieldIt->second.m_realField->tag() != tag)
-      throw AccessError();
-  }
-  else
-  {
-    fieldIt->second.m_realField = std::make_shared<FieldT>();
-    for (std::deque<InputRange_t>::const_iterator it = fieldIt->second.m_pieces.begin(); it != fieldIt->second.m_pieces.end(); ++it)
+    if (realField.m_field == field)
     {
-      assert(bool(m_input));
-      m_input->seek(it->first, librevenge::RVNG_SEEK_SET);
-      fieldIt->second.m_realField->parse(m_input, static_cast<unsigned long>(it->second - m_input->tell()), wireType == WIRE_TYPE_LENGTH_DELIMITED);
+      if (realField.m_realField->tag() != tag)
+        throw AccessError();
+      return static_cast<FieldT &>(*realField.m_realField);
     }
   }
 
-  return static_cast<FieldT &>(*fieldIt->second.m_realField);
+  const std::shared_ptr<FieldT> realField = std::make_shared<FieldT>();
+  for (auto it = pieceIt; (it != m_pieces.end()) && (it->m_field == field); ++it)
+  {
+    assert(bool(m_input));
+    m_input->seek(it->m_start, librevenge::RVNG_SEEK_SET);
+    realField->parse(m_input, static_cast<unsigned long>(it->m_end - m_input->tell()), wireType == WIRE_TYPE_LENGTH_DELIMITED);
+  }
+  m_fields.push_back(Field(unsigned(field), realField));
+
+  return *realField;
 }
 
 }
@@ -10,8 +10,9 @@
 #ifndef IWAMESSAGE_H_INCLUDED
 #define IWAMESSAGE_H_INCLUDED
 
-#include <map>
-#include <utility>
+#include <memory>
+
+#include <boost/container/small_vector.hpp>
 
 #include "IWAField.h"
 
@@ -41,6 +42,12 @@ public:
   const IWAFixed32Field &fixed32(std::size_t field) const;
   const IWAFloatField &float_(std::size_t field) const;
 
+  /** Get an estimate of the memory used by the message, excluding the message itself.
+    *
+    * Fields are decoded lazily, so the result grows as they are accessed.
+    */
+  std::size_t memoryUsage() const;
+
 private:
   enum WireType
   {
@@ -50,30 +57,48 @@ private:
     WIRE_TYPE_32_BIT = 5
   };
 
-  typedef std::pair<long, long> InputRange_t;
+  /// A single occurrence of a field in the input.
+  struct Piece
+  {
+    Piece(unsigned field, WireType wireType, long start, long end);
+
+    unsigned m_field;
+    WireType m_wireType;
+    long m_start;
+    long m_end;
+  };
 
+  /// A field that has already been decoded.
   struct Field
   {
-    explicit Field(WireType wireType);
+    Field(unsigned field, const IWAFieldPtr_t &realField);
 
-    WireType m_wireType;
-    std::deque<InputRange_t> m_pieces;
+    unsigned m_field;
     IWAFieldPtr_t m_realField;
   };
 
-  typedef std::map<unsigned, Field> FieldList_t;
+  // Both lists are short for most messages, so avoid allocating them.
+  typedef boost::container::small_vector<Piece, 8> PieceList_t;
+  typedef boost::container::small_vector<Field, 4> FieldList_t;
 
 private:
   void parse(unsigned long length);
+  void parse(const unsigned char *data, const unsigned char *dataEnd, long startPos);
+  void parseStream(unsigned long length);
+  void addPiece(unsigned spec, long start, long end);
+  void sortPieces();
 
   template<typename FieldT>
   const FieldT &getField(std::size_t field, WireType wireType, IWAField::Tag tag) const;
 
 private:
   RVNGInputStreamPtr_t m_input;
+  PieceList_t m_pieces; // sorted by field
   mutable FieldList_t m_fields;
 };
 
+typedef std::shared_ptr<const IWAMessage> IWAMessagePtr_t;
+
 }
 
 #endif
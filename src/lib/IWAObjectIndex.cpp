@@ -9,7 +9,15 @@
 
 #include "IWAObjectIndex.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include "IWAMessage.h"
 #include "IWASnappyStream.h"
@@ -27,62 +35,207 @@ using std::make_pair;
 using std::make_shared;
 using std::string;
 
-IWAObjectIndex::ObjectRecord::ObjectRecord()
-  : m_stream()
-  , m_type(0)
-  , m_headerRange(0, 0)
-  , m_dataRange(0, 0)
+namespace
+{
+
+/// Limit of the total memory used by cached messages.
+const unsigned long MAX_MESSAGE_CACHE_SIZE = 4 * 1024 * 1024;
+
+/// Limit of the number of threads used to scan fragments.
+const unsigned MAX_SCAN_THREADS = 16;
+
+/** Get the slot of an object id in a table of 2^(32 - shift) slots.
+  *
+  * Fibonacci hashing: the multiplication mixes all bits of the id into
+  * the high bits of the product, so those must be used, not the low ones.
+  */
+std::size_t hashId(const unsigned id, const unsigned shift)
+{
+  return std::size_t(std::uint32_t(id * 2654435761u) >> shift);
+}
+
+}
+
+IWAObjectIndex::Fragment::Fragment(const unsigned id)
+  : m_id(id)
+  , m_path()
+  , m_scanned(false)
+  , m_stream()
 {
 }
 
-IWAObjectIndex::ObjectRecord::ObjectRecord(const RVNGInputStreamPtr_t &stream, const unsigned type,
-                                           const long pos, const unsigned long headerLen, const unsigned long dataLen)
-  : m_stream(stream)
+IWAObjectIndex::ScannedObject::ScannedObject(const unsigned id, const unsigned type, const long dataStart, const unsigned dataLength)
+  : m_id(id)
   , m_type(type)
-  , m_headerRange(pos, pos + long(headerLen))
-  , m_dataRange(m_headerRange.second, m_headerRange.second + long(dataLen))
+  , m_dataStart(dataStart)
+  , m_dataLength(dataLength)
+{
+}
+
+IWAObjectIndex::CachedMessage::CachedMessage(const IWAMessagePtr_t &message, const unsigned type, const unsigned long size, const RecentList_t::iterator recent)
+  : m_message(message)
+  , m_type(type)
+  , m_size(size)
+  , m_recent(recent)
+{
+}
+
+IWAObjectIndex::ObjectTable::ObjectTable()
+  : m_ids()
+  , m_fragments()
+  , m_types()
+  , m_dataStarts()
+  , m_dataLengths()
+  , m_slots()
+  , m_hashShift(32)
+{
+}
+
+std::size_t IWAObjectIndex::ObjectTable::find(const unsigned id) const
+{
+  if (m_slots.empty())
+    return size();
+  const std::size_t mask = m_slots.size() - 1;
+  for (std::size_t slot = hashId(id, m_hashShift); m_slots[slot] != 0; slot = (slot + 1) & mask)
+  {
+    if (m_ids[m_slots[slot] - 1] == id)
+      return m_slots[slot] - 1;
+  }
+  return size();
+}
+
+void IWAObjectIndex::ObjectTable::add(const unsigned id, const unsigned fragment)
+{
+  const std::size_t i = insert(id);
+  if (!isScanned(i))
+    m_fragments[i] = fragment;
+}
+
+void IWAObjectIndex::ObjectTable::set(const unsigned id, const unsigned fragment, const unsigned type,
+                                      const long dataStart, const unsigned dataLength)
+{
+  assert(dataStart >= 0);
+  const std::size_t i = insert(id);
+  m_fragments[i] = fragment;
+  m_types[i] = type;
+  m_dataStarts[i] = dataStart;
+  m_dataLengths[i] = dataLength;
+}
+
+bool IWAObjectIndex::ObjectTable::isScanned(const std::size_t i) const
+{
+  return m_dataStarts[i] >= 0;
+}
+
+std::size_t IWAObjectIndex::ObjectTable::size() const
 {
+  return m_ids.size();
+}
+
+std::size_t IWAObjectIndex::ObjectTable::memoryUsage() const
+{
+  return m_ids.capacity() * sizeof(unsigned) + m_fragments.capacity() * sizeof(unsigned)
+         + m_types.capacity() * sizeof(unsigned) + m_dataStarts.capacity() * sizeof(long)
+         + m_dataLengths.capacity() * sizeof(unsigned) + m_slots.capacity() * sizeof(unsigned);
+}
+
+std::size_t IWAObjectIndex::ObjectTable::insert(const unsigned id)
+{
+  const std::size_t found = find(id);
+  if (found != size())
+    return found;
+
+  // keep the load factor at most 1/2, so probe sequences stay short
+  if (2 * (size() + 1) > m_slots.size())
+    rehash((std::max)(std::size_t(64), 2 * m_slots.size()));
+
+  const std::size_t i = size();
+  m_ids.push_back(id);
+  m_fragments.push_back(0);
+  m_types.push_back(0);
+  m_dataStarts.push_back(-1);
+  m_dataLengths.push_back(0);
+
+  const std::size_t mask = m_slots.size() - 1;
+  std::size_t slot = hashId(id, m_hashShift);
+  while (m_slots[slot] != 0)
+    slot = (slot + 1) & mask;
+  m_slots[slot] = unsigned(i + 1);
+  return i;
+}
+
+void IWAObjectIndex::ObjectTable::rehash(const std::size_t slots)
+{
+  assert((slots & (slots - 1)) == 0);
+  m_slots.assign(slots, 0);
+  m_hashShift = 32;
+  for (std::size_t n = slots; n > 1; n >>= 1)
+    --m_hashShift;
+  const std::size_t mask = slots - 1;
+  for (std::size_t i = 0; i < size(); ++i)
+  {
+    std::size_t slot = hashId(m_ids[i], m_hashShift);
+    while (m_slots[slot] != 0)
+      slot = (slot + 1) & mask;
+    m_slots[slot] = unsigned(i + 1);
+  }
 }
 
 IWAObjectIndex::IWAObjectIndex(const RVNGInputStreamPtr_t &fragments, const RVNGInputStreamPtr_t &package)
   : m_fragments(fragments)
   , m_package(package)
-  , m_unparsedFragments()
-  , m_fragmentObjectMap()
+  , m_fragmentList()
+  , m_fragmentMap()
+  , m_objects()
+  , m_messageCache()
+  , m_recentMessages()
+  , m_messageCacheSize(0)
+  , m_messageCacheHits(0)
+  , m_messageCacheMisses(0)
   , m_fileMap()
   , m_fileColorMap()
 {
 }
 
-void IWAObjectIndex::parse()
+IWAObjectIndex::~IWAObjectIndex()
+{
+  ETONYEK_DEBUG_MSG(("IWAObjectIndex: %lu objects, %lu bytes of index (%.1f bytes per object)\n",
+                     (unsigned long) m_objects.size(), (unsigned long) m_objects.memoryUsage(),
+                     m_objects.size() == 0 ? 0.0 : double(m_objects.memoryUsage()) / double(m_objects.size())));
+  ETONYEK_DEBUG_MSG(("IWAObjectIndex: message cache: %lu hits, %lu misses\n", m_messageCacheHits, m_messageCacheMisses));
+}
+
+void IWAObjectIndex::parse(const bool scanAll)
 {
-  m_unparsedFragments[2] = "Index/Metadata.iwa";
-  m_fragmentObjectMap[2] = make_pair(2, ObjectRecord());
-  scanFragment(2);
-  const auto indexIt = m_fragmentObjectMap.find(2);
-  if (indexIt == m_fragmentObjectMap.end() || !indexIt->second.second.m_stream)
+  const unsigned metadata = getFragment(2);
+  m_fragmentList[metadata].m_path = "Index/Metadata.iwa";
+  m_objects.add(2, metadata);
+  scanFragment(metadata);
+  const std::size_t index = m_objects.find(2);
+  if (index == m_objects.size() || !m_objects.isScanned(index))
   {
     // TODO: scan all fragment files
     ETONYEK_DEBUG_MSG(("IWAObjectIndex::parse: object index is broken, nothing will be parsed\n"));
   }
   else
   {
-    const ObjectRecord &rec = indexIt->second.second;
-    const IWAMessage objectIndex(rec.m_stream, rec.m_dataRange.first, rec.m_dataRange.second);
+    const IWAMessage objectIndex(getMessage(index));
     const deque<IWAMessage> &fragments = objectIndex.message(3).repeated();
     for (const auto &fragment : fragments)
     {
       if (fragment.uint32(1) && (fragment.string(2) || fragment.string(3)))
       {
         const unsigned pathIdx = fragment.string(3) ? 3 : 2;
-        m_unparsedFragments[fragment.uint32(1).get()] = "Index/" + fragment.string(pathIdx).get() + ".iwa";
-        m_fragmentObjectMap[fragment.uint32(1).get()] = make_pair(fragment.uint32(1).get(), ObjectRecord());
+        const unsigned fragmentIdx = getFragment(fragment.uint32(1).get());
+        if (!m_fragmentList[fragmentIdx].m_scanned)
+          m_fragmentList[fragmentIdx].m_path = "Index/" + fragment.string(pathIdx).get() + ".iwa";
+        m_objects.add(fragment.uint32(1).get(), fragmentIdx);
       }
       const deque<IWAMessage> &refs = fragment.message(6).repeated();
       for (const auto &ref : refs)
       {
         if (ref.uint32(1) && ref.uint32(2))
-          m_fragmentObjectMap[ref.uint32(2).get()] = make_pair(ref.uint32(1).get(), ObjectRecord());
+          m_objects.add(ref.uint32(2).get(), getFragment(ref.uint32(1).get()));
       }
     }
     const deque<IWAMessage> &files = objectIndex.message(4).repeated();
@@ -118,35 +271,74 @@ void IWAObjectIndex::parse()
     else if (replaceId)
       scanColorFileMap(get(replaceId));
   }
+
+  if (scanAll)
+    scanAllFragments((std::max)(1u, (std::min)(std::thread::hardware_concurrency(), MAX_SCAN_THREADS)));
 }
 
-void IWAObjectIndex::queryObject(const unsigned id, unsigned &type, boost::optional<IWAMessage> &msg) const
+void IWAObjectIndex::queryObject(const unsigned id, unsigned &type, IWAMessagePtr_t &msg) const
 {
-  const auto recIt = m_fragmentObjectMap.find(id);
-  if (recIt == m_fragmentObjectMap.end())
+  const auto cacheIt = m_messageCache.find(id);
+  if (cacheIt != m_messageCache.end())
+  {
+    ++m_messageCacheHits;
+    CachedMessage &cached = cacheIt->second;
+    m_recentMessages.splice(m_recentMessages.begin(), m_recentMessages, cached.m_recent);
+    msg = cached.m_message;
+    type = cached.m_type;
+    // fields decoded by the previous user of the message are kept in it, so recount it
+    const unsigned long size = messageSize(*msg);
+    m_messageCacheSize = m_messageCacheSize - cached.m_size + size;
+    cached.m_size = size;
+    trimMessageCache(0);
+    return;
+  }
+
+  const std::size_t i = m_objects.find(id);
+  if (i == m_objects.size())
   {
     ETONYEK_DEBUG_MSG(("IWAObjectIndex::queryObject: object %u not found\n", id));
     return;
   }
-  if (!recIt->second.second.m_stream)
-    const_cast<IWAObjectIndex *>(this)->scanFragment(recIt->second.first);
-  if (recIt->second.second.m_stream)
+  // NOTE: scanning only updates existing records in place, so i stays valid
+  if (!m_objects.isScanned(i))
+    const_cast<IWAObjectIndex *>(this)->scanFragment(m_objects.m_fragments[i]);
+  if (m_objects.isScanned(i))
   {
-    const ObjectRecord &objRecord = recIt->second.second;
-    msg = IWAMessage(objRecord.m_stream, objRecord.m_dataRange.first, objRecord.m_dataRange.second);
-    type = objRecord.m_type;
+    ++m_messageCacheMisses;
+    msg = std::make_shared<IWAMessage>(getMessage(i));
+    type = m_objects.m_types[i];
+    cacheMessage(id, type, msg);
   }
 }
 
 boost::optional<unsigned> IWAObjectIndex::getObjectType(const unsigned id) const
 {
-  // improve me
-  boost::optional<IWAMessage> msg;
-  unsigned type=0; // for g++-7
-  queryObject(id, type, msg);
-  if (!msg)
+  // the type is known as soon as the fragment is scanned, so there is no need to parse the object
+  const std::size_t i = m_objects.find(id);
+  if (i == m_objects.size())
     return boost::none;
-  return type;
+  if (!m_objects.isScanned(i))
+    const_cast<IWAObjectIndex *>(this)->scanFragment(m_objects.m_fragments[i]);
+  if (!m_objects.isScanned(i))
+    return boost::none;
+  return m_objects.m_types[i];
+}
+
+void IWAObjectIndex::getObjectTypes(const std::deque<unsigned> &ids, std::deque<unsigned> &types) const
+{
+  std::vector<std::size_t> objects;
+  objects.reserve(ids.size());
+  for (const auto id : ids)
+  {
+    const std::size_t i = m_objects.find(id);
+    if (i != m_objects.size() && !m_objects.isScanned(i))
+      const_cast<IWAObjectIndex *>(this)->scanFragment(m_objects.m_fragments[i]);
+    objects.push_back(i);
+  }
+  types.clear();
+  for (const auto i : objects)
+    types.push_back((i != m_objects.size() && m_objects.isScanned(i)) ? m_objects.m_types[i] : 0);
 }
 
 const RVNGInputStreamPtr_t IWAObjectIndex::queryFile(const unsigned id) const
@@ -168,27 +360,84 @@ const RVNGInputStreamPtr_t IWAObjectIndex::queryFile(const unsigned id) const
   return it->second.second;
 }
 
-void IWAObjectIndex::scanFragment(const unsigned id)
+unsigned IWAObjectIndex::getFragment(const unsigned id)
 {
+  const auto it = m_fragmentMap.find(id);
+  if (it != m_fragmentMap.end())
+    return it->second;
+  const unsigned fragment = unsigned(m_fragmentList.size());
+  m_fragmentList.push_back(Fragment(id));
+  m_fragmentMap[id] = fragment;
+  return fragment;
+}
+
+IWAMessage IWAObjectIndex::getMessage(const std::size_t object) const
+{
+  assert(m_objects.isScanned(object));
+  const long start = m_objects.m_dataStarts[object];
+  return IWAMessage(m_fragmentList[m_objects.m_fragments[object]].m_stream, start, start + long(m_objects.m_dataLengths[object]));
+}
+
+unsigned long IWAObjectIndex::messageSize(const IWAMessage &message)
+{
+  return (unsigned long)(sizeof(IWAMessage) + message.memoryUsage());
+}
+
+void IWAObjectIndex::cacheMessage(const unsigned id, const unsigned type, const IWAMessagePtr_t &message) const
+{
+  const unsigned long size = messageSize(*message);
+  if (size > MAX_MESSAGE_CACHE_SIZE)
+    return;
+
+  trimMessageCache(size);
+  m_recentMessages.push_front(id);
+  m_messageCache.insert(std::make_pair(id, CachedMessage(message, type, size, m_recentMessages.begin())));
+  m_messageCacheSize += size;
+}
+
+void IWAObjectIndex::trimMessageCache(const unsigned long space) const
+{
+  while (!m_recentMessages.empty() && (m_messageCacheSize + space > MAX_MESSAGE_CACHE_SIZE))
+  {
+    const auto it = m_messageCache.find(m_recentMessages.back());
+    assert(it != m_messageCache.end());
+    m_messageCacheSize -= it->second.m_size;
+    m_messageCache.erase(it);
+    m_recentMessages.pop_back();
+  }
+}
+
+void IWAObjectIndex::scanFragment(const unsigned fragment)
+{
+  Fragment &record = m_fragmentList[fragment];
+  if (record.m_scanned)
+    return;
+  record.m_scanned = true;
+  if (record.m_path.empty())
+    return;
+
   // scan the fragment file
-  const auto fragmentIt = m_unparsedFragments.find(id);
-  if (fragmentIt != m_unparsedFragments.end())
+  const RVNGInputStreamPtr_t stream(m_fragments->getSubStreamByName(record.m_path.c_str()));
+  if (stream)
   {
-    const RVNGInputStreamPtr_t stream(m_fragments->getSubStreamByName(fragmentIt->second.c_str()));
-    if (stream)
-    {
-      const auto fragment = make_shared<IWASnappyStream>(stream);
-      scanFragment(fragmentIt->first, fragment);
-    }
-    else
-    {
-      ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanFragment: file %s does not exist\n", fragmentIt->second.c_str()));
-    }
-    m_unparsedFragments.erase(fragmentIt);
+    record.m_stream = make_shared<IWASnappyStream>(stream);
+    ObjectList_t objects;
+    scanObjects(record.m_stream, objects);
+    addObjects(fragment, objects);
   }
+  else
+  {
+    ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanFragment: file %s does not exist\n", record.m_path.c_str()));
+  }
+}
+
+void IWAObjectIndex::addObjects(const unsigned fragment, const ObjectList_t &objects)
+{
+  for (const auto &object : objects)
+    m_objects.set(object.m_id, fragment, object.m_type, object.m_dataStart, object.m_dataLength);
 }
 
-void IWAObjectIndex::scanFragment(const unsigned id, const RVNGInputStreamPtr_t &stream)
+void IWAObjectIndex::scanObjects(const RVNGInputStreamPtr_t &stream, ObjectList_t &objects)
 try
 {
   while (!stream->isEnd())
@@ -210,12 +459,9 @@ try
       dataLen += info.uint64(3).get();
       if (!type) type=info.uint32(1).optional(); // normally, all data must define the same type
     }
-    if (!ok) break;
+    if (!ok || dataLen > std::numeric_limits<unsigned>::max()) break;
     if (header.uint32(1))
-    {
-      const ObjectRecord rec(stream, get_optional_value_or(type, 0), start, (unsigned long)(headerLen), (unsigned long)(dataLen));
-      m_fragmentObjectMap[header.uint32(1).get()] = make_pair(id, rec);
-    }
+      objects.push_back(ScannedObject(header.uint32(1).get(), get_optional_value_or(type, 0), start + long(headerLen), unsigned(dataLen)));
     if (stream->seek(start + long(headerLen) + long(dataLen), librevenge::RVNG_SEEK_SET) != 0)
       break;
   }
@@ -225,6 +471,81 @@ catch (...)
   // just read as much as possible
 }
 
+void IWAObjectIndex::scanAllFragments(const unsigned threads)
+{
+  struct Job
+  {
+    Job(const unsigned fragment, const RVNGInputStreamPtr_t &stream)
+      : m_fragment(fragment)
+      , m_stream(stream)
+      , m_objects()
+    {
+    }
+
+    unsigned m_fragment;
+    RVNGInputStreamPtr_t m_stream;
+    ObjectList_t m_objects;
+  };
+
+  // The package is not thread-safe, so open the fragments here...
+  std::vector<Job> fragments;
+  for (unsigned i = 0; i < m_fragmentList.size(); ++i)
+  {
+    Fragment &record = m_fragmentList[i];
+    if (record.m_scanned)
+      continue;
+    record.m_scanned = true;
+    if (record.m_path.empty())
+      continue;
+    const RVNGInputStreamPtr_t stream(m_fragments->getSubStreamByName(record.m_path.c_str()));
+    if (stream)
+      fragments.push_back(Job(i, stream));
+    else
+    {
+      ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanAllFragments: file %s does not exist\n", record.m_path.c_str()));
+    }
+  }
+
+  // ... but uncompress and scan them in parallel, as they are independent.
+  std::atomic<std::size_t> next(0);
+  const auto worker = [&fragments, &next]()
+  {
+    for (std::size_t i = next++; i < fragments.size(); i = next++)
+    {
+      try
+      {
+        fragments[i].m_stream = std::make_shared<IWASnappyStream>(fragments[i].m_stream);
+        scanObjects(fragments[i].m_stream, fragments[i].m_objects);
+      }
+      catch (...)
+      {
+        fragments[i].m_stream.reset();
+        ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanAllFragments: can not read fragment %u\n", fragments[i].m_fragment));
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  try
+  {
+    for (unsigned i = 1; i < (std::min)(std::size_t(threads), fragments.size()); ++i)
+      pool.push_back(std::thread(worker));
+  }
+  catch (const std::system_error &)
+  {
+    // just use the threads we have got
+  }
+  worker();
+  for (auto &thread : pool)
+    thread.join();
+
+  for (const auto &fragment : fragments)
+  {
+    m_fragmentList[fragment.m_fragment].m_stream = fragment.m_stream;
+    addObjects(fragment.m_fragment, fragment.m_objects);
+  }
+}
+
 boost::optional<IWORKColor> IWAObjectIndex::queryFileColor(unsigned id) const
 {
   auto it=m_fileColorMap.find(id);
@@ -239,15 +560,14 @@ boost::optional<IWORKColor> IWAObjectIndex::queryFileColor(unsigned id) const
 void IWAObjectIndex::scanColorFileMap(unsigned id)
 try
 {
-  const auto indexIt = m_fragmentObjectMap.find(id);
-  if (indexIt == m_fragmentObjectMap.end() || !indexIt->second.second.m_stream)
+  const std::size_t i = m_objects.find(id);
+  if (i == m_objects.size() || !m_objects.isScanned(i))
   {
     // TODO: scan all fragment files
     ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanColorFileMap: can not find object %d\n", int(id)));
     return;
   }
-  const ObjectRecord &rec = indexIt->second.second;
-  const IWAMessage objectIndex(rec.m_stream, rec.m_dataRange.first, rec.m_dataRange.second);
+  const IWAMessage objectIndex(getMessage(i));
   for (auto const &corr : objectIndex.message(1).repeated())
   {
     auto ref=IWAParser::readRef(corr, 2);
@@ -267,15 +587,14 @@ catch (...)
 boost::optional<IWORKColor> IWAObjectIndex::scanColorFileCorrespondance(unsigned id)
 try
 {
-  const auto indexIt = m_fragmentObjectMap.find(id);
-  if (indexIt == m_fragmentObjectMap.end() || !indexIt->second.second.m_stream)
+  const std::size_t i = m_objects.find(id);
+  if (i == m_objects.size() || !m_objects.isScanned(i))
   {
     // TODO: scan all fragment files
     ETONYEK_DEBUG_MSG(("IWAObjectIndex::scanColorFileCorrespondance: can not find object %d\n", int(id)));
     return boost::none;
   }
-  const ObjectRecord &rec = indexIt->second.second;
-  const IWAMessage objectIndex(rec.m_stream, rec.m_dataRange.first, rec.m_dataRange.second);
+  const IWAMessage objectIndex(getMessage(i));
   return IWAParser::readColor(objectIndex, 1);
 }
 catch (...)
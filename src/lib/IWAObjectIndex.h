@@ -10,46 +10,154 @@
 #ifndef IWAOBJECTINDEX_H_INCLUDED
 #define IWAOBJECTINDEX_H_INCLUDED
 
+#include <cstddef>
+#include <deque>
+#include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include "IWAMessage.h"
 #include "libetonyek_utils.h"
 
 namespace libetonyek
 {
 
-class IWAMessage;
-
 class IWAObjectIndex
 {
 public:
-  struct ObjectRecord
+  IWAObjectIndex(const RVNGInputStreamPtr_t &fragments, const RVNGInputStreamPtr_t &package);
+  ~IWAObjectIndex();
+
+  /** Read the object index.
+    *
+    * By default, a fragment is only uncompressed and scanned when an
+    * object in it is first queried.
+    *
+    * @arg[in] scanAll scan all the fragments now, in parallel on the
+    *   available cores, instead of on demand
+    */
+  void parse(bool scanAll = false);
+
+  /** Get an object.
+    *
+    * The messages of recently queried objects are cached, so an object
+    * that is referenced repeatedly is only parsed once.
+    *
+    * @arg[in] id the object id.
+    * @arg[out] type the type of the object.
+    * @arg[out] msg the message of the object, or an empty pointer if
+    *   the object does not exist.
+    */
+  void queryObject(const unsigned id, unsigned &type, IWAMessagePtr_t &msg) const;
+  boost::optional<unsigned> getObjectType(const unsigned id) const;
+  /** Get the types of several objects at once.
+    *
+    * @arg[in] ids the object ids.
+    * @arg[out] types the types of the objects, in the same order, or 0
+    *   for an unknown object.
+    */
+  void getObjectTypes(const std::deque<unsigned> &ids, std::deque<unsigned> &types) const;
+  const RVNGInputStreamPtr_t queryFile(unsigned id) const;
+  boost::optional<IWORKColor> queryFileColor(unsigned id) const;
+
+private:
+  struct Fragment
   {
-    ObjectRecord();
-    ObjectRecord(const RVNGInputStreamPtr_t &stream, unsigned type, long pos, unsigned long headerLen, unsigned long dataLen);
+    explicit Fragment(unsigned id);
 
+    unsigned m_id;
+    std::string m_path;
+    bool m_scanned;
     RVNGInputStreamPtr_t m_stream;
+  };
+
+  struct ScannedObject
+  {
+    ScannedObject(unsigned id, unsigned type, long dataStart, unsigned dataLength);
+
+    unsigned m_id;
     unsigned m_type;
-    std::pair<long, long> m_headerRange;
-    std::pair<long, long> m_dataRange;
+    long m_dataStart;
+    unsigned m_dataLength;
   };
 
-public:
-  IWAObjectIndex(const RVNGInputStreamPtr_t &fragments, const RVNGInputStreamPtr_t &package);
+  typedef std::vector<ScannedObject> ObjectList_t;
 
-  void parse();
+  typedef std::list<unsigned> RecentList_t;
 
-  void queryObject(const unsigned id, unsigned &type, boost::optional<IWAMessage> &msg) const;
-  boost::optional<unsigned> getObjectType(const unsigned id) const;
-  const RVNGInputStreamPtr_t queryFile(unsigned id) const;
-  boost::optional<IWORKColor> queryFileColor(unsigned id) const;
+  struct CachedMessage
+  {
+    CachedMessage(const IWAMessagePtr_t &message, unsigned type, unsigned long size, RecentList_t::iterator recent);
+
+    IWAMessagePtr_t m_message;
+    unsigned m_type;
+    unsigned long m_size;
+    RecentList_t::iterator m_recent;
+  };
+
+  typedef std::unordered_map<unsigned, CachedMessage> MessageCache_t;
+
+  /** Compact table of all known objects.
+    *
+    * The object records are stored as parallel arrays and looked up
+    * through an open-addressing hash of their ids. An object whose
+    * fragment has not been scanned yet has a negative data start.
+    */
+  struct ObjectTable
+  {
+    ObjectTable();
+
+    /** Find the position of an object.
+      *
+      * @arg[in] id the object id.
+      * @returns the position of the object or @c size() if it is unknown.
+      */
+    std::size_t find(unsigned id) const;
+
+    /** Register an object whose fragment has not been scanned yet.
+      *
+      * Does nothing if the object is already known.
+      */
+    void add(unsigned id, unsigned fragment);
+
+    /// Register a scanned object, replacing any previous record.
+    void set(unsigned id, unsigned fragment, unsigned type, long dataStart, unsigned dataLength);
+
+    bool isScanned(std::size_t i) const;
+    std::size_t size() const;
+    std::size_t memoryUsage() const;
+
+    std::vector<unsigned> m_ids;
+    std::vector<unsigned> m_fragments;
+    std::vector<unsigned> m_types;
+    std::vector<long> m_dataStarts;
+    std::vector<unsigned> m_dataLengths;
+
+  private:
+    std::size_t insert(unsigned id);
+    void rehash(std::size_t slots);
+
+    std::vector<unsigned> m_slots; // object position + 1, or 0 for an empty slot
+    unsigned m_hashShift; // 32 - log2 of the number of slots
+  };
 
 private:
-  void scanFragment(unsigned id);
-  void scanFragment(unsigned id, const RVNGInputStreamPtr_t &stream);
+  unsigned getFragment(unsigned id);
+  IWAMessage getMessage(std::size_t object) const;
+  void cacheMessage(unsigned id, unsigned type, const IWAMessagePtr_t &message) const;
+  /// Drop the least recently used messages until there is @c space left in the cache.
+  void trimMessageCache(unsigned long space) const;
+  static unsigned long messageSize(const IWAMessage &message);
+
+  void scanFragment(unsigned fragment);
+  void addObjects(unsigned fragment, const ObjectList_t &objects);
+  static void scanObjects(const RVNGInputStreamPtr_t &stream, ObjectList_t &objects);
+  void scanAllFragments(unsigned threads);
 
   void scanColorFileMap(unsigned id);
   boost::optional<IWORKColor> scanColorFileCorrespondance(unsigned id);
@@ -57,8 +165,14 @@ private:
   const RVNGInputStreamPtr_t m_fragments;
   const RVNGInputStreamPtr_t m_package;
 
-  mutable std::map<unsigned, std::string> m_unparsedFragments;
-  mutable std::map<unsigned, std::pair<unsigned, ObjectRecord>> m_fragmentObjectMap;
+  mutable std::vector<Fragment> m_fragmentList;
+  mutable std::map<unsigned, unsigned> m_fragmentMap;
+  mutable ObjectTable m_objects;
+  mutable MessageCache_t m_messageCache;
+  mutable RecentList_t m_recentMessages;
+  mutable unsigned long m_messageCacheSize;
+  mutable unsigned long m_messageCacheHits;
+  mutable unsigned long m_messageCacheMisses;
   mutable std::map<unsigned, std::pair<std::string, RVNGInputStreamPtr_t>> m_fileMap;
   mutable std::map<unsigned, IWORKColor> m_fileColorMap;
 };
@@ -52,6 +52,10 @@ using std::string;
 
 namespace
 {
+
+/// The default limit of nesting of objects.
+const unsigned DEFAULT_MAX_NESTING_DEPTH = 1000;
+
 bool samePoint(const optional<IWORKPosition> &point1, const optional<IWORKPosition> &point2)
 {
   if (point1 && point2)
@@ -152,7 +156,11 @@ IWAParser::IWAParser(const RVNGInputStreamPtr_t &fragments, const RVNGInputStrea
   , m_currentText()
   , m_collector(collector)
   , m_index(fragments, package)
+  , m_scanAllFragments(false)
   , m_visited()
+  , m_visitedSet()
+  , m_maxDepth(DEFAULT_MAX_NESTING_DEPTH)
+  , m_flattenStyles(false)
   , m_charStyles()
   , m_paraStyles()
   , m_sectionStyles()
@@ -172,16 +180,44 @@ bool IWAParser::parse()
   return parseDocument();
 }
 
+void IWAParser::setScanAllFragments(const bool scanAll)
+{
+  m_scanAllFragments = scanAll;
+}
+
+void IWAParser::setMaxNestingDepth(const unsigned depth)
+{
+  m_maxDepth = depth;
+}
+
+void IWAParser::setFlattenStyles(const bool flatten)
+{
+  m_flattenStyles = flatten;
+}
+
 IWAParser::ObjectMessage::ObjectMessage(IWAParser &parser, const unsigned id, const unsigned type)
   : m_parser(parser)
   , m_message()
   , m_id(id)
   , m_type(0)
 {
-  std::deque<unsigned>::const_iterator it = find(m_parser.m_visited.begin(), m_parser.m_visited.end(), m_id);
-  if (it == m_parser.m_visited.end())
+  if (m_parser.m_visited.size() >= m_parser.m_maxDepth)
   {
-    optional<IWAMessage> msg;
+    ETONYEK_DEBUG_MSG(("IWAParser::ObjectMessage::ObjectMessage: object %u is nested too deep\n", id));
+  }
+  else if (m_parser.m_visitedSet.find(m_id) == m_parser.m_visitedSet.end())
+  {
+    if (type != 0)
+    {
+      // check the type first, so we do not parse an object we would throw away
+      const optional<unsigned> &actualType = m_parser.getObjectType(m_id);
+      if (actualType && *actualType != type)
+      {
+        ETONYEK_DEBUG_MSG(("IWAParser::ObjectMessage::ObjectMessage: type mismatch for object %u: expected %u, got %u\n", id, type, *actualType));
+        return;
+      }
+    }
+    IWAMessagePtr_t msg;
     m_parser.queryObject(m_id, m_type, msg);
     if (msg)
     {
@@ -189,6 +225,7 @@ IWAParser::ObjectMessage::ObjectMessage(IWAParser &parser, const unsigned id, co
       {
         m_message = msg;
         m_parser.m_visited.push_back(m_id);
+        m_parser.m_visitedSet.insert(m_id);
       }
       else
       {
@@ -209,6 +246,7 @@ IWAParser::ObjectMessage::~ObjectMessage()
     assert(!m_parser.m_visited.empty());
     assert(m_parser.m_visited.back() == m_id);
     m_parser.m_visited.pop_back();
+    m_parser.m_visitedSet.erase(m_id);
   }
 }
 
@@ -219,7 +257,7 @@ IWAParser::ObjectMessage::operator bool() const
 
 const IWAMessage &IWAParser::ObjectMessage::get() const
 {
-  return m_message.get();
+  return *m_message;
 }
 
 unsigned IWAParser::ObjectMessage::getType() const
@@ -227,7 +265,7 @@ unsigned IWAParser::ObjectMessage::getType() const
   return m_type;
 }
 
-void IWAParser::queryObject(const unsigned id, unsigned &type, boost::optional<IWAMessage> &msg) const
+void IWAParser::queryObject(const unsigned id, unsigned &type, IWAMessagePtr_t &msg) const
 {
   m_index.queryObject(id, type, msg);
 }
@@ -237,6 +275,13 @@ boost::optional<unsigned> IWAParser::getObjectType(const unsigned id) const
   return m_index.getObjectType(id);
 }
 
+std::deque<unsigned> IWAParser::getObjectTypes(const std::deque<unsigned> &ids) const
+{
+  deque<unsigned> types;
+  m_index.getObjectTypes(ids, types);
+  return types;
+}
+
 const RVNGInputStreamPtr_t IWAParser::queryFile(const unsigned id) const
 {
   return m_index.queryFile(id);
@@ -541,39 +586,72 @@ void IWAParser::readPadding(const IWAMessage &msg, IWORKPadding &padding)
 
 bool IWAParser::dispatchShape(const unsigned id)
 {
-  const ObjectMessage msg(*this, id);
+  const optional<unsigned> &type = getObjectType(id);
+  if (!type)
+  {
+    ETONYEK_DEBUG_MSG(("IWAParser::dispatchShape: object %u not found\n", id));
+    return false;
+  }
+  return dispatchShapeWithType(id, get(type));
+}
+
+bool IWAParser::dispatchShapeWithType(const unsigned id, const unsigned type)
+{
+  const ShapeParser_t parser = getShapeParser(type);
+  if (!parser)
+  {
+    // do not bother parsing an object that would be ignored
+    ETONYEK_DEBUG_MSG(("IWAParser::dispatchShapeWithType: ignore object %u of type %u\n", id, type));
+    return false;
+  }
+  const ObjectMessage msg(*this, id, type);
   if (!msg)
     return false;
-  return dispatchShapeWithMessage(get(msg), msg.getType());
+  return (this->*parser)(get(msg));
+}
+
+void IWAParser::dispatchShapes(const std::deque<unsigned> &ids)
+{
+  const deque<unsigned> &types = getObjectTypes(ids);
+  for (std::size_t i = 0; i < ids.size(); ++i)
+    dispatchShapeWithType(ids[i], types[i]);
 }
 
 bool IWAParser::dispatchShapeWithMessage(const IWAMessage &msg, unsigned type)
+{
+  const ShapeParser_t parser = getShapeParser(type);
+  if (parser)
+    return (this->*parser)(msg);
+
+  static bool first=true;
+  if (first)
+  {
+    first=false;
+    ETONYEK_DEBUG_MSG(("IWAParser::dispatchShape: find some unknown shapes, type=%d\n", int(type)));
+  }
+  return false;
+}
+
+IWAParser::ShapeParser_t IWAParser::getShapeParser(const unsigned type)
 {
   switch (type)
   {
   case IWAObjectType::ConnectionLine :
+    return &IWAParser::parseConnectionLine;
   case IWAObjectType::DrawableShape :
-    return parseDrawableShape(msg, type==IWAObjectType::ConnectionLine);
+    return &IWAParser::parseDrawableShape;
   case IWAObjectType::Group :
-    return parseGroup(msg);
+    return &IWAParser::parseGroup;
   case IWAObjectType::Image :
-    return parseImage(msg);
+    return &IWAParser::parseImage;
   case IWAObjectType::StickyNote:
-    return parseStickyNote(msg);
+    return &IWAParser::parseStickyNote;
   case IWAObjectType::TabularInfo :
-    return parseTabularInfo(msg);
+    return &IWAParser::parseTabularInfo;
   default:
-  {
-    static bool first=true;
-    if (first)
-    {
-      first=false;
-      ETONYEK_DEBUG_MSG(("IWAParser::dispatchShape: find some unknown shapes, type=%d\n", int(type)));
-    }
-  }
+    break;
   }
-
-  return false;
+  return nullptr;
 }
 
 void IWAParser::updateGeometryUsingTextRef(unsigned id, IWORKGeometry &geometry, unsigned flags)
@@ -941,6 +1019,9 @@ const IWORKStylePtr_t IWAParser::queryStyle(const unsigned id, StyleMap_t &style
   {
     IWORKStylePtr_t style;
     parseStyle(id, style);
+    // the parent styles are complete at this point, as they are parsed first
+    if (style && m_flattenStyles)
+      style->flatten();
     it = styleMap.insert(make_pair(id, style)).first;
   }
   assert(it != styleMap.end());
@@ -1066,8 +1147,8 @@ bool IWAParser::parseAttachment(const unsigned id)
     }
   }
   }
-  auto cId=collector->getOutputManager().save();
-  auto content = collector->getOutputManager().get(cId);
+  // take the content instead of saving it, so it is freed with the text
+  const IWORKOutputElements content(std::move(collector->getOutputManager().getCurrent()));
   collector->getOutputManager().pop();
   collector->endAttachment();
   collector->endAttachments();
@@ -1213,6 +1294,16 @@ bool IWAParser::parseStickyNote(const IWAMessage &/*msg*/)
   return false;
 }
 
+bool IWAParser::parseDrawableShape(const IWAMessage &msg)
+{
+  return parseDrawableShape(msg, false);
+}
+
+bool IWAParser::parseConnectionLine(const IWAMessage &msg)
+{
+  return parseDrawableShape(msg, true);
+}
+
 bool IWAParser::parseDrawableShape(const IWAMessage &msg, bool isConnectionLine)
 {
   m_collector.startLevel();
@@ -1493,8 +1584,7 @@ bool IWAParser::parseGroup(const IWAMessage &msg)
   {
     m_collector.startGroup();
     m_collector.openGroup();
-    const deque<unsigned> &shapeRefs = readRefs(msg, 2);
-    std::for_each(shapeRefs.begin(), shapeRefs.end(), bind(&IWAParser::dispatchShape, this, _1));
+    dispatchShapes(readRefs(msg, 2));
     m_collector.closeGroup();
     m_collector.endGroup();
   }
@@ -1561,7 +1651,7 @@ void IWAParser::parseMask(unsigned id, IWORKGeometryPtr_t &geometry, IWORKPathPt
 
 void IWAParser::parseObjectIndex()
 {
-  m_index.parse();
+  m_index.parse(m_scanAllFragments);
 }
 
 void IWAParser::parseCharacterStyle(const unsigned id, IWORKStylePtr_t &style)
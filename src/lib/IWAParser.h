@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
@@ -61,6 +62,35 @@ public:
 
   bool parse();
 
+  /** Scan all the fragments in parallel before parsing the document.
+    *
+    * This is off by default: fragments are scanned on demand, on the
+    * calling thread.
+    *
+    * @arg[in] scanAll scan all the fragments at once
+    */
+  void setScanAllFragments(bool scanAll);
+
+  /** Set the limit of nesting of objects.
+    *
+    * An object nested deeper is not parsed, which protects the parser
+    * from running out of stack on broken or malicious documents. The
+    * default is 1000.
+    *
+    * @arg[in] depth the maximal number of objects parsed at once
+    */
+  void setMaxNestingDepth(unsigned depth);
+
+  /** Flatten each style once it is parsed.
+    *
+    * This is off by default, as it copies inherited properties into
+    * every style that has a parent.
+    *
+    * @arg[in] flatten flatten the styles
+    * @see IWORKStyle::flatten
+    */
+  void setFlattenStyles(bool flatten);
+
 protected:
   class ObjectMessage
   {
@@ -80,7 +110,7 @@ protected:
 
   private:
     IWAParser &m_parser;
-    boost::optional<IWAMessage> m_message;
+    IWAMessagePtr_t m_message;
     const unsigned m_id;
     unsigned m_type;
   };
@@ -105,7 +135,9 @@ protected:
   static void readPadding(const IWAMessage &msg, IWORKPadding &padding);
 
   bool dispatchShape(unsigned id);
+  bool dispatchShapeWithType(unsigned id, unsigned type);
   bool dispatchShapeWithMessage(const IWAMessage &msg, unsigned type);
+  void dispatchShapes(const std::deque<unsigned> &ids);
   bool parseText(unsigned id, bool createNoteAsFootnote=true, const std::function<void(unsigned, IWORKStylePtr_t)> &openPageSpan=nullptr);
   void parseComment(unsigned id);
   void parseAuthorInComment(unsigned id);
@@ -127,6 +159,7 @@ protected:
 
   const IWORKStylePtr_t queryStyle(unsigned id, StyleMap_t &styleMap, StyleParseFun_t parse) const;
   boost::optional<unsigned> getObjectType(unsigned id) const;
+  std::deque<unsigned> getObjectTypes(const std::deque<unsigned> &ids) const;
 
 protected:
   IWORKLanguageManager m_langManager;
@@ -184,7 +217,7 @@ private:
   virtual bool parseDocument() = 0;
 
 private:
-  void queryObject(unsigned id, unsigned &type, boost::optional<IWAMessage> &msg) const;
+  void queryObject(unsigned id, unsigned &type, IWAMessagePtr_t &msg) const;
   const RVNGInputStreamPtr_t queryFile(unsigned id) const;
 
   void parseObjectIndex();
@@ -211,7 +244,9 @@ private:
   void parseLink(unsigned id, std::string &url);
 
   bool parseAttachment(unsigned id);
-  bool parseDrawableShape(const IWAMessage &msg, bool isConnectionLine=false);
+  bool parseDrawableShape(const IWAMessage &msg);
+  bool parseDrawableShape(const IWAMessage &msg, bool isConnectionLine);
+  bool parseConnectionLine(const IWAMessage &msg);
   bool parseGroup(const IWAMessage &msg);
   bool parseShapePlacement(const IWAMessage &msg);
   bool parseImage(const IWAMessage &msg);
@@ -225,12 +260,21 @@ private:
   void parseCharacterProperties(const IWAMessage &msg, IWORKPropertyMap &props);
   void parseColumnsProperties(const IWAMessage &msg, IWORKPropertyMap &props);
 
+  typedef bool (IWAParser::*ShapeParser_t)(const IWAMessage &msg);
+
+  /// Get the parser of objects of a type, or nullptr if they are not shapes.
+  static ShapeParser_t getShapeParser(unsigned type);
+
 private:
   IWORKCollector &m_collector;
 
   IWAObjectIndex m_index;
+  bool m_scanAllFragments;
 
-  std::deque<unsigned> m_visited;
+  std::deque<unsigned> m_visited; // the stack of objects being parsed
+  std::unordered_set<unsigned> m_visitedSet; // the same objects, for fast lookup
+  unsigned m_maxDepth;
+  bool m_flattenStyles;
 
   mutable StyleMap_t m_charStyles;
   mutable StyleMap_t m_paraStyles;
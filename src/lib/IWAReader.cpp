@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "IWAMessage.h"
+#include "IWASnappyStream.h"
 #include "IWORKMemoryStream.h"
 
 namespace libetonyek
@@ -23,6 +24,20 @@ namespace
 
 struct ParseError {};
 
+void checkLength(const unsigned char *const p, const unsigned char *const end, const long length)
+{
+  if (end - p < length)
+    throw EndOfStreamException();
+}
+
+uint64_t readFixed(const unsigned char *const p, const unsigned length)
+{
+  uint64_t value = 0;
+  for (unsigned i = length; i != 0; --i)
+    value = (value << 8) | p[i - 1];
+  return value;
+}
+
 }
 
 namespace IWAReader
@@ -33,36 +48,80 @@ uint32_t UInt32::read(const RVNGInputStreamPtr_t &input, unsigned long)
   return uint32_t(readUVar(input));
 }
 
+uint32_t UInt32::read(const unsigned char *&p, const unsigned char *const end)
+{
+  return uint32_t(readUVar(p, end));
+}
+
 uint64_t UInt64::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return readUVar(input);
 }
 
+uint64_t UInt64::read(const unsigned char *&p, const unsigned char *const end)
+{
+  return readUVar(p, end);
+}
+
 int64_t SInt64::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return readSVar(input);
 }
 
+int64_t SInt64::read(const unsigned char *&p, const unsigned char *const end)
+{
+  return readSVar(p, end);
+}
+
 int32_t SInt32::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return int32_t(readSVar(input));
 }
 
+int32_t SInt32::read(const unsigned char *&p, const unsigned char *const end)
+{
+  return int32_t(readSVar(p, end));
+}
+
 bool Bool::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return bool(readUVar(input));
 }
 
+bool Bool::read(const unsigned char *&p, const unsigned char *const end)
+{
+  return bool(readUVar(p, end));
+}
+
 uint64_t Fixed64::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return readU64(input);
 }
 
+uint64_t Fixed64::read(const unsigned char *&p, const unsigned char *const end)
+{
+  checkLength(p, end, 8);
+  const uint64_t value = readFixed(p, 8);
+  p += 8;
+  return value;
+}
+
 double Double::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return readDouble(input);
 }
 
+double Double::read(const unsigned char *&p, const unsigned char *const end)
+{
+  union
+  {
+    uint64_t u;
+    double d;
+  } convert;
+  convert.u = Fixed64::read(p, end);
+  return convert.d;
+}
+
 std::string String::read(const RVNGInputStreamPtr_t &input, const unsigned long length)
 {
   assert(length != 0);
@@ -74,10 +133,32 @@ std::string String::read(const RVNGInputStreamPtr_t &input, const unsigned long
   return std::string(reinterpret_cast<const char *>(bytes), std::size_t(length));
 }
 
+std::string String::read(const unsigned char *&p, const unsigned char *const end)
+{
+  assert(p != end);
+
+  const std::string value(reinterpret_cast<const char *>(p), std::size_t(end - p));
+  p = end;
+  return value;
+}
+
 const RVNGInputStreamPtr_t Bytes::read(const RVNGInputStreamPtr_t &input, const unsigned long length)
 {
   assert(length != 0);
 
+  // share the data with the input, if possible
+  RVNGInputStreamPtr_t view;
+  if (const auto memoryInput = dynamic_cast<const IWORKMemoryStream *>(input.get()))
+    view = memoryInput->view(input->tell(), length);
+  else if (const auto snappyInput = dynamic_cast<IWASnappyStream *>(input.get()))
+    view = snappyInput->view(input->tell(), length);
+  if (bool(view))
+  {
+    if (input->seek(long(length), librevenge::RVNG_SEEK_CUR) != 0)
+      throw ParseError();
+    return view;
+  }
+
   unsigned long readBytes(0);
   const unsigned char *const bytes = input->read(length, readBytes);
   if (readBytes < length)
@@ -97,11 +178,30 @@ uint32_t Fixed32::read(const RVNGInputStreamPtr_t &input, unsigned long)
   return readU32(input);
 }
 
+uint32_t Fixed32::read(const unsigned char *&p, const unsigned char *const end)
+{
+  checkLength(p, end, 4);
+  const auto value = uint32_t(readFixed(p, 4));
+  p += 4;
+  return value;
+}
+
 float Float::read(const RVNGInputStreamPtr_t &input, unsigned long)
 {
   return readFloat(input);
 }
 
+float Float::read(const unsigned char *&p, const unsigned char *const end)
+{
+  union
+  {
+    uint32_t u;
+    float f;
+  } convert;
+  convert.u = Fixed32::read(p, end);
+  return convert.f;
+}
+
 }
 
 }
@@ -25,41 +25,49 @@ namespace IWAReader
 struct UInt32
 {
   static uint32_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static uint32_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct UInt64
 {
   static uint64_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static uint64_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct SInt32
 {
   static int32_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static int32_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct SInt64
 {
   static int64_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static int64_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct Bool
 {
   static bool read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static bool read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct Fixed64
 {
   static uint64_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static uint64_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct Double
 {
   static double read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static double read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct String
 {
   static std::string read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static std::string read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct Bytes
@@ -75,11 +83,13 @@ struct Message
 struct Fixed32
 {
   static uint32_t read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static uint32_t read(const unsigned char *&p, const unsigned char *end);
 };
 
 struct Float
 {
   static float read(const RVNGInputStreamPtr_t &input, unsigned long length);
+  static float read(const unsigned char *&p, const unsigned char *end);
 };
 
 }
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -30,144 +31,219 @@ struct CompressionException
 {
 };
 
-struct Data
-{
-  explicit Data(vector<unsigned char> &data);
+/// Extra space at the end of the output buffer, so wide copies do not need to care about the end.
+const unsigned long OUTPUT_SLACK = 32;
 
-  vector<unsigned char> &m_data; //! Uncompressed data.
-  size_t m_blockStart; //! A position in m_data where data from the current block start.
-};
+/// The maximal ratio of uncompressed to compressed size: a 3 byte far ref can produce 64 bytes.
+const unsigned long MAX_EXPANSION = 22;
+
+void copy8(unsigned char *const dest, const unsigned char *const src)
+{
+  // This is well-defined even if the ranges overlap: the bytes are
+  // loaded before they are stored.
+  uint64_t tmp;
+  std::memcpy(&tmp, src, sizeof(tmp));
+  std::memcpy(dest, &tmp, sizeof(tmp));
+}
 
-Data::Data(vector<unsigned char> &data)
-  : m_data(data)
-  , m_blockStart(m_data.size())
+void copy16(unsigned char *const dest, const unsigned char *const src)
 {
+  copy8(dest, src);
+  copy8(dest + 8, src + 8);
 }
 
-void appendRef(Data &data, const unsigned offset, const unsigned length)
+/** Append a copy of already uncompressed data.
+  *
+  * The copy can overlap with its source: that is how runs are
+  * encoded. The caller must make sure there are at least
+  * OUTPUT_SLACK bytes available after dest + length.
+  */
+void appendRef(unsigned char *dest, const unsigned char *const blockStart, const unsigned long offset, const unsigned long length)
 {
   if (offset == 0)
     throw CompressionException();
-  if (offset > data.m_data.size() - data.m_blockStart) // we don't have enough uncompressed data in the current block
+  if (offset > static_cast<unsigned long>(dest - blockStart)) // we don't have enough uncompressed data in the current block
     throw CompressionException();
 
-  data.m_data.resize(data.m_data.size() + length);
-  const vector<unsigned char>::iterator end = data.m_data.end();
-  auto dest = data.m_data.end() - vector<unsigned char>::difference_type(length);
-  auto src = dest - vector<unsigned char>::difference_type(offset);
+  const unsigned char *src = dest - offset;
+  unsigned char *const end = dest + length;
 
-  if (offset >= length)
+  // Widen the pattern until it spans at least 8 bytes. Every step
+  // doubles the distance between the source and the destination.
+  while (dest - src < 8)
   {
-    std::copy(src, src + vector<unsigned char>::difference_type(length), dest);
+    copy8(dest, src);
+    dest += dest - src;
   }
-  else // the run is inserted repeatedly
+  while (dest < end)
   {
-    while (size_t(end - dest) >= offset) // as long as the whole run fits
-    {
-      std::copy(src, src + vector<unsigned char>::difference_type(offset), dest);
-      dest += vector<unsigned char>::difference_type(offset);
-    }
-    if (dest != end) // copy the remainder
-      std::copy(src, src + (end - dest), dest);
+    copy8(dest, src);
+    src += 8;
+    dest += 8;
   }
 }
 
 bool uncompressBlock(const RVNGInputStreamPtr_t &input, const unsigned long length, vector<unsigned char> &uncompressed)
 {
-  Data data(uncompressed);
+  assert(uncompressed.empty());
+
+  unsigned long numBytesRead = 0;
+  const unsigned char *ip = input->read(length, numBytesRead);
+  if (!ip || (numBytesRead == 0))
+    throw EndOfStreamException();
+  const unsigned char *const ipEnd = ip + numBytesRead;
 
-  const long blockEnd = input->tell() + long(length);
-  const auto uncompressedLength = (unsigned long) readUVar(input);
-  const size_t maxSize = size_t((std::min)(2 * length, uncompressedLength)); // don't want unbounded allocation
-  size_t newSize = data.m_data.size() + maxSize;
-  data.m_data.reserve(newSize);
+  const auto uncompressedLength = (unsigned long) readUVar(ip, ipEnd);
+  // don't want unbounded allocation
+  const unsigned long maxSize = (std::min)(MAX_EXPANSION * numBytesRead, uncompressedLength);
+  uncompressed.resize(maxSize + OUTPUT_SLACK);
 
-  while (!input->isEnd() && (input->tell() < blockEnd))
+  unsigned char *const opStart = uncompressed.data();
+  unsigned char *const opEnd = opStart + maxSize;
+  unsigned char *op = opStart;
+
+  bool ok = true;
+  while (ok && (ip != ipEnd))
   {
-    const unsigned char c = readU8(input);
+    const unsigned char c = *ip++;
     switch (c & 0x3)
     {
     case 0 : // a run of literals
     {
-      unsigned runLength = 0;
+      unsigned long runLength = 0;
       if ((c & 0xf0) == 0xf0)
       {
         const unsigned count = ((c >> 2) & 0x3) + 1;
         assert(count > 0);
         assert(count <= 4);
-        runLength = unsigned(readU8(input)) + 1;
-        for (unsigned shift = 8; shift < 8 * count; shift += 8)
+        if (static_cast<unsigned long>(ipEnd - ip) < count)
         {
-          const unsigned b = readU8(input);
-          runLength += b << shift;
+          ok = false;
+          break;
         }
+        for (unsigned i = 0; i < count; ++i)
+          runLength |= static_cast<unsigned long>(ip[i]) << (8 * i);
+        runLength += 1;
+        ip += count;
       }
       else
       {
         runLength = (c >> 2) + 1;
       }
       assert(runLength > 0);
-      unsigned long bytesRead = 0;
-      const unsigned char *const bytes = input->read(runLength, bytesRead);
-      if (bytesRead != runLength)
-        return false;
-      data.m_data.insert(data.m_data.end(), bytes, bytes + runLength);
+      if ((static_cast<unsigned long>(ipEnd - ip) < runLength) || (static_cast<unsigned long>(opEnd - op) < runLength))
+      {
+        ok = false;
+        break;
+      }
+      if ((runLength <= 16) && (ipEnd - ip >= 16))
+        copy16(op, ip); // short runs are the most common; copy a bit more than necessary
+      else
+        std::memcpy(op, ip, runLength);
+      ip += runLength;
+      op += runLength;
       break;
     }
     case 1 : // near ref
     {
-      const unsigned runLength = ((c >> 2) & 0x7) + 4;
-      const unsigned high = c >> 5;
-      const unsigned low = readU8(input);
-      const unsigned offset = (high << 8) | low;
-      appendRef(data, offset, runLength);
+      if (ip == ipEnd)
+      {
+        ok = false;
+        break;
+      }
+      const unsigned long runLength = ((c >> 2) & 0x7) + 4;
+      const unsigned long offset = (static_cast<unsigned long>(c >> 5) << 8) | *ip++;
+      if (static_cast<unsigned long>(opEnd - op) < runLength)
+      {
+        ok = false;
+        break;
+      }
+      appendRef(op, opStart, offset, runLength);
+      op += runLength;
       break;
     }
     case 2 : // far ref
     {
-      const unsigned runLength = (c >> 2) + 1;
-      const unsigned low = readU8(input);
-      const unsigned high = readU8(input);
-      const unsigned offset = (high << 8) | low;
-      appendRef(data, offset, runLength);
+      if (ipEnd - ip < 2)
+      {
+        ok = false;
+        break;
+      }
+      const unsigned long runLength = (c >> 2) + 1;
+      const unsigned long offset = ip[0] | (static_cast<unsigned long>(ip[1]) << 8);
+      ip += 2;
+      if (static_cast<unsigned long>(opEnd - op) < runLength)
+      {
+        ok = false;
+        break;
+      }
+      appendRef(op, opStart, offset, runLength);
+      op += runLength;
       break;
     }
     case 3 : // unknown
       ETONYEK_DEBUG_MSG(("uncompressBlock: Found an unexpected mark value 3\n"));
-      return false;
+      ok = false;
+      break;
     default :
       assert(0);
     }
   }
 
-  return true;
+  uncompressed.resize(std::size_t(op - opStart));
+  return ok;
 }
 
-RVNGInputStreamPtr_t uncompress(const RVNGInputStreamPtr_t &input)
-{
-  vector<unsigned char> data;
-
-  while (!input->isEnd())
-  {
-    readU8(input);
-    const unsigned long blockLength = readU16(input);
-    readU8(input);
-    if (!uncompressBlock(input, (std::min)(blockLength, getRemainingLength(input)), data))
-      throw CompressionException();
-  }
+/// Maximal size of uncompressed blocks kept in memory by a stream.
+const unsigned long MAX_CACHE_SIZE = 16 * 1024 * 1024;
 
-  return std::make_shared<IWORKMemoryStream>(data);
 }
 
+IWASnappyStream::Block::Block(const long offset, const unsigned long length, const unsigned long start, const unsigned long size)
+  : m_offset(offset)
+  , m_length(length)
+  , m_start(start)
+  , m_size(size)
+{
 }
 
 IWASnappyStream::IWASnappyStream(const RVNGInputStreamPtr_t &stream)
-  : m_stream()
+  : m_input(stream)
+  , m_blocks()
+  , m_length(0)
+  , m_pos(0)
+  , m_cache()
+  , m_recent()
+  , m_cacheSize(0)
+  , m_buffer()
 {
-  if (0 != stream->seek(0, librevenge::RVNG_SEEK_SET))
+  if (0 != m_input->seek(0, librevenge::RVNG_SEEK_SET))
     throw EndOfStreamException();
 
-  m_stream = uncompress(stream);
+  // build the block index
+  while (!m_input->isEnd())
+  {
+    readU8(m_input);
+    const unsigned long blockLength = readU16(m_input);
+    readU8(m_input);
+    const long offset = m_input->tell();
+    const unsigned long length = (std::min)(blockLength, getRemainingLength(m_input));
+    const auto size = (unsigned long) readUVar(m_input);
+    if (size > std::numeric_limits<unsigned long>::max() - m_length)
+      throw CompressionException();
+    if (size > 0)
+    {
+      m_blocks.push_back(Block(offset, length, m_length, size));
+      m_length += size;
+    }
+    if (0 != m_input->seek(offset + long(length), librevenge::RVNG_SEEK_SET))
+      throw CompressionException();
+  }
+
+  if (m_length == 0)
+    throw GenericException();
+
+  m_cache.resize(m_blocks.size());
 }
 
 IWASnappyStream::~IWASnappyStream()
@@ -178,7 +254,27 @@ RVNGInputStreamPtr_t IWASnappyStream::uncompressBlock(const RVNGInputStreamPtr_t
 {
   vector<unsigned char> data;
   libetonyek::uncompressBlock(block, getLength(block), data);
-  return std::make_shared<IWORKMemoryStream>(data);
+  return std::make_shared<IWORKMemoryStream>(std::move(data));
+}
+
+RVNGInputStreamPtr_t IWASnappyStream::view(const long offset, const unsigned long length)
+{
+  if ((offset < 0) || (static_cast<unsigned long>(offset) >= m_length) || (length == 0) || (length > m_length - static_cast<unsigned long>(offset)))
+    return RVNGInputStreamPtr_t();
+
+  const std::size_t index = findBlock(static_cast<unsigned long>(offset));
+  const Block &block = m_blocks[index];
+  if (static_cast<unsigned long>(offset) + length <= block.m_start + block.m_size)
+    return getBlock(index)->view(long(static_cast<unsigned long>(offset) - block.m_start), length);
+
+  const long origPos = m_pos;
+  m_pos = offset;
+  unsigned long numBytesRead = 0;
+  const unsigned char *const data = read(length, numBytesRead);
+  m_pos = origPos;
+  if (!data || (numBytesRead != length))
+    return RVNGInputStreamPtr_t();
+  return std::make_shared<IWORKMemoryStream>(data, unsigned(length));
 }
 
 bool IWASnappyStream::isStructured()
@@ -211,24 +307,146 @@ librevenge::RVNGInputStream *IWASnappyStream::getSubStreamById(unsigned)
   return nullptr;
 }
 
-const unsigned char *IWASnappyStream::read(const unsigned long numBytes, unsigned long &numBytesRead)
+const unsigned char *IWASnappyStream::read(unsigned long numBytes, unsigned long &numBytesRead) try
 {
-  return m_stream->read(numBytes, numBytesRead);
+  numBytesRead = 0;
+
+  if ((0 == numBytes) || isEnd())
+    return nullptr;
+
+  const auto pos = static_cast<unsigned long>(m_pos);
+  if (numBytes > m_length - pos)
+    numBytes = m_length - pos;
+
+  std::size_t index = findBlock(pos);
+  const unsigned long blockEnd = m_blocks[index].m_start + m_blocks[index].m_size;
+
+  const unsigned char *data = nullptr;
+  if (pos + numBytes <= blockEnd)
+  {
+    // the usual case: everything is in one block
+    const std::shared_ptr<IWORKMemoryStream> &block = getBlock(index);
+    block->seek(long(pos - m_blocks[index].m_start), librevenge::RVNG_SEEK_SET);
+    unsigned long blockBytesRead = 0;
+    data = block->read(numBytes, blockBytesRead);
+    if (blockBytesRead != numBytes)
+      return nullptr;
+  }
+  else
+  {
+    m_buffer.clear();
+    m_buffer.reserve(numBytes);
+    for (unsigned long current = pos; current < pos + numBytes; ++index)
+    {
+      assert(index < m_blocks.size());
+      const Block &blockInfo = m_blocks[index];
+      const unsigned long toRead = (std::min)(pos + numBytes, blockInfo.m_start + blockInfo.m_size) - current;
+      const std::shared_ptr<IWORKMemoryStream> &block = getBlock(index);
+      block->seek(long(current - blockInfo.m_start), librevenge::RVNG_SEEK_SET);
+      unsigned long blockBytesRead = 0;
+      const unsigned char *const blockData = block->read(toRead, blockBytesRead);
+      if (blockBytesRead != toRead)
+        return nullptr;
+      m_buffer.insert(m_buffer.end(), blockData, blockData + toRead);
+      current += toRead;
+    }
+    data = m_buffer.data();
+  }
+
+  m_pos += long(numBytes);
+  numBytesRead = numBytes;
+  return data;
+}
+catch (...)
+{
+  return nullptr;
 }
 
-int IWASnappyStream::seek(long offset, const librevenge::RVNG_SEEK_TYPE seekType)
+int IWASnappyStream::seek(const long offset, const librevenge::RVNG_SEEK_TYPE seekType)
 {
-  return m_stream->seek(offset, seekType);
+  long pos = 0;
+  switch (seekType)
+  {
+  case librevenge::RVNG_SEEK_SET :
+    pos = offset;
+    break;
+  case librevenge::RVNG_SEEK_CUR :
+    pos = offset + m_pos;
+    break;
+  case librevenge::RVNG_SEEK_END :
+    pos = offset + long(m_length);
+    break;
+  default :
+    return -1;
+  }
+
+  if ((pos < 0) || (static_cast<unsigned long>(pos) > m_length))
+    return 1;
+
+  m_pos = pos;
+  return 0;
 }
 
 long IWASnappyStream::tell()
 {
-  return m_stream->tell();
+  return m_pos;
 }
 
 bool IWASnappyStream::isEnd()
 {
-  return m_stream->isEnd();
+  return static_cast<unsigned long>(m_pos) == m_length;
+}
+
+std::size_t IWASnappyStream::findBlock(const unsigned long pos) const
+{
+  assert(pos < m_length);
+
+  const auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), pos,
+                                   [](const unsigned long p, const Block &block)
+  {
+    return p < block.m_start;
+  });
+  assert(it != m_blocks.begin());
+  return std::size_t(it - m_blocks.begin()) - 1;
+}
+
+const std::shared_ptr<IWORKMemoryStream> &IWASnappyStream::getBlock(const std::size_t index)
+{
+  assert(index < m_blocks.size());
+
+  if (bool(m_cache[index]))
+  {
+    const auto it = std::find(m_recent.begin(), m_recent.end(), index);
+    assert(it != m_recent.end());
+    if (it != m_recent.begin())
+    {
+      m_recent.erase(it);
+      m_recent.push_front(index);
+    }
+    return m_cache[index];
+  }
+
+  const Block &block = m_blocks[index];
+  if (0 != m_input->seek(block.m_offset, librevenge::RVNG_SEEK_SET))
+    throw EndOfStreamException();
+  vector<unsigned char> data;
+  if (!libetonyek::uncompressBlock(m_input, block.m_length, data) || (data.size() != block.m_size))
+    throw CompressionException();
+
+  // make room for the new block
+  while (!m_recent.empty() && (m_cacheSize + block.m_size > MAX_CACHE_SIZE))
+  {
+    const std::size_t evicted = m_recent.back();
+    m_recent.pop_back();
+    m_cacheSize -= m_blocks[evicted].m_size;
+    m_cache[evicted].reset();
+  }
+
+  m_cache[index] = std::make_shared<IWORKMemoryStream>(std::move(data));
+  m_recent.push_front(index);
+  m_cacheSize += block.m_size;
+
+  return m_cache[index];
 }
 
 }
@@ -10,6 +10,10 @@
 #ifndef IWASNAPPYSTREAM_H_INCLUDED
 #define IWASNAPPYSTREAM_H_INCLUDED
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include <librevenge-stream/librevenge-stream.h>
 
 #include "libetonyek_utils.h"
@@ -17,8 +21,26 @@
 namespace libetonyek
 {
 
+class IWORKMemoryStream;
+
+/** A stream of uncompressed data of an IWA fragment.
+  *
+  * Only the framing of the compressed blocks is read when the stream
+  * is created. The blocks are uncompressed on demand, when their data
+  * are read, and a limited number of recently used blocks is kept.
+  */
 class IWASnappyStream : public librevenge::RVNGInputStream
 {
+  struct Block
+  {
+    Block(long offset, unsigned long length, unsigned long start, unsigned long size);
+
+    long m_offset; //! Start of the compressed data in the input.
+    unsigned long m_length; //! Length of the compressed data.
+    unsigned long m_start; //! Start of the uncompressed data in the stream.
+    unsigned long m_size; //! Length of the uncompressed data.
+  };
+
 public:
   explicit IWASnappyStream(const RVNGInputStreamPtr_t &stream);
   ~IWASnappyStream() override;
@@ -26,6 +48,15 @@ public:
   // for unit tests
   static RVNGInputStreamPtr_t uncompressBlock(const RVNGInputStreamPtr_t &block);
 
+  /** Create a stream over a part of this stream's data.
+    *
+    * If the range lies in a single block, the data are shared with
+    * the block, otherwise they are copied.
+    *
+    * @see IWORKMemoryStream::view
+    */
+  RVNGInputStreamPtr_t view(long offset, unsigned long length);
+
   bool isStructured() override;
   unsigned subStreamCount() override;
   const char *subStreamName(unsigned id) override;
@@ -40,7 +71,20 @@ public:
   bool isEnd() override;
 
 private:
-  RVNGInputStreamPtr_t m_stream;
+  std::size_t findBlock(unsigned long pos) const;
+  const std::shared_ptr<IWORKMemoryStream> &getBlock(std::size_t index);
+
+private:
+  const RVNGInputStreamPtr_t m_input;
+  std::vector<Block> m_blocks;
+  unsigned long m_length;
+  long m_pos;
+
+  std::vector<std::shared_ptr<IWORKMemoryStream>> m_cache;
+  std::deque<std::size_t> m_recent;
+  unsigned long m_cacheSize;
+
+  std::vector<unsigned char> m_buffer; //! Data of reads spanning several blocks.
 };
 
 }
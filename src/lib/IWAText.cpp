@@ -9,7 +9,11 @@
 
 #include "IWAText.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "IWORKLanguageManager.h"
 #include "IWORKProperties.h"
@@ -23,10 +27,61 @@ using boost::none;
 using std::make_shared;
 using std::map;
 using std::string;
+using std::vector;
 
 namespace
 {
 
+/** Get the length of an UTF-8 encoded character from its first byte.
+  *
+  * This matches what librevenge::RVNGString::Iter does, including for
+  * invalid input.
+  */
+unsigned getCharLength(const char first)
+{
+  const unsigned char c = (unsigned char) first;
+  if (c < 0xc0)
+    return 1;
+  if (c < 0xe0)
+    return 2;
+  if (c < 0xf0)
+    return 3;
+  if (c < 0xf8)
+    return 4;
+  if (c < 0xfc)
+    return 5;
+  if (c < 0xfe)
+    return 6;
+  return 1;
+}
+
+/** Check if a word of text can be copied as it is.
+  *
+  * That is the case if it contains only ASCII characters, no control
+  * characters and no two spaces in a row.
+  */
+bool isPlain(const uint64_t word)
+{
+  const uint64_t ones = 0x0101010101010101ull;
+  const uint64_t high = ones * 0x80;
+  if (word & high)
+    return false;
+  // there is no carry into the next byte, as all bytes are < 0x80
+  if (((word + ones * 0x60) & high) != high)
+    return false;
+  // mark bytes that are spaces
+  const uint64_t t = word ^ (ones * 0x20);
+  const uint64_t spaces = ~(((t & ~high) + ~high) | t | ~high);
+  return (spaces & (spaces << 8)) == 0;
+}
+
+template<typename Map>
+void addPositions(const Map &attrs, vector<unsigned> &positions)
+{
+  for (const auto &attr : attrs)
+    positions.push_back(attr.first);
+}
+
 void flushText(string &text, IWORKText &collector)
 {
   if (!text.empty())
@@ -116,164 +171,211 @@ void IWAText::parse(IWORKText &collector, const std::function<void(unsigned, IWO
   bool isLink = false;
   string curText;
 
-  std::size_t pos = 0;
-  librevenge::RVNGString::Iter iter(m_text);
-  iter.rewind();
-  for (; iter.next(); ++pos)
+  // merge the positions of all attribute changes
+  vector<unsigned> changes;
+  addPositions(m_pageMasters, changes);
+  addPositions(m_sections, changes);
+  addPositions(m_paras, changes);
+  addPositions(m_spans, changes);
+  addPositions(m_langs, changes);
+  addPositions(m_links, changes);
+  addPositions(m_lists, changes);
+  addPositions(m_listLevels, changes);
+  addPositions(m_attachments, changes);
+  std::sort(changes.begin(), changes.end());
+  changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+  auto changeIt = changes.begin();
+
+  const char *const text = m_text.cstr();
+  const std::size_t size = m_text.size();
+  std::size_t offset = 0; // in bytes
+  std::size_t pos = 0; // in characters
+  while (offset < size)
   {
-    // first the page master change
-    if ((pageMasterIt != m_pageMasters.end()) && (pageMasterIt->first == pos))
-    {
-      if (openPageSpan) openPageSpan(unsigned(pos), pageMasterIt->second);
-      ++pageMasterIt;
-    }
-    // first handle section change
-    if ((sectionIt != m_sections.end()) && (sectionIt->first == pos))
+    bool ignoreCharacter=false;
+    if ((changeIt != changes.end()) && (*changeIt == pos))
     {
-      collector.flushLayout();
-      collector.setLayoutStyle(sectionIt->second);
-      ++sectionIt;
-    }
+      // first the page master change
+      if ((pageMasterIt != m_pageMasters.end()) && (pageMasterIt->first == pos))
+      {
+        if (openPageSpan) openPageSpan(unsigned(pos), pageMasterIt->second);
+        ++pageMasterIt;
+      }
+      // first handle section change
+      if ((sectionIt != m_sections.end()) && (sectionIt->first == pos))
+      {
+        collector.flushLayout();
+        collector.setLayoutStyle(sectionIt->second);
+        ++sectionIt;
+      }
 
-    // handle span style change
-    IWORKStylePtr_t spanStyle;
-    IWORKStylePtr_t langStyle;
-    bool spanChanged = false;
-    bool langChanged = false;
-    if ((spanIt != m_spans.end()) && (spanIt->first == pos))
-    {
-      spanStyle = spanIt->second;
-      spanChanged = true;
-      ++spanIt;
-    }
-    if ((langIt != m_langs.end()) && (langIt->first == pos))
-    {
-      IWORKPropertyMap props;
-      if (!langIt->second.empty())
+      // handle span style change
+      IWORKStylePtr_t spanStyle;
+      IWORKStylePtr_t langStyle;
+      bool spanChanged = false;
+      bool langChanged = false;
+      if ((spanIt != m_spans.end()) && (spanIt->first == pos))
       {
-        const string &tag = m_langManager.addTag(langIt->second);
-        if (tag.empty())
-          props.clear<property::Language>();
-        else
-          props.put<property::Language>(tag);
+        spanStyle = spanIt->second;
+        spanChanged = true;
+        ++spanIt;
       }
-      else
+      if ((langIt != m_langs.end()) && (langIt->first == pos))
       {
-        props.clear<property::Language>();
+        IWORKPropertyMap props;
+        if (!langIt->second.empty())
+        {
+          const string &tag = m_langManager.addTag(langIt->second);
+          if (tag.empty())
+            props.clear<property::Language>();
+          else
+            props.put<property::Language>(tag);
+        }
+        else
+        {
+          props.clear<property::Language>();
+        }
+        langStyle = make_shared<IWORKStyle>(props, none, none);
+        langChanged = true;
+        ++langIt;
       }
-      langStyle = make_shared<IWORKStyle>(props, none, none);
-      langChanged = true;
-      ++langIt;
-    }
-    if (spanChanged || langChanged)
-    {
-      flushText(curText, collector);
-      if (pos != 0)
-        collector.flushSpan();
-      if (spanChanged)
-        collector.setSpanStyle(spanStyle);
-      if (langChanged)
-        collector.setLanguage(langStyle);
-    }
-    // handle start/end of a link
-    if ((linkIt != m_links.end()) && (linkIt->first == pos))
-    {
-      flushText(curText, collector);
-      if (isLink)
+      if (spanChanged || langChanged)
       {
-        collector.closeLink();
-        isLink = false;
+        flushText(curText, collector);
+        if (pos != 0)
+          collector.flushSpan();
+        if (spanChanged)
+          collector.setSpanStyle(spanStyle);
+        if (langChanged)
+          collector.setLanguage(langStyle);
       }
-      if (!linkIt->second.empty())
+      // handle start/end of a link
+      if ((linkIt != m_links.end()) && (linkIt->first == pos))
       {
-        collector.openLink(linkIt->second);
-        isLink = true;
+        flushText(curText, collector);
+        if (isLink)
+        {
+          collector.closeLink();
+          isLink = false;
+        }
+        if (!linkIt->second.empty())
+        {
+          collector.openLink(linkIt->second);
+          isLink = true;
+        }
+        ++linkIt;
       }
-      ++linkIt;
-    }
 
-    // handle paragraph style change
-    if ((paraIt != m_paras.end()) && (paraIt->first == pos))
-    {
-      collector.setParagraphStyle(paraIt->second);
-      ++paraIt;
-    }
+      // handle paragraph style change
+      if ((paraIt != m_paras.end()) && (paraIt->first == pos))
+      {
+        collector.setParagraphStyle(paraIt->second);
+        ++paraIt;
+      }
 
-    // handle list style change
-    if ((listIt != m_lists.end()) && (listIt->first == pos))
-    {
-      currentListStyle = listIt->second;
-      collector.setListStyle(currentListStyle);
-      ++listIt;
-    }
+      // handle list style change
+      if ((listIt != m_lists.end()) && (listIt->first == pos))
+      {
+        currentListStyle = listIt->second;
+        collector.setListStyle(currentListStyle);
+        ++listIt;
+      }
 
-    // handle list level change
-    if ((listLevelIt != m_listLevels.end()) && (listLevelIt->first == pos))
-    {
-      collector.setListLevel(listLevelIt->second + 1);
-      ++listLevelIt;
-    }
+      // handle list level change
+      if ((listLevelIt != m_listLevels.end()) && (listLevelIt->first == pos))
+      {
+        collector.setListLevel(listLevelIt->second + 1);
+        ++listLevelIt;
+      }
 
-    bool ignoreCharacter=false;
-    while (attachmentIt != m_attachments.end() && attachmentIt->first == pos)
-    {
-      flushText(curText, collector);
-      attachmentIt->second(unsigned(pos), ignoreCharacter);
-      ++attachmentIt;
+      while (attachmentIt != m_attachments.end() && attachmentIt->first == pos)
+      {
+        flushText(curText, collector);
+        attachmentIt->second(unsigned(pos), ignoreCharacter);
+        ++attachmentIt;
+      }
+      ++changeIt;
     }
     if (ignoreCharacter)
-      continue;
-    // handle text
-    const char *const u8Char = iter();
-    switch (u8Char[0])
-    {
-    case char(4): // new section(ok)
-    case char(14): // footnote: normally already ignored
-      break;
-    case char(5):
     {
-      flushText(curText, collector);
-      collector.flushParagraph();
-      collector.insertPageBreak();
-      break;
+      offset += getCharLength(text[offset]);
+      ++pos;
+      continue;
     }
-    case char(12): // column break
-      if (m_sections.empty()) break;
-      flushText(curText, collector);
-      collector.flushParagraph();
-      collector.insertColumnBreak();
-      break;
-    case '\t' :
-      flushText(curText, collector);
-      collector.insertTab();
-      break;
-    case '\r' :
-      flushText(curText, collector);
-      collector.insertLineBreak();
-      break;
-    case '\n' :
-      flushText(curText, collector);
-      collector.flushParagraph();
-      break;
-    case ' ' :
-      if (wasSpace)
+
+    // handle text up to the next change
+    const std::size_t end = (changeIt != changes.end()) ? *changeIt : size;
+    std::size_t start = offset;
+    while ((offset < size) && (pos < end))
+    {
+      // skip plain text quickly
+      while ((offset + sizeof(uint64_t) <= size) && (pos + sizeof(uint64_t) <= end) && !(wasSpace && (text[offset] == ' ')))
       {
-        flushText(curText, collector);
-        collector.insertSpace();
+        uint64_t word;
+        std::memcpy(&word, text + offset, sizeof(word));
+        if (!isPlain(word))
+          break;
+        offset += sizeof(word);
+        pos += sizeof(word);
+        wasSpace = text[offset - 1] == ' ';
+      }
+      if ((offset >= size) || (pos >= end))
+        break;
+
+      const unsigned char c = (unsigned char) text[offset];
+      if ((c > ' ') || ((c == ' ') && !wasSpace))
+      {
+        offset += getCharLength(text[offset]);
+        ++pos;
+        wasSpace = c == ' ';
+        continue;
       }
-      else
-        curText.push_back(' ');
-      break;
-    default:
-      if (unsigned(u8Char[0])<=0x1f)
+
+      curText.append(text + start, offset - start);
+      switch (c)
+      {
+      case 4: // new section(ok)
+      case 14: // footnote: normally already ignored
+        break;
+      case 5:
       {
-        ETONYEK_DEBUG_MSG(("IWAText::parse: find bad character %d\n", (int) unsigned(u8Char[0])));
+        flushText(curText, collector);
+        collector.flushParagraph();
+        collector.insertPageBreak();
+        break;
+      }
+      case 12: // column break
+        if (m_sections.empty()) break;
+        flushText(curText, collector);
+        collector.flushParagraph();
+        collector.insertColumnBreak();
+        break;
+      case '\t' :
+        flushText(curText, collector);
+        collector.insertTab();
+        break;
+      case '\r' :
+        flushText(curText, collector);
+        collector.insertLineBreak();
+        break;
+      case '\n' :
+        flushText(curText, collector);
+        collector.flushParagraph();
+        break;
+      case ' ' :
+        flushText(curText, collector);
+        collector.insertSpace();
+        break;
+      default:
+        ETONYEK_DEBUG_MSG(("IWAText::parse: find bad character %d\n", (int) c));
         break;
       }
-      curText.append(u8Char);
-      break;
+      ++offset;
+      ++pos;
+      wasSpace = c == ' ';
+      start = offset;
     }
-    wasSpace=u8Char[0]==' ';
+    curText.append(text + start, std::min(offset, size) - start);
   }
   flushText(curText, collector);
   collector.flushParagraph();
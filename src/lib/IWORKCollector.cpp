@@ -214,6 +214,7 @@ IWORKCollector::IWORKCollector(IWORKDocumentInterface *const document)
   , m_accumulateTransform(true)
   , m_groupLevel(0)
   , m_groupOpenLevel(0)
+  , m_flattenStyles(false)
 {
 }
 
@@ -232,6 +233,11 @@ void IWORKCollector::setRecorder(const std::shared_ptr<IWORKRecorder> &recorder)
   m_recorder = recorder;
 }
 
+void IWORKCollector::setFlattenStyles(const bool flatten)
+{
+  m_flattenStyles = flatten;
+}
+
 void IWORKCollector::collectStyle(const IWORKStylePtr_t &style)
 {
   if (bool(m_recorder))
@@ -470,6 +476,9 @@ void IWORKCollector::collectStylesheet(const IWORKStylesheetPtr_t &stylesheet)
   }
 
   for_each(m_newStyles.begin(), m_newStyles.end(), std::bind(&IWORKStyle::link, _1, stylesheet));
+  // all the styles must be linked before any of them is flattened
+  if (m_flattenStyles)
+    for_each(m_newStyles.begin(), m_newStyles.end(), std::bind(&IWORKStyle::flatten, _1));
   m_newStyles.clear();
 }
 
@@ -1187,7 +1196,7 @@ void IWORKCollector::drawShape(const IWORKShapePtr_t &shape)
   const glm::dmat3 trafo = m_levelStack.top().m_trafo;
   IWORKOutputElements &elements = m_outputManager.getCurrent();
 
-  const IWORKPath path = *shape->m_path * trafo;
+  const IWORKPath path(*shape->m_path, trafo);
   bool isRectangle=path.isRectangle();
   bool hasText=bool(shape->m_text) && !shape->m_text->empty();
   bool createOnlyTextbox= hasText && isRectangle;
@@ -57,6 +57,16 @@ public:
 
   void setRecorder(const std::shared_ptr<IWORKRecorder> &recorder);
 
+  /** Flatten the styles of each stylesheet once it is linked.
+    *
+    * This is off by default, as it copies inherited properties into
+    * every style that has a parent.
+    *
+    * @arg[in] flatten flatten the styles
+    * @see IWORKStyle::flatten
+    */
+  void setFlattenStyles(bool flatten);
+
   // collector functions
 
   void collectStyle(const IWORKStylePtr_t &style);
@@ -198,6 +208,7 @@ private:
   bool m_accumulateTransform;
   int m_groupLevel;
   int m_groupOpenLevel;
+  bool m_flattenStyles;
 };
 
 } // namespace libetonyek
@@ -83,42 +83,42 @@ IWORKXMLContextPtr_t IWORKDiscardContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::bezier :
-    return std::make_shared<IWORKBezierElement>(m_state, m_data->m_path);
+    return allocateContext<IWORKBezierElement>(m_state, m_data->m_path);
   case IWORKToken::NS_URI_SF | IWORKToken::binary :
-    return std::make_shared<IWORKBinaryElement>(m_state, m_data->m_mediaContent);
+    return allocateContext<IWORKBinaryElement>(m_state, m_data->m_mediaContent);
   case IWORKToken::NS_URI_SF | IWORKToken::cell_style :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_cellStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::characterstyle :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_characterStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_characterStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::core_image_filter_descriptor :
-    return std::make_shared<IWORKCoreImageFilterDescriptorElement>(m_state, m_data->m_isShadow);
+    return allocateContext<IWORKCoreImageFilterDescriptorElement>(m_state, m_data->m_isShadow);
   case IWORKToken::NS_URI_SF | IWORKToken::data :
     m_data->m_data.reset();
-    return std::make_shared<IWORKDataElement>(m_state, m_data->m_data, m_data->m_fillColor);
+    return allocateContext<IWORKDataElement>(m_state, m_data->m_data, m_data->m_fillColor);
   case IWORKToken::NS_URI_SF | IWORKToken::layoutstyle :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_layoutStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::liststyle :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_listStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_listStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::listLabelIndents :
-    return std::make_shared<IWORKListLabelIndentsProperty>(m_state, m_data->m_propertyMap);
+    return allocateContext<IWORKListLabelIndentsProperty>(m_state, m_data->m_propertyMap);
   case IWORKToken::NS_URI_SF | IWORKToken::list_label_geometry :
-    return std::make_shared<IWORKListLabelGeometryElement>(m_state, m_data->m_listLabelGeometry);
+    return allocateContext<IWORKListLabelGeometryElement>(m_state, m_data->m_listLabelGeometry);
   case IWORKToken::NS_URI_SF | IWORKToken::list_label_typeinfo :
-    return std::make_shared<IWORKListLabelTypeinfoElement>(m_state, m_data->m_listLabelTypeInfo);
+    return allocateContext<IWORKListLabelTypeinfoElement>(m_state, m_data->m_listLabelTypeInfo);
   case IWORKToken::NS_URI_SF | IWORKToken::paragraphstyle :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_paragraphStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::slide_style :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_slideStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_slideStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::tabs :
     m_data->m_tabStops.clear();
-    return std::make_shared<IWORKTabsElement>(m_state, m_data->m_tabStops);
+    return allocateContext<IWORKTabsElement>(m_state, m_data->m_tabStops);
   case IWORKToken::NS_URI_SF | IWORKToken::tabular_style :
-    return std::make_shared<IWORKStyleContext>(m_state, &m_state.getDictionary().m_tabularStyles);
+    return allocateContext<IWORKStyleContext>(m_state, &m_state.getDictionary().m_tabularStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::text_label :
-    return std::make_shared<IWORKTextLabelElement>(m_state, m_data->m_listLabelTypeInfo);
+    return allocateContext<IWORKTextLabelElement>(m_state, m_data->m_listLabelTypeInfo);
   case IWORKToken::NS_URI_SF | IWORKToken::unfiltered :
     m_data->m_mediaContent.reset();
-    return std::make_shared<IWORKUnfilteredElement>(m_state, m_data->m_mediaContent);
+    return allocateContext<IWORKUnfilteredElement>(m_state, m_data->m_mediaContent);
   default:
     break;
   }
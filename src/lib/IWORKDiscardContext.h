@@ -22,8 +22,8 @@ class IWORKXMLParserState;
 /* Warning in g++ because std::enable_shared_from_this<IWORKDiscardContext> has no virtual
    destructor.
 
-   If we replace public by protected, error with clang++ in KEY2Parser.cpp:1595 when doing
-   std::make_shared<DiscardContext>(m_state)
+   If we replace public by protected, error with clang++ in KEY2Parser.cpp:1621 when doing
+   allocateContext<DiscardContext>(m_state)
  */
 #if defined __GNUC__ && !defined __clang__
 #pragma GCC diagnostic push
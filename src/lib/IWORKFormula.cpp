@@ -10,11 +10,15 @@
 #include "IWORKFormula.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <iterator>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/fusion/adapted/std_pair.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
 #include <boost/spirit/include/qi.hpp>
@@ -392,6 +396,163 @@ struct FormulaGrammar : public qi::grammar<Iterator, Expression()>
 #pragma warning(pop)
 #endif
 
+typedef FormulaGrammar<string::const_iterator> StringFormulaGrammar_t;
+
+/** Get the formula grammar of the calling thread.
+  *
+  * Constructing the grammar is expensive, so it is built just once
+  * per thread and reused for all the subsequent parses.
+  */
+const StringFormulaGrammar_t &getFormulaGrammar()
+{
+  thread_local const StringFormulaGrammar_t grammar;
+  return grammar;
+}
+
+const std::size_t MAX_FORMULA_CACHE_SIZE = 4096;
+
+bool isNamePart(const char c)
+{
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+void appendCoord(string &key, const char name, const bool absolute, const int value, const int host)
+{
+  key += name;
+  if (absolute)
+  {
+    key += '$';
+    key += std::to_string(value);
+  }
+  else
+  {
+    key += '[';
+    key += std::to_string(value - host);
+    key += ']';
+  }
+}
+
+/** Create the key of a formula with cell references relative to the host cell.
+  *
+  * The key is the formula string with every relative reference
+  * replaced by its R1C1-like offset from the host cell, so formulas
+  * that are shifted copies of each other (e.g., in a filled down
+  * column) get the same key.
+  *
+  * @arg[in] formula the formula string
+  * @arg[in] hc the host cell, as 256 * row + column
+  * @arg[out] key the key
+  * @return false if the formula contains something that cannot be
+  * reliably normalized (e.g., a column or row range), in which case
+  * the formula must not be shared with other cells.
+  */
+bool makeRelativeKey(const string &formula, const unsigned hc, string &key)
+{
+  const int hostRow = int(hc / 256);
+  const int hostColumn = int(hc % 256);
+
+  key.clear();
+  key.reserve(formula.size() + 16);
+
+  const std::size_t size = formula.size();
+  std::size_t i = 0;
+  while (i < size)
+  {
+    const char c = formula[i];
+    if (c == '"')
+    {
+      const std::size_t close = formula.find('"', i + 1);
+      const std::size_t next = (close == string::npos) ? size : close + 1;
+      key.append(formula, i, next - i);
+      i = next;
+      continue;
+    }
+
+    const bool tokenStart = (i == 0) || !isNamePart(formula[i - 1]);
+    if (!tokenStart || !(std::isalnum(static_cast<unsigned char>(c)) || c == '$'))
+    {
+      key += c;
+      ++i;
+      continue;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)))
+    {
+      // a number, unless it is a part of a row range
+      std::size_t j = i;
+      while (j < size && isNamePart(formula[j]))
+        ++j;
+      if ((i > 0 && formula[i - 1] == ':') || (j < size && formula[j] == ':'))
+        return false;
+      key.append(formula, i, j - i);
+      i = j;
+      continue;
+    }
+
+    // [$]letters[$]digits is a cell reference
+    std::size_t j = i;
+    const bool absColumn = formula[j] == '$';
+    if (absColumn)
+      ++j;
+    const std::size_t columnStart = j;
+    while (j < size && std::isalpha(static_cast<unsigned char>(formula[j])))
+      ++j;
+    const std::size_t columnEnd = j;
+    const bool absRow = j < size && formula[j] == '$';
+    if (absRow)
+      ++j;
+    const std::size_t rowStart = j;
+    while (j < size && std::isdigit(static_cast<unsigned char>(formula[j])))
+      ++j;
+    const std::size_t rowEnd = j;
+
+    if (columnStart == columnEnd)
+    {
+      if (rowStart == rowEnd || !absColumn || absRow)
+        return false;
+      // an absolute row, e.g., in $1:$3
+      key.append(formula, i, j - i);
+      i = j;
+      continue;
+    }
+
+    if (rowStart == rowEnd)
+    {
+      if (absRow)
+        return false;
+      // a function name or a table ID; anything else might be a column
+      while (j < size && isNamePart(formula[j]))
+        ++j;
+      const string name(formula, i, j - i);
+      if ((j < size && formula[j] == '(') || boost::starts_with(name, "SFTGlobalID_"))
+      {
+        key += name;
+        i = j;
+        continue;
+      }
+      return false;
+    }
+
+    if (j < size && (isNamePart(formula[j]) || formula[j] == '('))
+    {
+      if (absColumn || absRow)
+        return false;
+      // a function name containing digits, e.g., LOG10
+      while (j < size && isNamePart(formula[j]))
+        ++j;
+      key.append(formula, i, j - i);
+      i = j;
+      continue;
+    }
+
+    const vector<char> columnName(formula.begin() + long(columnStart), formula.begin() + long(columnEnd));
+    appendCoord(key, 'C', absColumn, int(parseRowName(columnName)), hostColumn);
+    appendCoord(key, 'R', absRow, std::atoi(formula.c_str() + rowStart), hostRow);
+    i = j;
+  }
+  return true;
+}
+
 }
 
 namespace
@@ -806,38 +967,85 @@ private:
 
 struct IWORKFormula::Impl
 {
-  Impl()
+  explicit Impl(const boost::optional<unsigned> &hc)
     : m_formula()
     , m_tokenList()
+    , m_hc(hc)
   {
   }
   Expression m_formula;
   std::vector<Token> m_tokenList;
+  //! the host cell the relative references are relative to
+  boost::optional<unsigned> m_hc;
 };
 
 IWORKFormula::IWORKFormula(const boost::optional<unsigned> &hc)
-  : m_impl(new Impl())
+  : m_impl(new Impl(hc))
   , m_hc(hc)
 {
 }
 
 bool IWORKFormula::parse(const std::string &formula)
 {
-  FormulaGrammar<string::const_iterator> grammar;
+  // Identical formulas are common, so each is parsed only once and the
+  // result is shared. If the host cell is known, the formula is keyed
+  // by its relative form, so shifted copies in a filled down column
+  // share the same parse too; the references are only moved to the
+  // right cell by write() and str(). A failed parse is remembered as a
+  // null pointer.
+  typedef std::unordered_map<string, std::shared_ptr<const Impl> > Cache_t;
+  thread_local Cache_t cache;
+  thread_local string key;
+
+  if (!m_hc)
+  {
+    key = 'a';
+    key += formula;
+  }
+  else if (makeRelativeKey(formula, get(m_hc), key))
+  {
+    key.insert(0, 1, 'r');
+  }
+  else
+  {
+    key = 'h';
+    key += std::to_string(get(m_hc));
+    key += ':';
+    key += formula;
+  }
+
+  const Cache_t::const_iterator cached = cache.find(key);
+  if (cached != cache.end())
+  {
+    if (!cached->second)
+      return false;
+    m_impl = cached->second;
+    return true;
+  }
+
+  if (cache.size() >= MAX_FORMULA_CACHE_SIZE)
+    cache.clear();
+
+  std::shared_ptr<Impl> impl(new Impl(m_hc));
   string::const_iterator it = formula.begin();
   string::const_iterator end = formula.end();
-  const bool r = qi::phrase_parse(it, end, grammar, ascii::space, m_impl->m_formula);
+  const bool r = qi::phrase_parse(it, end, getFormulaGrammar(), ascii::space, impl->m_formula);
   if (!r || it!=end)
   {
     ETONYEK_DEBUG_MSG(("IWORKFormula::parse: can not parse %s\n", formula.c_str()));
+    cache[key].reset();
     return false;
   }
+  cache[key] = impl;
+  m_impl = impl;
   return true;
 }
 
 bool IWORKFormula::parse(const std::vector<IWORKFormula::Token> &formula)
 {
-  m_impl->m_tokenList=formula;
+  std::shared_ptr<Impl> impl(new Impl(m_hc));
+  impl->m_tokenList=formula;
+  m_impl = impl;
   return true;
 }
 
@@ -871,16 +1079,20 @@ void IWORKFormula::write(const boost::optional<unsigned> &hc, librevenge::RVNGPr
 bool IWORKFormula::computeOffset(const boost::optional<unsigned> &hc, int &offsetColumn, int &offsetRow) const
 {
   offsetColumn=offsetRow=0;
-  if (!m_hc && !hc)
+  // the parsed formula may be shared with another cell, so the offset
+  // is computed from the cell it was parsed for
+  const boost::optional<unsigned> &origHC = m_impl->m_hc;
+  const boost::optional<unsigned> &destHC = hc ? hc : m_hc;
+  if (!origHC && !destHC)
     return true;
-  if (!m_hc || !hc)
+  if (!origHC || !destHC)
   {
     ETONYEK_DEBUG_MSG(("IWORKFormula::parse: called without cell positions\n"));
     return false;
   }
-  if (get(m_hc)==get(hc)) return true;
-  int prevRow=(int) get(m_hc)/256, prevColumn=(int) get(m_hc)%256;
-  int row=(int) get(hc)/256, column=(int) get(hc)%256;
+  if (get(origHC)==get(destHC)) return true;
+  int prevRow=(int) get(origHC)/256, prevColumn=(int) get(origHC)%256;
+  int row=(int) get(destHC)/256, column=(int) get(destHC)%256;
   offsetColumn=column-prevColumn;
   offsetRow=row-prevRow;
   return true;
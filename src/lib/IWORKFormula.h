@@ -108,7 +108,7 @@ public:
 
 private:
   bool computeOffset(const boost::optional<unsigned> &hc, int &offsetColumn, int &offsetRow) const;
-  std::shared_ptr<Impl> m_impl;
+  std::shared_ptr<const Impl> m_impl;
   boost::optional<unsigned> m_hc;
 };
 
@@ -9,8 +9,8 @@
 
 #include "IWORKMemoryStream.h"
 
-#include <algorithm>
 #include <cassert>
+#include <utility>
 
 #include "libetonyek_utils.h"
 
@@ -18,7 +18,8 @@ namespace libetonyek
 {
 
 IWORKMemoryStream::IWORKMemoryStream(const RVNGInputStreamPtr_t &input)
-  : m_data()
+  : m_buffer()
+  , m_data(nullptr)
   , m_length(0)
   , m_pos(0)
 {
@@ -35,7 +36,8 @@ IWORKMemoryStream::IWORKMemoryStream(const RVNGInputStreamPtr_t &input)
 }
 
 IWORKMemoryStream::IWORKMemoryStream(const RVNGInputStreamPtr_t &input, const unsigned length)
-  : m_data()
+  : m_buffer()
+  , m_data(nullptr)
   , m_length(0)
   , m_pos(0)
 {
@@ -43,7 +45,8 @@ IWORKMemoryStream::IWORKMemoryStream(const RVNGInputStreamPtr_t &input, const un
 }
 
 IWORKMemoryStream::IWORKMemoryStream(const std::vector<unsigned char> &data)
-  : m_data()
+  : m_buffer()
+  , m_data(nullptr)
   , m_length(long(data.size()))
   , m_pos(0)
 {
@@ -53,8 +56,22 @@ IWORKMemoryStream::IWORKMemoryStream(const std::vector<unsigned char> &data)
   assign(&data[0], (unsigned) data.size());
 }
 
+IWORKMemoryStream::IWORKMemoryStream(std::vector<unsigned char> &&data)
+  : m_buffer()
+  , m_data(nullptr)
+  , m_length(long(data.size()))
+  , m_pos(0)
+{
+  if (data.empty())
+    throw GenericException();
+
+  m_buffer = std::make_shared<const std::vector<unsigned char>>(std::move(data));
+  m_data = m_buffer->data();
+}
+
 IWORKMemoryStream::IWORKMemoryStream(const unsigned char *const data, const unsigned length)
-  : m_data(nullptr)
+  : m_buffer()
+  , m_data(nullptr)
   , m_length(long(length))
   , m_pos(0)
 {
@@ -64,10 +81,28 @@ IWORKMemoryStream::IWORKMemoryStream(const unsigned char *const data, const unsi
   assign(data, length);
 }
 
+IWORKMemoryStream::IWORKMemoryStream(const Buffer_t &buffer, const unsigned char *const data, const long length)
+  : m_buffer(buffer)
+  , m_data(data)
+  , m_length(length)
+  , m_pos(0)
+{
+  assert(bool(m_buffer));
+  assert(m_data >= m_buffer->data());
+  assert(m_data + m_length <= m_buffer->data() + m_buffer->size());
+}
+
 IWORKMemoryStream::~IWORKMemoryStream()
 {
 }
 
+RVNGInputStreamPtr_t IWORKMemoryStream::view(const long offset, const unsigned long length) const
+{
+  if ((offset < 0) || (offset > m_length) || (length == 0) || (length > static_cast<unsigned long>(m_length - offset)))
+    return RVNGInputStreamPtr_t();
+  return RVNGInputStreamPtr_t(new IWORKMemoryStream(m_buffer, m_data + offset, long(length)));
+}
+
 bool IWORKMemoryStream::isStructured()
 {
   return false;
@@ -107,7 +142,7 @@ const unsigned char *IWORKMemoryStream::read(unsigned long numBytes, unsigned lo
   m_pos += numBytes;
 
   numBytesRead = numBytes;
-  return m_data.get() + oldPos;
+  return m_data + oldPos;
 }
 catch (...)
 {
@@ -157,8 +192,8 @@ void IWORKMemoryStream::assign(const unsigned char *const data, const unsigned l
 {
   assert(0 != length);
 
-  m_data.reset(new unsigned char[length]);
-  std::copy(data, data + length, m_data.get());
+  m_buffer = std::make_shared<const std::vector<unsigned char>>(data, data + length);
+  m_data = m_buffer->data();
 }
 
 void IWORKMemoryStream::read(const RVNGInputStreamPtr_t &input, const unsigned length)
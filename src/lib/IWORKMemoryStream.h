@@ -28,9 +28,22 @@ public:
   explicit IWORKMemoryStream(const RVNGInputStreamPtr_t &input);
   IWORKMemoryStream(const RVNGInputStreamPtr_t &input, unsigned length);
   explicit IWORKMemoryStream(const std::vector<unsigned char> &data);
+  /// Take ownership of @c data, without copying it.
+  explicit IWORKMemoryStream(std::vector<unsigned char> &&data);
   IWORKMemoryStream(const unsigned char *data, unsigned length);
   ~IWORKMemoryStream() override;
 
+  /** Create a stream over a part of this stream's data.
+    *
+    * The data are not copied: the new stream shares them with this
+    * one (and with all other views created from it).
+    *
+    * @arg[in] offset the start of the view
+    * @arg[in] length the length of the view
+    * @returns the view or an empty pointer if the range is not valid
+    */
+  RVNGInputStreamPtr_t view(long offset, unsigned long length) const;
+
   bool isStructured() override;
   unsigned subStreamCount() override;
   const char *subStreamName(unsigned id) override;
@@ -47,11 +60,16 @@ public:
   bool isEnd() override;
 
 private:
+  typedef std::shared_ptr<const std::vector<unsigned char>> Buffer_t;
+
+  IWORKMemoryStream(const Buffer_t &buffer, const unsigned char *data, long length);
+
   void assign(const unsigned char *data, unsigned length);
   void read(const RVNGInputStreamPtr_t &input, unsigned length);
 
 private:
-  std::unique_ptr<unsigned char[]> m_data;
+  Buffer_t m_buffer;
+  const unsigned char *m_data;
   long m_length;
   long m_pos;
 };
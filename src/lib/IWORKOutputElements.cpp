@@ -9,7 +9,12 @@
 
 #include "IWORKOutputElements.h"
 
-#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
 
 #include "IWORKDocumentInterface.h"
 #include "IWORKFormula.h"
@@ -17,1170 +22,1075 @@
 namespace libetonyek
 {
 
-using std::make_shared;
-
-class IWORKOutputElement
-{
-  // disable copying
-  IWORKOutputElement(const IWORKOutputElement &);
-  IWORKOutputElement &operator=(const IWORKOutputElement &);
-
-public:
-  IWORKOutputElement() {}
-  virtual ~IWORKOutputElement() {}
-  virtual void write(IWORKDocumentInterface *iface) const = 0;
-};
-
 namespace
 {
 
-class CloseCommentElement : public IWORKOutputElement
-{
-public:
-  CloseCommentElement() {}
-  ~CloseCommentElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseEndnoteElement : public IWORKOutputElement
-{
-public:
-  CloseEndnoteElement() {}
-  ~CloseEndnoteElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseFooterElement : public IWORKOutputElement
-{
-public:
-  CloseFooterElement() {}
-  ~CloseFooterElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseFootnoteElement : public IWORKOutputElement
-{
-public:
-  CloseFootnoteElement() {}
-  ~CloseFootnoteElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseFrameElement : public IWORKOutputElement
-{
-public:
-  CloseFrameElement() {}
-  ~CloseFrameElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseGroupElement : public IWORKOutputElement
-{
-public:
-  CloseGroupElement() {}
-  ~CloseGroupElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseHeaderElement : public IWORKOutputElement
-{
-public:
-  CloseHeaderElement() {}
-  ~CloseHeaderElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseLinkElement : public IWORKOutputElement
-{
-public:
-  CloseLinkElement() {}
-  ~CloseLinkElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseListElementElement : public IWORKOutputElement
-{
-public:
-  CloseListElementElement() {}
-  ~CloseListElementElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseOrderedListLevelElement : public IWORKOutputElement
-{
-public:
-  CloseOrderedListLevelElement() {}
-  ~CloseOrderedListLevelElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseParagraphElement : public IWORKOutputElement
-{
-public:
-  CloseParagraphElement() {}
-  ~CloseParagraphElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseSectionElement : public IWORKOutputElement
-{
-public:
-  CloseSectionElement() {}
-  ~CloseSectionElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseSpanElement : public IWORKOutputElement
-{
-public:
-  CloseSpanElement() {}
-  ~CloseSpanElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseTableElement : public IWORKOutputElement
-{
-public:
-  CloseTableElement() {}
-  ~CloseTableElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseTableCellElement : public IWORKOutputElement
-{
-public:
-  CloseTableCellElement() {}
-  ~CloseTableCellElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseTableRowElement : public IWORKOutputElement
-{
-public:
-  CloseTableRowElement() {}
-  ~CloseTableRowElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class CloseUnorderedListLevelElement : public IWORKOutputElement
-{
-public:
-  CloseUnorderedListLevelElement() {}
-  ~CloseUnorderedListLevelElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class DefineSheetNumberingStyleElement : public IWORKOutputElement
-{
-public:
-  explicit DefineSheetNumberingStyleElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~DefineSheetNumberingStyleElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class DrawGraphicObjectElement : public IWORKOutputElement
-{
-public:
-  explicit DrawGraphicObjectElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~DrawGraphicObjectElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class DrawPathElement : public IWORKOutputElement
-{
-public:
-  explicit DrawPathElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~DrawPathElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
+/** The recorded events.
+  *
+  * Each event is stored as its opcode, followed by the ID of its
+  * payload in IWORKOutputElements::Storage for opcodes starting from
+  * FIRST_PAYLOAD_OPCODE.
+  */
+enum Opcode
+{
+  OP_CLOSE_COMMENT,
+  OP_CLOSE_ENDNOTE,
+  OP_CLOSE_FOOTER,
+  OP_CLOSE_FOOTNOTE,
+  OP_CLOSE_FRAME,
+  OP_CLOSE_GROUP,
+  OP_CLOSE_HEADER,
+  OP_CLOSE_LINK,
+  OP_CLOSE_LIST_ELEMENT,
+  OP_CLOSE_ORDERED_LIST_LEVEL,
+  OP_CLOSE_PARAGRAPH,
+  OP_CLOSE_SECTION,
+  OP_CLOSE_SPAN,
+  OP_CLOSE_TABLE,
+  OP_CLOSE_TABLE_CELL,
+  OP_CLOSE_TABLE_ROW,
+  OP_CLOSE_UNORDERED_LIST_LEVEL,
+  OP_END_LAYER,
+  OP_END_NOTES,
+  OP_END_TEXT_OBJECT,
+  OP_INSERT_LINE_BREAK,
+  OP_INSERT_SPACE,
+  OP_INSERT_TAB,
+
+  OP_DEFINE_SHEET_NUMBERING_STYLE,
+  OP_DRAW_GRAPHIC_OBJECT,
+  OP_DRAW_PATH,
+  OP_DRAW_POLYLINE,
+  OP_INSERT_BINARY_OBJECT,
+  OP_INSERT_COVERED_TABLE_CELL,
+  OP_INSERT_FIELD,
+  OP_OPEN_COMMENT,
+  OP_OPEN_ENDNOTE,
+  OP_OPEN_FOOTER,
+  OP_OPEN_FOOTNOTE,
+  OP_OPEN_FRAME,
+  OP_OPEN_GROUP,
+  OP_OPEN_HEADER,
+  OP_OPEN_LINK,
+  OP_OPEN_LIST_ELEMENT,
+  OP_OPEN_ORDERED_LIST_LEVEL,
+  OP_OPEN_PARAGRAPH,
+  OP_OPEN_SECTION,
+  OP_OPEN_SPAN,
+  OP_OPEN_TABLE,
+  OP_OPEN_TABLE_CELL,
+  OP_OPEN_TABLE_ROW,
+  OP_OPEN_UNORDERED_LIST_LEVEL,
+  OP_SET_STYLE,
+  OP_START_LAYER,
+  OP_START_NOTES,
+  OP_START_TEXT_OBJECT,
+  OP_INSERT_TEXT,
+  OP_OPEN_FORMULA_CELL,
+
+  FIRST_PAYLOAD_OPCODE = OP_DEFINE_SHEET_NUMBERING_STYLE
 };
 
-class DrawPolylineElement : public IWORKOutputElement
+bool hasPayload(const unsigned char opcode)
 {
-public:
-  explicit DrawPolylineElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~DrawPolylineElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class EndLayerElement : public IWORKOutputElement
-{
-public:
-  EndLayerElement() {}
-  ~EndLayerElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class EndNotesElement : public IWORKOutputElement
-{
-public:
-  EndNotesElement() {}
-  ~EndNotesElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class EndTextObjectElement : public IWORKOutputElement
-{
-public:
-  EndTextObjectElement() {}
-  ~EndTextObjectElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
-
-class InsertBinaryObjectElement : public IWORKOutputElement
-{
-public:
-  explicit InsertBinaryObjectElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~InsertBinaryObjectElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class InsertCoveredTableCellElement : public IWORKOutputElement
-{
-public:
-  explicit InsertCoveredTableCellElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~InsertCoveredTableCellElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  return opcode >= FIRST_PAYLOAD_OPCODE;
+}
 
-class InsertFieldElement : public IWORKOutputElement
-{
-public:
-  explicit InsertFieldElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~InsertFieldElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+typedef uint32_t PayloadID_t;
 
-class InsertLineBreakElement : public IWORKOutputElement
-{
-public:
-  InsertLineBreakElement() {}
-  ~InsertLineBreakElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
+const std::size_t PAYLOAD_SIZE = sizeof(PayloadID_t);
 
-class InsertSpaceElement : public IWORKOutputElement
+std::size_t getEventSize(const unsigned char opcode)
 {
-public:
-  InsertSpaceElement() {}
-  ~InsertSpaceElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
+  return hasPayload(opcode) ? 1 + PAYLOAD_SIZE : 1;
+}
 
-class InsertTabElement : public IWORKOutputElement
+PayloadID_t readPayload(const unsigned char *const data)
 {
-public:
-  InsertTabElement() {}
-  ~InsertTabElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-};
+  PayloadID_t id;
+  std::memcpy(&id, data, PAYLOAD_SIZE);
+  return id;
+}
 
-class InsertTextElement : public IWORKOutputElement
+void writePayload(std::vector<unsigned char> &events, const PayloadID_t id)
 {
-public:
-  explicit InsertTextElement(const librevenge::RVNGString &text) :
-    m_text(text) {}
-  ~InsertTextElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGString m_text;
-};
+  unsigned char data[PAYLOAD_SIZE];
+  std::memcpy(data, &id, PAYLOAD_SIZE);
+  events.insert(events.end(), data, data + PAYLOAD_SIZE);
+}
 
-class OpenCommentElement : public IWORKOutputElement
+/** Append a key identifying the content of a property list to @c key.
+  *
+  * The string form of a property is not enough, as it loses precision
+  * of numbers, so the numeric value and the unit are added too.
+  */
+void appendKey(const librevenge::RVNGPropertyList &propList, std::string &key)
 {
-public:
-  explicit OpenCommentElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenCommentElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  librevenge::RVNGPropertyList::Iter i(propList);
+  for (i.rewind(); i.next();)
+  {
+    key += i.key();
+    key += '\0';
+    if (i.child())
+    {
+      key += '[';
+      for (unsigned long j = 0; j < i.child()->count(); ++j)
+      {
+        appendKey((*i.child())[j], key);
+        key += ',';
+      }
+      key += ']';
+    }
+    else if (i())
+    {
+      key += i()->getStr().cstr();
+      key += '\0';
+      const double value = i()->getDouble();
+      key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+      key += char(i()->getUnit());
+    }
+    key += '\0';
+  }
+}
 
-class OpenEndnoteElement : public IWORKOutputElement
+struct FormulaCell
 {
-public:
-  explicit OpenEndnoteElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenEndnoteElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  FormulaCell()
+    : m_propList(0)
+    , m_formula(boost::none)
+    , m_formulaHC()
+    , m_tableNameMap()
+  {
+  }
 
-class OpenFormulaCellElement : public IWORKOutputElement
-{
-public:
-  OpenFormulaCellElement(const librevenge::RVNGPropertyList &propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap)
+  FormulaCell(PayloadID_t propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap)
     : m_propList(propList)
     , m_formula(formula)
     , m_formulaHC(formulaHC)
-    , m_tableNameMap(tableNameMap) {}
-  ~OpenFormulaCellElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-  const IWORKFormula m_formula;
-  const boost::optional<unsigned> m_formulaHC;
-  const IWORKTableNameMapPtr_t m_tableNameMap;
-};
-
-class OpenFooterElement : public IWORKOutputElement
-{
-public:
-  explicit OpenFooterElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenFooterElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class OpenFootnoteElement : public IWORKOutputElement
-{
-public:
-  explicit OpenFootnoteElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenFootnoteElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class OpenFrameElement : public IWORKOutputElement
-{
-public:
-  explicit OpenFrameElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenFrameElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class OpenGroupElement : public IWORKOutputElement
-{
-public:
-  explicit OpenGroupElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenGroupElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+    , m_tableNameMap(tableNameMap)
+  {
+  }
 
-class OpenHeaderElement : public IWORKOutputElement
-{
-public:
-  explicit OpenHeaderElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenHeaderElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
+  PayloadID_t m_propList;
+  IWORKFormula m_formula;
+  boost::optional<unsigned> m_formulaHC;
+  IWORKTableNameMapPtr_t m_tableNameMap;
 };
 
-class OpenLinkElement : public IWORKOutputElement
+/** A pool of reference counted payloads of one kind.
+  *
+  * The payloads are kept in a deque, so they never move. The slot of
+  * a freed payload is reused by the next added one.
+  */
+template<typename T>
+class PayloadPool
 {
 public:
-  explicit OpenLinkElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenLinkElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
-
-class OpenListElementElement : public IWORKOutputElement
-{
-public:
-  explicit OpenListElementElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenListElementElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  PayloadPool()
+    : m_values()
+    , m_refCounts()
+    , m_freeIDs()
+  {
+  }
 
-class OpenOrderedListLevelElement : public IWORKOutputElement
-{
-public:
-  explicit OpenOrderedListLevelElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenOrderedListLevelElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  /** Add a payload with one reference.
+    */
+  PayloadID_t add(const T &value)
+  {
+    if (m_freeIDs.empty())
+    {
+      m_values.push_back(value);
+      m_refCounts.push_back(1);
+      return PayloadID_t(m_values.size() - 1);
+    }
+    const PayloadID_t id = m_freeIDs.back();
+    m_freeIDs.pop_back();
+    m_values[id] = value;
+    m_refCounts[id] = 1;
+    return id;
+  }
 
-class OpenParagraphElement : public IWORKOutputElement
-{
-public:
-  explicit OpenParagraphElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenParagraphElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  const T &get(const PayloadID_t id) const
+  {
+    assert(id < m_values.size());
+    assert(m_refCounts[id] > 0);
+    return m_values[id];
+  }
 
-class OpenSectionElement : public IWORKOutputElement
-{
-public:
-  explicit OpenSectionElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenSectionElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  void ref(const PayloadID_t id)
+  {
+    assert(id < m_refCounts.size());
+    assert(m_refCounts[id] > 0);
+    ++m_refCounts[id];
+  }
 
-class OpenSpanElement : public IWORKOutputElement
-{
-public:
-  explicit OpenSpanElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenSpanElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  /** Drop a reference to a payload.
+    *
+    * @return true if it was the last reference and the payload has
+    *   been freed
+    */
+  bool unref(const PayloadID_t id)
+  {
+    assert(id < m_refCounts.size());
+    assert(m_refCounts[id] > 0);
+    if (--m_refCounts[id] > 0)
+      return false;
+    m_values[id] = T();
+    m_freeIDs.push_back(id);
+    return true;
+  }
 
-class OpenTableElement : public IWORKOutputElement
-{
-public:
-  explicit OpenTableElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenTableElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
 private:
-  librevenge::RVNGPropertyList m_propList;
+  std::deque<T> m_values;
+  std::vector<unsigned> m_refCounts;
+  std::vector<PayloadID_t> m_freeIDs;
 };
 
-class OpenTableCellElement : public IWORKOutputElement
+/** Check if equal payloads of events with @c opcode are stored once.
+  *
+  * Images and geometry (paths, polylines, frame positions) are nearly
+  * always unique, and their keys would be as big as the property
+  * lists themselves.
+  */
+bool isInterned(const unsigned char opcode)
 {
-public:
-  explicit OpenTableCellElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenTableCellElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  switch (opcode)
+  {
+  case OP_DRAW_GRAPHIC_OBJECT :
+  case OP_DRAW_PATH :
+  case OP_DRAW_POLYLINE :
+  case OP_INSERT_BINARY_OBJECT :
+  case OP_OPEN_FRAME :
+    return false;
+  default :
+    break;
+  }
+  return true;
+}
 
-class OpenTableRowElement : public IWORKOutputElement
-{
-public:
-  explicit OpenTableRowElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenTableRowElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+thread_local IWORKOutputElements::StoragePtr_t defaultStorage;
 
-class OpenUnorderedListLevelElement : public IWORKOutputElement
-{
-public:
-  explicit OpenUnorderedListLevelElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~OpenUnorderedListLevelElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+}
 
-class SetStyleElement : public IWORKOutputElement
+/** The payloads of recorded events.
+  *
+  * Each payload is reference counted by the recordings containing
+  * it and freed when the last of them lets go of it. Equal property
+  * lists (e.g., the same span or paragraph properties repeated all
+  * over a document) are stored just once.
+  */
+class IWORKOutputElements::Storage
 {
-public:
-  explicit SetStyleElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~SetStyleElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  librevenge::RVNGPropertyList m_propList;
-};
+  // disable copying
+  Storage(const Storage &);
+  Storage &operator=(const Storage &);
 
-class StartLayerElement : public IWORKOutputElement
-{
 public:
-  explicit StartLayerElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~StartLayerElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
-private:
-  const librevenge::RVNGPropertyList m_propList;
-};
+  Storage();
+
+  /** Add the payload of an event.
+    *
+    * @arg[in] opcode the opcode of the event
+    * @arg[in] propList the property list of the event
+    * @return the ID of the payload, with one reference
+    */
+  PayloadID_t addPropList(unsigned char opcode, const librevenge::RVNGPropertyList &propList);
+  PayloadID_t addText(const librevenge::RVNGString &text);
+  PayloadID_t addFormulaCell(const librevenge::RVNGPropertyList &propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap);
+
+  /** Copy a payload from another storage.
+    *
+    * @arg[in] opcode the opcode of the event owning the payload
+    * @arg[in] id the ID of the payload in @c other
+    * @arg[in] other the storage containing the payload
+    * @return the ID of the payload in this storage, with one reference
+    */
+  PayloadID_t copyPayload(unsigned char opcode, PayloadID_t id, const Storage &other);
+
+  void refPayload(unsigned char opcode, PayloadID_t id);
+  void unrefPayload(unsigned char opcode, PayloadID_t id);
+
+  const librevenge::RVNGPropertyList &getPropList(PayloadID_t id) const;
+  const librevenge::RVNGString &getText(PayloadID_t id) const;
+  const FormulaCell &getFormulaCell(PayloadID_t id) const;
 
-class StartNotesElement : public IWORKOutputElement
-{
-public:
-  explicit StartNotesElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~StartNotesElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
 private:
-  const librevenge::RVNGPropertyList m_propList;
-};
+  PayloadID_t addPropList(const librevenge::RVNGPropertyList &propList, bool intern);
+  void unrefPropList(PayloadID_t id);
 
-class StartTextObjectElement : public IWORKOutputElement
-{
-public:
-  explicit StartTextObjectElement(const librevenge::RVNGPropertyList &propList) :
-    m_propList(propList) {}
-  ~StartTextObjectElement() override {}
-  void write(IWORKDocumentInterface *iface) const override;
 private:
-  librevenge::RVNGPropertyList m_propList;
+  PayloadPool<librevenge::RVNGPropertyList> m_propLists;
+  std::unordered_map<std::string, PayloadID_t> m_propListMap;
+  //! the keys of interned property lists in m_propListMap, by ID
+  std::vector<const std::string *> m_propListKeys;
+  PayloadPool<librevenge::RVNGString> m_texts;
+  PayloadPool<FormulaCell> m_formulaCells;
+  std::string m_key;
 };
 
-void CloseCommentElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeComment();
-}
-
-void CloseEndnoteElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeEndnote();
-}
-
-void CloseFooterElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeFooter();
-}
-
-void CloseFootnoteElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeFootnote();
-}
-
-void CloseFrameElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeFrame();
-}
-
-void CloseGroupElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeGroup();
-}
-
-void CloseHeaderElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeHeader();
-}
-
-void CloseLinkElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeLink();
-}
-
-void CloseListElementElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeListElement();
-}
-
-void CloseOrderedListLevelElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeOrderedListLevel();
-}
-
-void CloseParagraphElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeParagraph();
-}
-
-void CloseSectionElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeSection();
-}
-
-void CloseSpanElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeSpan();
-}
-
-void CloseTableElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeTable();
-}
-
-void CloseTableCellElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeTableCell();
-}
-
-void CloseTableRowElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeTableRow();
-}
-
-void CloseUnorderedListLevelElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->closeUnorderedListLevel();
-}
-
-void DefineSheetNumberingStyleElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->defineSheetNumberingStyle(m_propList);
-}
-
-void DrawGraphicObjectElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->drawGraphicObject(m_propList);
-}
-
-void DrawPathElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->drawPath(m_propList);
-}
-
-void DrawPolylineElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->drawPolyline(m_propList);
-}
-
-void EndLayerElement::write(IWORKDocumentInterface *const iface) const
-{
-  if (iface)
-    iface->endLayer();
-}
-
-void EndNotesElement::write(IWORKDocumentInterface *const iface) const
+IWORKOutputElements::Storage::Storage()
+  : m_propLists()
+  , m_propListMap()
+  , m_propListKeys()
+  , m_texts()
+  , m_formulaCells()
+  , m_key()
 {
-  if (iface)
-    iface->endNotes();
 }
 
-void EndTextObjectElement::write(IWORKDocumentInterface *iface) const
+PayloadID_t IWORKOutputElements::Storage::addPropList(const unsigned char opcode, const librevenge::RVNGPropertyList &propList)
 {
-  if (iface)
-    iface->endTextObject();
+  return addPropList(propList, isInterned(opcode));
 }
 
-void InsertBinaryObjectElement::write(IWORKDocumentInterface *iface) const
+PayloadID_t IWORKOutputElements::Storage::addPropList(const librevenge::RVNGPropertyList &propList, const bool intern)
 {
-  if (iface)
-    iface->insertBinaryObject(m_propList);
-}
-
-void InsertCoveredTableCellElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertCoveredTableCell(m_propList);
-}
-
-void InsertFieldElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertField(m_propList);
-}
-
-void InsertLineBreakElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertLineBreak();
-}
-
-void InsertSpaceElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertSpace();
-}
-
-void InsertTabElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertTab();
-}
-
-void InsertTextElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->insertText(m_text);
-}
-
-void OpenCommentElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->openComment(m_propList);
-}
-
-void OpenEndnoteElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->openEndnote(m_propList);
-}
-
-void OpenFormulaCellElement::write(IWORKDocumentInterface *iface) const
-{
-  librevenge::RVNGPropertyList cellProps(m_propList);
-
-  librevenge::RVNGPropertyListVector propsVector;
-  m_formula.write(m_formulaHC, propsVector, m_tableNameMap);
-  cellProps.insert("librevenge:formula", propsVector);
-
-  if (iface)
-    iface->openTableCell(cellProps);
+  const std::string *key = nullptr;
+  if (intern)
+  {
+    m_key.clear();
+    appendKey(propList, m_key);
+    const auto it = m_propListMap.find(m_key);
+    if (it != m_propListMap.end())
+    {
+      m_propLists.ref(it->second);
+      return it->second;
+    }
+  }
+  const PayloadID_t id = m_propLists.add(propList);
+  if (intern)
+    key = &m_propListMap.insert(std::make_pair(m_key, id)).first->first;
+  if (id >= m_propListKeys.size())
+    m_propListKeys.resize(id + 1, nullptr);
+  m_propListKeys[id] = key;
+  return id;
 }
 
-void OpenFooterElement::write(IWORKDocumentInterface *iface) const
+PayloadID_t IWORKOutputElements::Storage::addText(const librevenge::RVNGString &text)
 {
-  if (iface)
-    iface->openFooter(m_propList);
+  return m_texts.add(text);
 }
 
-void OpenFootnoteElement::write(IWORKDocumentInterface *iface) const
+PayloadID_t IWORKOutputElements::Storage::addFormulaCell(const librevenge::RVNGPropertyList &propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap)
 {
-  if (iface)
-    iface->openFootnote(m_propList);
+  return m_formulaCells.add(FormulaCell(addPropList(propList, true), formula, formulaHC, tableNameMap));
 }
 
-void OpenFrameElement::write(IWORKDocumentInterface *iface) const
+PayloadID_t IWORKOutputElements::Storage::copyPayload(const unsigned char opcode, const PayloadID_t id, const Storage &other)
 {
-  if (iface)
-    iface->openFrame(m_propList);
+  switch (opcode)
+  {
+  case OP_INSERT_TEXT :
+    return addText(other.getText(id));
+  case OP_OPEN_FORMULA_CELL :
+  {
+    const FormulaCell &cell = other.getFormulaCell(id);
+    return addFormulaCell(other.getPropList(cell.m_propList), cell.m_formula, cell.m_formulaHC, cell.m_tableNameMap);
+  }
+  default :
+    break;
+  }
+  return addPropList(opcode, other.getPropList(id));
 }
 
-void OpenGroupElement::write(IWORKDocumentInterface *iface) const
+void IWORKOutputElements::Storage::refPayload(const unsigned char opcode, const PayloadID_t id)
 {
-  if (iface)
-    iface->openGroup(m_propList);
+  switch (opcode)
+  {
+  case OP_INSERT_TEXT :
+    m_texts.ref(id);
+    break;
+  case OP_OPEN_FORMULA_CELL :
+    m_formulaCells.ref(id);
+    break;
+  default :
+    m_propLists.ref(id);
+    break;
+  }
 }
 
-void OpenHeaderElement::write(IWORKDocumentInterface *iface) const
+void IWORKOutputElements::Storage::unrefPayload(const unsigned char opcode, const PayloadID_t id)
 {
-  if (iface)
-    iface->openHeader(m_propList);
+  switch (opcode)
+  {
+  case OP_INSERT_TEXT :
+    m_texts.unref(id);
+    break;
+  case OP_OPEN_FORMULA_CELL :
+  {
+    const PayloadID_t propList = m_formulaCells.get(id).m_propList;
+    if (m_formulaCells.unref(id))
+      unrefPropList(propList);
+    break;
+  }
+  default :
+    unrefPropList(id);
+    break;
+  }
 }
 
-void OpenLinkElement::write(IWORKDocumentInterface *iface) const
+void IWORKOutputElements::Storage::unrefPropList(const PayloadID_t id)
 {
-  if (iface)
-    iface->openLink(m_propList);
+  if (!m_propLists.unref(id))
+    return;
+  assert(id < m_propListKeys.size());
+  if (m_propListKeys[id])
+  {
+    const auto it = m_propListMap.find(*m_propListKeys[id]);
+    assert(it != m_propListMap.end());
+    m_propListMap.erase(it);
+    m_propListKeys[id] = nullptr;
+  }
 }
 
-void OpenListElementElement::write(IWORKDocumentInterface *iface) const
+const librevenge::RVNGPropertyList &IWORKOutputElements::Storage::getPropList(const PayloadID_t id) const
 {
-  if (iface)
-    iface->openListElement(m_propList);
+  return m_propLists.get(id);
 }
 
-void OpenOrderedListLevelElement::write(IWORKDocumentInterface *iface) const
+const librevenge::RVNGString &IWORKOutputElements::Storage::getText(const PayloadID_t id) const
 {
-  if (iface)
-    iface->openOrderedListLevel(m_propList);
+  return m_texts.get(id);
 }
 
-void OpenParagraphElement::write(IWORKDocumentInterface *iface) const
+const FormulaCell &IWORKOutputElements::Storage::getFormulaCell(const PayloadID_t id) const
 {
-  if (iface)
-    iface->openParagraph(m_propList);
+  return m_formulaCells.get(id);
 }
 
-void OpenSectionElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::StoragePtr_t IWORKOutputElements::createStorage()
 {
-  if (iface)
-    iface->openSection(m_propList);
+  return std::make_shared<Storage>();
 }
 
-void OpenSpanElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::StoragePtr_t IWORKOutputElements::setDefaultStorage(const StoragePtr_t &storage)
 {
-  if (iface)
-    iface->openSpan(m_propList);
+  const StoragePtr_t previous = defaultStorage;
+  defaultStorage = storage;
+  return previous;
 }
 
-void OpenTableElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::DefaultStorageScope::DefaultStorageScope(const StoragePtr_t &storage)
+  : m_previousStorage(setDefaultStorage(storage))
 {
-  if (iface)
-    iface->openTable(m_propList);
 }
 
-void OpenTableCellElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::DefaultStorageScope::~DefaultStorageScope()
 {
-  if (iface)
-    iface->openTableCell(m_propList);
+  setDefaultStorage(m_previousStorage);
 }
 
-void OpenTableRowElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::IWORKOutputElements()
+  : m_events()
+  , m_storage()
 {
-  if (iface)
-    iface->openTableRow(m_propList);
 }
 
-void OpenUnorderedListLevelElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::IWORKOutputElements(const IWORKOutputElements &other)
+  : m_events(other.m_events)
+  , m_storage(other.m_storage)
 {
-  if (iface)
-    iface->openUnorderedListLevel(m_propList);
+  refEvents(0, m_events.size());
 }
 
-void SetStyleElement::write(IWORKDocumentInterface *iface) const
+IWORKOutputElements::IWORKOutputElements(IWORKOutputElements &&other)
+  : m_events()
+  , m_storage()
 {
-  if (iface)
-    iface->setStyle(m_propList);
+  m_events.swap(other.m_events);
+  m_storage.swap(other.m_storage);
 }
 
-void StartLayerElement::write(IWORKDocumentInterface *const iface) const
+IWORKOutputElements::~IWORKOutputElements()
 {
-  if (iface)
-    iface->startLayer(m_propList);
+  clear();
 }
 
-void StartNotesElement::write(IWORKDocumentInterface *const iface) const
+IWORKOutputElements &IWORKOutputElements::operator=(const IWORKOutputElements &other)
 {
-  if (iface)
-    iface->startNotes(m_propList);
+  IWORKOutputElements copy(other);
+  m_events.swap(copy.m_events);
+  m_storage.swap(copy.m_storage);
+  return *this;
 }
 
-void StartTextObjectElement::write(IWORKDocumentInterface *iface) const
-{
-  if (iface)
-    iface->startTextObject(m_propList);
-}
-
-}
-
-IWORKOutputElements::IWORKOutputElements()
-  : m_elements()
+IWORKOutputElements &IWORKOutputElements::operator=(IWORKOutputElements &&other)
 {
+  if (&other != this)
+  {
+    clear();
+    m_events.swap(other.m_events);
+    m_storage.swap(other.m_storage);
+  }
+  return *this;
 }
 
 void IWORKOutputElements::append(const IWORKOutputElements &elements)
 {
-  m_elements.insert(m_elements.end(), elements.m_elements.begin(), elements.m_elements.end());
+  if (&elements == this)
+  {
+    const IWORKOutputElements copy(elements);
+    append(copy);
+    return;
+  }
+  if (elements.m_events.empty())
+    return;
+  if (!m_storage)
+    m_storage = elements.m_storage;
+  if (m_storage == elements.m_storage)
+  {
+    const std::size_t begin = m_events.size();
+    m_events.insert(m_events.end(), elements.m_events.begin(), elements.m_events.end());
+    refEvents(begin, m_events.size());
+  }
+  else
+  {
+    copyEvents(elements, m_events);
+  }
 }
 
 void IWORKOutputElements::addShapesInSpreadsheet(const IWORKOutputElements &elements)
 {
-  if (m_elements.empty())
+  if (m_events.empty())
   {
     ETONYEK_DEBUG_MSG(("IWORKOutputElements::addShapesInSpreadsheet: the elements is empty\n"));
     return;
   }
+  if (&elements == this)
+  {
+    const IWORKOutputElements copy(elements);
+    addShapesInSpreadsheet(copy);
+    return;
+  }
   // TODO: check that the first element is really OpenSheet
-  m_elements.insert(m_elements.begin()+1, elements.m_elements.begin(), elements.m_elements.end());
+  const std::size_t pos = getEventSize(m_events[0]);
+  if (m_storage == elements.m_storage)
+  {
+    m_events.insert(m_events.begin() + long(pos), elements.m_events.begin(), elements.m_events.end());
+    refEvents(pos, pos + elements.m_events.size());
+  }
+  else
+  {
+    std::vector<unsigned char> events;
+    copyEvents(elements, events);
+    m_events.insert(m_events.begin() + long(pos), events.begin(), events.end());
+  }
 }
 
 void IWORKOutputElements::write(IWORKDocumentInterface *iface) const
 {
-  ElementList_t::const_iterator iter;
-  for (iter = m_elements.begin(); iter != m_elements.end(); ++iter)
-    (*iter)->write(iface);
+  if (!iface)
+    return;
+
+  for (std::size_t pos = 0; pos < m_events.size();)
+  {
+    const unsigned char opcode = m_events[pos];
+    PayloadID_t id = 0;
+    if (hasPayload(opcode))
+      id = readPayload(&m_events[pos + 1]);
+    pos += getEventSize(opcode);
+
+    switch (opcode)
+    {
+    case OP_CLOSE_COMMENT :
+      iface->closeComment();
+      break;
+    case OP_CLOSE_ENDNOTE :
+      iface->closeEndnote();
+      break;
+    case OP_CLOSE_FOOTER :
+      iface->closeFooter();
+      break;
+    case OP_CLOSE_FOOTNOTE :
+      iface->closeFootnote();
+      break;
+    case OP_CLOSE_FRAME :
+      iface->closeFrame();
+      break;
+    case OP_CLOSE_GROUP :
+      iface->closeGroup();
+      break;
+    case OP_CLOSE_HEADER :
+      iface->closeHeader();
+      break;
+    case OP_CLOSE_LINK :
+      iface->closeLink();
+      break;
+    case OP_CLOSE_LIST_ELEMENT :
+      iface->closeListElement();
+      break;
+    case OP_CLOSE_ORDERED_LIST_LEVEL :
+      iface->closeOrderedListLevel();
+      break;
+    case OP_CLOSE_PARAGRAPH :
+      iface->closeParagraph();
+      break;
+    case OP_CLOSE_SECTION :
+      iface->closeSection();
+      break;
+    case OP_CLOSE_SPAN :
+      iface->closeSpan();
+      break;
+    case OP_CLOSE_TABLE :
+      iface->closeTable();
+      break;
+    case OP_CLOSE_TABLE_CELL :
+      iface->closeTableCell();
+      break;
+    case OP_CLOSE_TABLE_ROW :
+      iface->closeTableRow();
+      break;
+    case OP_CLOSE_UNORDERED_LIST_LEVEL :
+      iface->closeUnorderedListLevel();
+      break;
+    case OP_END_LAYER :
+      iface->endLayer();
+      break;
+    case OP_END_NOTES :
+      iface->endNotes();
+      break;
+    case OP_END_TEXT_OBJECT :
+      iface->endTextObject();
+      break;
+    case OP_INSERT_LINE_BREAK :
+      iface->insertLineBreak();
+      break;
+    case OP_INSERT_SPACE :
+      iface->insertSpace();
+      break;
+    case OP_INSERT_TAB :
+      iface->insertTab();
+      break;
+    case OP_DEFINE_SHEET_NUMBERING_STYLE :
+      iface->defineSheetNumberingStyle(m_storage->getPropList(id));
+      break;
+    case OP_DRAW_GRAPHIC_OBJECT :
+      iface->drawGraphicObject(m_storage->getPropList(id));
+      break;
+    case OP_DRAW_PATH :
+      iface->drawPath(m_storage->getPropList(id));
+      break;
+    case OP_DRAW_POLYLINE :
+      iface->drawPolyline(m_storage->getPropList(id));
+      break;
+    case OP_INSERT_BINARY_OBJECT :
+      iface->insertBinaryObject(m_storage->getPropList(id));
+      break;
+    case OP_INSERT_COVERED_TABLE_CELL :
+      iface->insertCoveredTableCell(m_storage->getPropList(id));
+      break;
+    case OP_INSERT_FIELD :
+      iface->insertField(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_COMMENT :
+      iface->openComment(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_ENDNOTE :
+      iface->openEndnote(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_FOOTER :
+      iface->openFooter(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_FOOTNOTE :
+      iface->openFootnote(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_FRAME :
+      iface->openFrame(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_GROUP :
+      iface->openGroup(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_HEADER :
+      iface->openHeader(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_LINK :
+      iface->openLink(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_LIST_ELEMENT :
+      iface->openListElement(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_ORDERED_LIST_LEVEL :
+      iface->openOrderedListLevel(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_PARAGRAPH :
+      iface->openParagraph(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_SECTION :
+      iface->openSection(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_SPAN :
+      iface->openSpan(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_TABLE :
+      iface->openTable(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_TABLE_CELL :
+      iface->openTableCell(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_TABLE_ROW :
+      iface->openTableRow(m_storage->getPropList(id));
+      break;
+    case OP_OPEN_UNORDERED_LIST_LEVEL :
+      iface->openUnorderedListLevel(m_storage->getPropList(id));
+      break;
+    case OP_SET_STYLE :
+      iface->setStyle(m_storage->getPropList(id));
+      break;
+    case OP_START_LAYER :
+      iface->startLayer(m_storage->getPropList(id));
+      break;
+    case OP_START_NOTES :
+      iface->startNotes(m_storage->getPropList(id));
+      break;
+    case OP_START_TEXT_OBJECT :
+      iface->startTextObject(m_storage->getPropList(id));
+      break;
+    case OP_INSERT_TEXT :
+      iface->insertText(m_storage->getText(id));
+      break;
+    case OP_OPEN_FORMULA_CELL :
+    {
+      const FormulaCell &cell = m_storage->getFormulaCell(id);
+      librevenge::RVNGPropertyList cellProps(m_storage->getPropList(cell.m_propList));
+      librevenge::RVNGPropertyListVector propsVector;
+      cell.m_formula.write(cell.m_formulaHC, propsVector, cell.m_tableNameMap);
+      cellProps.insert("librevenge:formula", propsVector);
+      iface->openTableCell(cellProps);
+      break;
+    }
+    default :
+      ETONYEK_DEBUG_MSG(("IWORKOutputElements::write: unknown opcode %d\n", int(opcode)));
+      assert(false);
+      return;
+    }
+  }
 }
 
 void IWORKOutputElements::clear()
 {
-  m_elements.clear();
+  if (m_storage)
+  {
+    for (std::size_t pos = 0; pos < m_events.size(); pos += getEventSize(m_events[pos]))
+    {
+      if (hasPayload(m_events[pos]))
+        m_storage->unrefPayload(m_events[pos], readPayload(&m_events[pos + 1]));
+    }
+  }
+  m_events.clear();
+  m_storage.reset();
 }
 
 bool IWORKOutputElements::empty() const
 {
-  return m_elements.empty();
+  return m_events.empty();
 }
 
 void IWORKOutputElements::addCloseComment()
 {
-  m_elements.push_back(make_shared<CloseCommentElement>());
+  addEvent(OP_CLOSE_COMMENT);
 }
 
 void IWORKOutputElements::addCloseEndnote()
 {
-  m_elements.push_back(make_shared<CloseEndnoteElement>());
+  addEvent(OP_CLOSE_ENDNOTE);
 }
 
 void IWORKOutputElements::addCloseFooter()
 {
-  m_elements.push_back(make_shared<CloseFooterElement>());
+  addEvent(OP_CLOSE_FOOTER);
 }
 
 void IWORKOutputElements::addCloseFootnote()
 {
-  m_elements.push_back(make_shared<CloseFootnoteElement>());
+  addEvent(OP_CLOSE_FOOTNOTE);
 }
 
 void IWORKOutputElements::addCloseFrame()
 {
-  m_elements.push_back(make_shared<CloseFrameElement>());
+  addEvent(OP_CLOSE_FRAME);
 }
 
 void IWORKOutputElements::addCloseGroup()
 {
-  m_elements.push_back(make_shared<CloseGroupElement>());
+  addEvent(OP_CLOSE_GROUP);
 }
 
 void IWORKOutputElements::addCloseHeader()
 {
-  m_elements.push_back(make_shared<CloseHeaderElement>());
+  addEvent(OP_CLOSE_HEADER);
 }
 
 void IWORKOutputElements::addCloseLink()
 {
-  m_elements.push_back(make_shared<CloseLinkElement>());
+  addEvent(OP_CLOSE_LINK);
 }
 
 void IWORKOutputElements::addCloseListElement()
 {
-  m_elements.push_back(make_shared<CloseListElementElement>());
+  addEvent(OP_CLOSE_LIST_ELEMENT);
 }
 
 void IWORKOutputElements::addCloseOrderedListLevel()
 {
-  m_elements.push_back(make_shared<CloseOrderedListLevelElement>());
+  addEvent(OP_CLOSE_ORDERED_LIST_LEVEL);
 }
 
 void IWORKOutputElements::addCloseParagraph()
 {
-  m_elements.push_back(make_shared<CloseParagraphElement>());
+  addEvent(OP_CLOSE_PARAGRAPH);
 }
 
 void IWORKOutputElements::addCloseSection()
 {
-  m_elements.push_back(make_shared<CloseSectionElement>());
+  addEvent(OP_CLOSE_SECTION);
 }
 
 void IWORKOutputElements::addCloseSpan()
 {
-  m_elements.push_back(make_shared<CloseSpanElement>());
+  addEvent(OP_CLOSE_SPAN);
 }
 
 void IWORKOutputElements::addCloseTable()
 {
-  m_elements.push_back(make_shared<CloseTableElement>());
+  addEvent(OP_CLOSE_TABLE);
 }
 
 void IWORKOutputElements::addCloseTableCell()
 {
-  m_elements.push_back(make_shared<CloseTableCellElement>());
+  addEvent(OP_CLOSE_TABLE_CELL);
 }
 
 void IWORKOutputElements::addCloseTableRow()
 {
-  m_elements.push_back(make_shared<CloseTableRowElement>());
+  addEvent(OP_CLOSE_TABLE_ROW);
 }
 
 void IWORKOutputElements::addCloseUnorderedListLevel()
 {
-  m_elements.push_back(make_shared<CloseUnorderedListLevelElement>());
+  addEvent(OP_CLOSE_UNORDERED_LIST_LEVEL);
 }
 
 void IWORKOutputElements::addDefineSheetNumberingStyle(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<DefineSheetNumberingStyleElement>(propList));
+  addEvent(OP_DEFINE_SHEET_NUMBERING_STYLE, getStorage().addPropList(OP_DEFINE_SHEET_NUMBERING_STYLE, propList));
 }
 
 void IWORKOutputElements::addDrawGraphicObject(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<DrawGraphicObjectElement>(propList));
+  addEvent(OP_DRAW_GRAPHIC_OBJECT, getStorage().addPropList(OP_DRAW_GRAPHIC_OBJECT, propList));
 }
 
 void IWORKOutputElements::addDrawPath(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<DrawPathElement>(propList));
+  addEvent(OP_DRAW_PATH, getStorage().addPropList(OP_DRAW_PATH, propList));
 }
 
 void IWORKOutputElements::addDrawPolyline(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<DrawPolylineElement>(propList));
+  addEvent(OP_DRAW_POLYLINE, getStorage().addPropList(OP_DRAW_POLYLINE, propList));
 }
 
 void IWORKOutputElements::addEndLayer()
 {
-  m_elements.push_back(make_shared<EndLayerElement>());
+  addEvent(OP_END_LAYER);
 }
 
 void IWORKOutputElements::addEndNotes()
 {
-  m_elements.push_back(make_shared<EndNotesElement>());
+  addEvent(OP_END_NOTES);
 }
 
 void IWORKOutputElements::addEndTextObject()
 {
-  m_elements.push_back(make_shared<EndTextObjectElement>());
+  addEvent(OP_END_TEXT_OBJECT);
 }
 
 void IWORKOutputElements::addInsertBinaryObject(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<InsertBinaryObjectElement>(propList));
+  addEvent(OP_INSERT_BINARY_OBJECT, getStorage().addPropList(OP_INSERT_BINARY_OBJECT, propList));
 }
 
 void IWORKOutputElements::addInsertCoveredTableCell(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<InsertCoveredTableCellElement>(propList));
+  addEvent(OP_INSERT_COVERED_TABLE_CELL, getStorage().addPropList(OP_INSERT_COVERED_TABLE_CELL, propList));
 }
 
 void IWORKOutputElements::addInsertField(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<InsertFieldElement>(propList));
+  addEvent(OP_INSERT_FIELD, getStorage().addPropList(OP_INSERT_FIELD, propList));
 }
 
 void IWORKOutputElements::addInsertLineBreak()
 {
-  m_elements.push_back(make_shared<InsertLineBreakElement>());
+  addEvent(OP_INSERT_LINE_BREAK);
 }
 
 void IWORKOutputElements::addInsertSpace()
 {
-  m_elements.push_back(make_shared<InsertSpaceElement>());
+  addEvent(OP_INSERT_SPACE);
 }
 
 void IWORKOutputElements::addInsertTab()
 {
-  m_elements.push_back(make_shared<InsertTabElement>());
+  addEvent(OP_INSERT_TAB);
 }
 
 void IWORKOutputElements::addInsertText(const librevenge::RVNGString &text)
 {
-  m_elements.push_back(make_shared<InsertTextElement>(text));
+  addEvent(OP_INSERT_TEXT, getStorage().addText(text));
 }
 
 void IWORKOutputElements::addOpenComment(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenCommentElement>(propList));
+  addEvent(OP_OPEN_COMMENT, getStorage().addPropList(OP_OPEN_COMMENT, propList));
 }
 
 void IWORKOutputElements::addOpenEndnote(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenEndnoteElement>(propList));
+  addEvent(OP_OPEN_ENDNOTE, getStorage().addPropList(OP_OPEN_ENDNOTE, propList));
 }
 
-void IWORKOutputElements::addOpenFormulaCell(const librevenge::RVNGPropertyList &propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap)
+void IWORKOutputElements::addOpenFooter(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(std::shared_ptr<OpenFormulaCellElement>(new OpenFormulaCellElement(propList, formula, formulaHC, tableNameMap)));
+  addEvent(OP_OPEN_FOOTER, getStorage().addPropList(OP_OPEN_FOOTER, propList));
 }
 
-void IWORKOutputElements::addOpenFooter(const librevenge::RVNGPropertyList &propList)
+void IWORKOutputElements::addOpenFootnote(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenFooterElement>(propList));
+  addEvent(OP_OPEN_FOOTNOTE, getStorage().addPropList(OP_OPEN_FOOTNOTE, propList));
 }
 
-void IWORKOutputElements::addOpenFootnote(const librevenge::RVNGPropertyList &propList)
+void IWORKOutputElements::addOpenFormulaCell(const librevenge::RVNGPropertyList &propList, const IWORKFormula &formula, const boost::optional<unsigned> &formulaHC, const IWORKTableNameMapPtr_t &tableNameMap)
 {
-  m_elements.push_back(make_shared<OpenFootnoteElement>(propList));
+  addEvent(OP_OPEN_FORMULA_CELL, getStorage().addFormulaCell(propList, formula, formulaHC, tableNameMap));
 }
 
 void IWORKOutputElements::addOpenFrame(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenFrameElement>(propList));
+  addEvent(OP_OPEN_FRAME, getStorage().addPropList(OP_OPEN_FRAME, propList));
 }
 
 void IWORKOutputElements::addOpenGroup(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenGroupElement>(propList));
+  addEvent(OP_OPEN_GROUP, getStorage().addPropList(OP_OPEN_GROUP, propList));
 }
 
 void IWORKOutputElements::addOpenHeader(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenHeaderElement>(propList));
+  addEvent(OP_OPEN_HEADER, getStorage().addPropList(OP_OPEN_HEADER, propList));
 }
 
 void IWORKOutputElements::addOpenLink(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenLinkElement>(propList));
+  addEvent(OP_OPEN_LINK, getStorage().addPropList(OP_OPEN_LINK, propList));
 }
 
 void IWORKOutputElements::addOpenListElement(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenListElementElement>(propList));
+  addEvent(OP_OPEN_LIST_ELEMENT, getStorage().addPropList(OP_OPEN_LIST_ELEMENT, propList));
 }
 
 void IWORKOutputElements::addOpenOrderedListLevel(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenOrderedListLevelElement>(propList));
+  addEvent(OP_OPEN_ORDERED_LIST_LEVEL, getStorage().addPropList(OP_OPEN_ORDERED_LIST_LEVEL, propList));
 }
 
 void IWORKOutputElements::addOpenParagraph(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenParagraphElement>(propList));
+  addEvent(OP_OPEN_PARAGRAPH, getStorage().addPropList(OP_OPEN_PARAGRAPH, propList));
 }
 
 void IWORKOutputElements::addOpenSection(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenSectionElement>(propList));
+  addEvent(OP_OPEN_SECTION, getStorage().addPropList(OP_OPEN_SECTION, propList));
 }
 
 void IWORKOutputElements::addOpenSpan(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenSpanElement>(propList));
+  addEvent(OP_OPEN_SPAN, getStorage().addPropList(OP_OPEN_SPAN, propList));
 }
 
 void IWORKOutputElements::addOpenTable(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenTableElement>(propList));
+  addEvent(OP_OPEN_TABLE, getStorage().addPropList(OP_OPEN_TABLE, propList));
 }
 
 void IWORKOutputElements::addOpenTableCell(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenTableCellElement>(propList));
+  addEvent(OP_OPEN_TABLE_CELL, getStorage().addPropList(OP_OPEN_TABLE_CELL, propList));
 }
 
 void IWORKOutputElements::addOpenTableRow(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenTableRowElement>(propList));
+  addEvent(OP_OPEN_TABLE_ROW, getStorage().addPropList(OP_OPEN_TABLE_ROW, propList));
 }
 
 void IWORKOutputElements::addOpenUnorderedListLevel(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<OpenUnorderedListLevelElement>(propList));
+  addEvent(OP_OPEN_UNORDERED_LIST_LEVEL, getStorage().addPropList(OP_OPEN_UNORDERED_LIST_LEVEL, propList));
 }
 
 void IWORKOutputElements::addSetStyle(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<SetStyleElement>(propList));
+  addEvent(OP_SET_STYLE, getStorage().addPropList(OP_SET_STYLE, propList));
 }
 
 void IWORKOutputElements::addStartLayer(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<StartLayerElement>(propList));
+  addEvent(OP_START_LAYER, getStorage().addPropList(OP_START_LAYER, propList));
 }
 
 void IWORKOutputElements::addStartNotes(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<StartNotesElement>(propList));
+  addEvent(OP_START_NOTES, getStorage().addPropList(OP_START_NOTES, propList));
 }
 
 void IWORKOutputElements::addStartTextObject(const librevenge::RVNGPropertyList &propList)
 {
-  m_elements.push_back(make_shared<StartTextObjectElement>(propList));
+  addEvent(OP_START_TEXT_OBJECT, getStorage().addPropList(OP_START_TEXT_OBJECT, propList));
+}
+
+IWORKOutputElements::Storage &IWORKOutputElements::getStorage()
+{
+  if (!m_storage)
+    m_storage = defaultStorage ? defaultStorage : createStorage();
+  return *m_storage;
+}
+
+void IWORKOutputElements::addEvent(const unsigned char opcode)
+{
+  assert(!hasPayload(opcode));
+  m_events.push_back(opcode);
+}
+
+void IWORKOutputElements::addEvent(const unsigned char opcode, const unsigned id)
+{
+  assert(hasPayload(opcode));
+  m_events.push_back(opcode);
+  writePayload(m_events, id);
+}
+
+void IWORKOutputElements::refEvents(const std::size_t begin, const std::size_t end)
+{
+  for (std::size_t pos = begin; pos < end; pos += getEventSize(m_events[pos]))
+  {
+    if (hasPayload(m_events[pos]))
+      m_storage->refPayload(m_events[pos], readPayload(&m_events[pos + 1]));
+  }
+}
+
+void IWORKOutputElements::copyEvents(const IWORKOutputElements &elements, std::vector<unsigned char> &events)
+{
+  Storage &storage = getStorage();
+  events.reserve(events.size() + elements.m_events.size());
+  for (std::size_t pos = 0; pos < elements.m_events.size();)
+  {
+    const unsigned char opcode = elements.m_events[pos];
+    events.push_back(opcode);
+    if (hasPayload(opcode))
+      writePayload(events, storage.copyPayload(opcode, readPayload(&elements.m_events[pos + 1]), *elements.m_storage));
+    pos += getEventSize(opcode);
+  }
 }
 
 }
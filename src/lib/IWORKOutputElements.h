@@ -10,9 +10,8 @@
 #ifndef IWORKOUTPUTELEMENTS_H_INCLUDED
 #define IWORKOUTPUTELEMENTS_H_INCLUDED
 
-#include <deque>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -26,15 +25,64 @@ namespace libetonyek
 
 class IWORKDocumentInterface;
 class IWORKFormula;
-class IWORKOutputElement;
-
 
+/** A recorded sequence of document interface calls.
+  *
+  * The calls are kept as a compact byte stream of opcodes and payload
+  * IDs. The payloads (property lists, texts, formulas) live in a
+  * shared Storage, where equal property lists are stored just once.
+  * A payload is freed when no recording refers to it anymore.
+  */
 class IWORKOutputElements
 {
-  typedef std::deque<std::shared_ptr<IWORKOutputElement> > ElementList_t;
+public:
+  class Storage;
+  typedef std::shared_ptr<Storage> StoragePtr_t;
+
+public:
+  /** Create a new payload storage.
+    */
+  static StoragePtr_t createStorage();
+
+  /** Set the storage used on this thread by elements that start
+    * recording afterwards.
+    *
+    * Elements sharing a storage can be appended to each other without
+    * copying the payloads. An element lets go of its storage and of
+    * its payloads when it is cleared or destroyed.
+    *
+    * @arg[in] storage the new default storage, possibly empty
+    * @return the previous default storage
+    */
+  static StoragePtr_t setDefaultStorage(const StoragePtr_t &storage);
+
+  /** Install a default storage for the lifetime of the object.
+    *
+    * The previous default storage is restored on destruction, also
+    * when leaving the scope by an exception.
+    */
+  class DefaultStorageScope
+  {
+    // disable copying
+    DefaultStorageScope(const DefaultStorageScope &);
+    DefaultStorageScope &operator=(const DefaultStorageScope &);
+
+  public:
+    explicit DefaultStorageScope(const StoragePtr_t &storage);
+    ~DefaultStorageScope();
+
+  private:
+    const StoragePtr_t m_previousStorage;
+  };
 
 public:
   IWORKOutputElements();
+  IWORKOutputElements(const IWORKOutputElements &other);
+  IWORKOutputElements(IWORKOutputElements &&other);
+  ~IWORKOutputElements();
+
+  IWORKOutputElements &operator=(const IWORKOutputElements &other);
+  IWORKOutputElements &operator=(IWORKOutputElements &&other);
 
   void append(const IWORKOutputElements &elements);
   //! add shapes data in spreadsheet. Assume that the current elements are OpenSheet(...), ...
@@ -98,7 +146,15 @@ public:
   void addStartTextObject(const librevenge::RVNGPropertyList &propList);
 
 private:
-  ElementList_t m_elements;
+  Storage &getStorage();
+  void addEvent(unsigned char opcode);
+  void addEvent(unsigned char opcode, unsigned id);
+  void refEvents(std::size_t begin, std::size_t end);
+  void copyEvents(const IWORKOutputElements &elements, std::vector<unsigned char> &events);
+
+private:
+  std::vector<unsigned char> m_events;
+  StoragePtr_t m_storage;
 };
 
 }
@@ -15,6 +15,7 @@ namespace libetonyek
 IWORKOutputManager::IWORKOutputManager()
   : m_active()
   , m_saved()
+  , m_previousStorage(IWORKOutputElements::setDefaultStorage(IWORKOutputElements::createStorage()))
 {
   push();
 }
@@ -23,6 +24,7 @@ IWORKOutputManager::~IWORKOutputManager()
 {
   pop();
   assert(m_active.empty());
+  IWORKOutputElements::setDefaultStorage(m_previousStorage);
 }
 
 void IWORKOutputManager::push()
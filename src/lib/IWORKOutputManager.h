@@ -76,6 +76,7 @@ public:
 private:
   OutputStack_t m_active;
   OutputList_t m_saved;
+  IWORKOutputElements::StoragePtr_t m_previousStorage;
 };
 
 }
@@ -10,8 +10,15 @@
 #include "IWORKParser.h"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include <libxml/parser.h>
 #include <libxml/xmlreader.h>
 
 #include <stack>
@@ -30,18 +37,345 @@ namespace libetonyek
 namespace
 {
 
-void processAttribute(xmlTextReaderPtr reader, IWORKXMLContextPtr_t context, const IWORKTokenizer &tokenizer)
+/** A cache of IDs of qualified names.
+  *
+  * libxml2 interns names and namespace URIs of elements and attributes
+  * in the reader's dictionary, so the same pair of pointers always
+  * denotes the same qualified name for the reader's lifetime. That
+  * saves the string lookups in the tokenizer for all but the first
+  * occurrence of a name.
+  *
+  * The cache is direct-mapped: an entry is just replaced on collision.
+  */
+class TokenCache
 {
-  const int id = tokenizer.getQualifiedId(char_cast(xmlTextReaderConstLocalName(reader)), char_cast(xmlTextReaderConstNamespaceUri(reader)));
+  // disable copying
+  TokenCache(const TokenCache &);
+  TokenCache &operator=(const TokenCache &);
+
+  struct Entry
+  {
+    Entry()
+      : m_name(nullptr)
+      , m_ns(nullptr)
+      , m_id(0)
+    {
+    }
+
+    const void *m_name;
+    const void *m_ns;
+    int m_id;
+  };
+
+public:
+  explicit TokenCache(const IWORKTokenizer &tokenizer);
+
+  /** Get ID of an interned qualified name.
+    *
+    * @arg[in] name the local name, from the reader's dictionary
+    * @arg[in] ns the namespace URI, from the reader's dictionary or a
+    *   static string; it may be null
+    * @return the ID of the qualified name
+    */
+  int getQualifiedId(const char *name, const char *ns);
+
+private:
+  const IWORKTokenizer &m_tokenizer;
+  std::vector<Entry> m_entries;
+};
+
+const std::size_t TOKEN_CACHE_SIZE = 1024; // must be a power of 2
+
+TokenCache::TokenCache(const IWORKTokenizer &tokenizer)
+  : m_tokenizer(tokenizer)
+  , m_entries(TOKEN_CACHE_SIZE)
+{
+}
+
+int TokenCache::getQualifiedId(const char *const name, const char *const ns)
+{
+  if (!name)
+    return m_tokenizer.getQualifiedId(name, ns);
+
+  uintptr_t hash = reinterpret_cast<uintptr_t>(name) ^ (reinterpret_cast<uintptr_t>(ns) * 31);
+  hash ^= hash >> 11;
+  Entry &entry = m_entries[hash & (TOKEN_CACHE_SIZE - 1)];
+  if ((entry.m_name != name) || (entry.m_ns != ns))
+  {
+    entry.m_name = name;
+    entry.m_ns = ns;
+    entry.m_id = m_tokenizer.getQualifiedId(name, ns);
+  }
+  return entry.m_id;
+}
+
+void processAttribute(xmlTextReaderPtr reader, IWORKXMLContextPtr_t context, const IWORKTokenizer &tokenizer, TokenCache &tokenCache)
+{
+  const char *const name = char_cast(xmlTextReaderConstLocalName(reader));
+  const char *const ns = char_cast(xmlTextReaderConstNamespaceUri(reader));
+  // the prefix of a namespace declaration is not interned
+  const int id = (1 == xmlTextReaderIsNamespaceDecl(reader)) ? tokenizer.getQualifiedId(name, ns) : tokenCache.getQualifiedId(name, ns);
   const char *value = char_cast(xmlTextReaderConstValue(reader));
   context->attribute(id, value);
 }
 
+const char *const KEYNOTE1_NS = "http://developer.apple.com/schemas/APXL";
+const char *const XMLNS_NS = "http://www.w3.org/2000/xmlns/";
+
+/** State of parsing with the SAX2 interface.
+  *
+  * The callbacks feed the same context stack as the reader loop in
+  * IWORKParser::parse(), and do it the same way. That includes the
+  * quirks of xmlTextReader: namespace declarations are passed as
+  * attributes before the other attributes, text that is just
+  * whitespace is dropped, and adjacent character data are passed as
+  * one text.
+  */
+struct SAXState
+{
+private:
+  // disable copying
+  SAXState(const SAXState &);
+  SAXState &operator=(const SAXState &);
+
+public:
+  SAXState(TokenCache &tokenCache, const std::function<IWORKXMLContextPtr_t()> &createDiscardContext);
+
+  xmlParserCtxtPtr m_parser;
+  TokenCache &m_tokenCache;
+  const std::function<IWORKXMLContextPtr_t()> m_createDiscardContext;
+  stack<IWORKXMLContextPtr_t> m_contextStack;
+  bool m_firstElement;
+  const char *m_defaultNS;
+  std::string m_text;
+  bool m_inText;
+  bool m_inCDATA;
+  unsigned m_skipDepth;
+  std::string m_value;
+  std::exception_ptr m_exception;
+};
+
+SAXState::SAXState(TokenCache &tokenCache, const std::function<IWORKXMLContextPtr_t()> &createDiscardContext)
+  : m_parser(nullptr)
+  , m_tokenCache(tokenCache)
+  , m_createDiscardContext(createDiscardContext)
+  , m_contextStack()
+  , m_firstElement(true)
+  , m_defaultNS(nullptr)
+  , m_text()
+  , m_inText(false)
+  , m_inCDATA(false)
+  , m_skipDepth(0)
+  , m_value()
+  , m_exception()
+{
+}
+
+bool isBlank(const std::string &text)
+{
+  for (const char c : text)
+  {
+    if ((c != ' ') && (c != '\t') && (c != '\n') && (c != '\r'))
+      return false;
+  }
+  return true;
+}
+
+void flushText(SAXState &state)
+{
+  if (state.m_inText)
+  {
+    // xmlTextReader reports such text as whitespace, not text
+    if (!isBlank(state.m_text))
+      state.m_contextStack.top()->text(state.m_text.c_str());
+  }
+  else if (state.m_inCDATA)
+  {
+    state.m_contextStack.top()->CDATA(state.m_text.c_str());
+  }
+  state.m_text.clear();
+  state.m_inText = false;
+  state.m_inCDATA = false;
+}
+
+/** Get an attribute value, as xmlTextReader would report it.
+  *
+  * Without entity substitution, libxml2 keeps ampersands escaped as
+  * "&#38;" in attribute values passed to SAX2.
+  */
+const char *getAttributeValue(SAXState &state, const xmlChar *const begin, const xmlChar *const end)
+{
+  state.m_value.assign(char_cast(begin), std::size_t(end - begin));
+  for (std::size_t pos = state.m_value.find("&#38;"); pos != std::string::npos; pos = state.m_value.find("&#38;", pos + 1))
+    state.m_value.replace(pos, 5, 1, '&');
+  return state.m_value.c_str();
+}
+
+void handleException(SAXState &state)
+{
+  state.m_exception = std::current_exception();
+  xmlStopParser(state.m_parser);
+}
+
+extern "C"
+{
+
+static void saxStartElement(void *const ctx, const xmlChar *const localName, const xmlChar *, const xmlChar *const uri,
+                            const int namespaceCount, const xmlChar **const namespaces,
+                            const int attributeCount, int, const xmlChar **const attributes)
+{
+  SAXState &state = *static_cast<SAXState *>(ctx);
+  if (state.m_exception)
+    return;
+  if (state.m_skipDepth > 0)
+  {
+    ++state.m_skipDepth;
+    return;
+  }
+  try
+  {
+    flushText(state);
+
+    if (state.m_firstElement)
+    {
+      // check for keynote 1 file with doctype node and not a namespace in first node
+      state.m_firstElement = false;
+      if (!uri)
+        state.m_defaultNS = KEYNOTE1_NS;
+    }
+    const int id = state.m_tokenCache.getQualifiedId(char_cast(localName), state.m_defaultNS ? state.m_defaultNS : char_cast(uri));
+
+    IWORKXMLContextPtr_t newContext = state.m_contextStack.top()->element(id);
+
+    if (!newContext)
+      newContext = state.m_createDiscardContext();
+
+    newContext->startOfElement();
+    for (int i = 0; i < namespaceCount; ++i)
+    {
+      const char *const prefix = char_cast(namespaces[2 * i]);
+      newContext->attribute(state.m_tokenCache.getQualifiedId(prefix ? prefix : "xmlns", XMLNS_NS), char_cast(namespaces[2 * i + 1]));
+    }
+    for (int i = 0; i < attributeCount; ++i)
+    {
+      const xmlChar *const *const attribute = attributes + 5 * i;
+      const int attrId = state.m_tokenCache.getQualifiedId(char_cast(attribute[0]), char_cast(attribute[2]));
+      newContext->attribute(attrId, getAttributeValue(state, attribute[3], attribute[4]));
+    }
+
+    state.m_contextStack.push(newContext);
+    if (newContext->skipContent())
+      state.m_skipDepth = 1;
+  }
+  catch (...)
+  {
+    handleException(state);
+  }
+}
+
+static void saxEndElement(void *const ctx, const xmlChar *, const xmlChar *, const xmlChar *)
+{
+  SAXState &state = *static_cast<SAXState *>(ctx);
+  if (state.m_exception)
+    return;
+  if (state.m_skipDepth > 0)
+  {
+    // the end of the skipped element itself is processed as usual
+    --state.m_skipDepth;
+    if (state.m_skipDepth > 0)
+      return;
+  }
+  try
+  {
+    flushText(state);
+    state.m_contextStack.top()->endOfElement();
+    state.m_contextStack.pop();
+  }
+  catch (...)
+  {
+    handleException(state);
+  }
+}
+
+static void saxCharacters(void *const ctx, const xmlChar *const text, const int len)
+{
+  SAXState &state = *static_cast<SAXState *>(ctx);
+  if (state.m_exception || (state.m_skipDepth > 0))
+    return;
+  try
+  {
+    if (!state.m_inText)
+    {
+      flushText(state);
+      state.m_inText = true;
+    }
+    state.m_text.append(char_cast(text), std::size_t(len));
+  }
+  catch (...)
+  {
+    handleException(state);
+  }
+}
+
+static void saxCDATA(void *const ctx, const xmlChar *const text, const int len)
+{
+  SAXState &state = *static_cast<SAXState *>(ctx);
+  if (state.m_exception || (state.m_skipDepth > 0))
+    return;
+  try
+  {
+    // a long CDATA section can come in several blocks
+    if (!state.m_inCDATA)
+    {
+      flushText(state);
+      state.m_inCDATA = true;
+    }
+    state.m_text.append(char_cast(text), std::size_t(len));
+  }
+  catch (...)
+  {
+    handleException(state);
+  }
+}
+
+/// End the current text at a node that is not passed on: a comment, a processing instruction or an entity reference.
+static void saxBoundary(SAXState &state)
+{
+  if (state.m_exception || (state.m_skipDepth > 0))
+    return;
+  try
+  {
+    flushText(state);
+  }
+  catch (...)
+  {
+    handleException(state);
+  }
+}
+
+static void saxComment(void *const ctx, const xmlChar *)
+{
+  saxBoundary(*static_cast<SAXState *>(ctx));
+}
+
+static void saxProcessingInstruction(void *const ctx, const xmlChar *, const xmlChar *)
+{
+  saxBoundary(*static_cast<SAXState *>(ctx));
+}
+
+static void saxReference(void *const ctx, const xmlChar *)
+{
+  saxBoundary(*static_cast<SAXState *>(ctx));
+}
+
+}
+
 }
 
 IWORKParser::IWORKParser(const RVNGInputStreamPtr_t &input, const RVNGInputStreamPtr_t &package)
   : m_input(input)
   , m_package(package)
+  , m_useSAX(false)
 {
 }
 
@@ -50,6 +384,28 @@ IWORKParser::~IWORKParser()
 }
 
 bool IWORKParser::parse()
+{
+#ifdef DEBUG
+  const IWORKXMLContextAllocationStats before = getContextAllocationStats();
+#endif
+
+  const bool result = m_useSAX ? parseWithSAX() : parseWithReader();
+
+#ifdef DEBUG
+  const IWORKXMLContextAllocationStats after = getContextAllocationStats();
+  ETONYEK_DEBUG_MSG(("IWORKParser::parse: %lu pooled context allocations, %lu of them from the heap\n",
+                     after.m_allocations - before.m_allocations, after.m_heapAllocations - before.m_heapAllocations));
+#endif
+
+  return result;
+}
+
+void IWORKParser::setUseSAX(const bool useSAX)
+{
+  m_useSAX = useSAX;
+}
+
+bool IWORKParser::parseWithReader()
 {
   auto sharedReader = xmlReaderForStream(m_input);
   if (!sharedReader)
@@ -59,6 +415,7 @@ bool IWORKParser::parse()
   assert(reader);
 
   const IWORKTokenizer &tokenizer = getTokenizer();
+  TokenCache tokenCache(tokenizer);
   stack<IWORKXMLContextPtr_t> contextStack;
 
   int ret = xmlTextReaderRead(reader);
@@ -68,6 +425,7 @@ bool IWORKParser::parse()
   char const *defaultNS=nullptr;
   while ((1 == ret))
   {
+    bool skipSubtree = false;
     switch (xmlTextReaderNodeType(reader))
     {
     case XML_READER_TYPE_ELEMENT:
@@ -78,10 +436,10 @@ bool IWORKParser::parse()
         keynoteDocTypeChecked=true;
         if (xmlTextReaderNodeType(reader)==XML_READER_TYPE_ELEMENT &&
             xmlTextReaderConstNamespaceUri(reader)==nullptr)
-          defaultNS="http://developer.apple.com/schemas/APXL";
+          defaultNS=KEYNOTE1_NS;
       }
-      const int id = tokenizer.getQualifiedId(char_cast(xmlTextReaderConstLocalName(reader)),
-                                              defaultNS ? defaultNS : char_cast(xmlTextReaderConstNamespaceUri(reader)));
+      const int id = tokenCache.getQualifiedId(char_cast(xmlTextReaderConstLocalName(reader)),
+                                               defaultNS ? defaultNS : char_cast(xmlTextReaderConstNamespaceUri(reader)));
 
       IWORKXMLContextPtr_t newContext = contextStack.top()->element(id);
 
@@ -96,15 +454,24 @@ bool IWORKParser::parse()
         ret = xmlTextReaderMoveToFirstAttribute(reader);
         while (1 == ret)
         {
-          processAttribute(reader, newContext, tokenizer);
+          processAttribute(reader, newContext, tokenizer, tokenCache);
           ret = xmlTextReaderMoveToNextAttribute(reader);
         }
       }
 
       if (isEmpty)
+      {
+        newContext->endOfElement();
+      }
+      else if (newContext->skipContent())
+      {
         newContext->endOfElement();
+        skipSubtree = true;
+      }
       else
+      {
         contextStack.push(newContext);
+      }
 
       break;
     }
@@ -122,16 +489,16 @@ bool IWORKParser::parse()
     }
     case XML_READER_TYPE_TEXT :
     {
-      xmlChar *const text = xmlTextReaderReadString(reader);
-      contextStack.top()->text(char_cast(text));
-      xmlFree(text);
+      // the same as xmlTextReaderReadString() for a text node, without a copy
+      contextStack.top()->text(char_cast(xmlTextReaderConstValue(reader)));
       break;
     }
     default:
       break;
     }
 
-    ret = xmlTextReaderRead(reader);
+    // xmlTextReaderNext() reads past the end of the current element without reporting its content
+    ret = skipSubtree ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
 
   }
 
@@ -145,6 +512,62 @@ bool IWORKParser::parse()
   return true;
 }
 
+bool IWORKParser::parseWithSAX()
+{
+  if (!m_input)
+    return false;
+
+  xmlSAXHandler handler;
+  std::memset(&handler, 0, sizeof(handler));
+  handler.initialized = XML_SAX2_MAGIC;
+  handler.startElementNs = saxStartElement;
+  handler.endElementNs = saxEndElement;
+  handler.characters = saxCharacters;
+  handler.ignorableWhitespace = saxCharacters;
+  handler.cdataBlock = saxCDATA;
+  handler.comment = saxComment;
+  handler.processingInstruction = saxProcessingInstruction;
+  handler.reference = saxReference;
+
+  TokenCache tokenCache(getTokenizer());
+  SAXState state(tokenCache, std::bind(&IWORKParser::createDiscardContext, this));
+  const std::unique_ptr<xmlParserCtxt, void (*)(xmlParserCtxtPtr)> parser(
+    xmlCreatePushParserCtxt(&handler, &state, nullptr, 0, ""),
+    xmlFreeParserCtxt
+  );
+  if (!parser)
+    return false;
+  xmlCtxtUseOptions(parser.get(), XML_PARSE_NONET | XML_PARSE_RECOVER);
+  state.m_parser = parser.get();
+
+  state.m_contextStack.push(createDocumentContext());
+
+  const unsigned long chunkSize = 0x10000;
+  while (!state.m_exception)
+  {
+    unsigned long bytesRead = 0;
+    const unsigned char *const bytes = m_input->read(chunkSize, bytesRead);
+    if (!bytes || (0 == bytesRead))
+      break;
+    xmlParseChunk(parser.get(), char_cast(bytes), int(bytesRead), 0);
+    if (XML_PARSER_EOF == parser->instate)
+      break;
+  }
+  if (!state.m_exception)
+    xmlParseChunk(parser.get(), nullptr, 0, 1);
+  if (state.m_exception)
+    std::rethrow_exception(state.m_exception);
+
+  flushText(state);
+  while (!state.m_contextStack.empty()) // finish parsing in case of broken XML
+  {
+    state.m_contextStack.top()->endOfElement();
+    state.m_contextStack.pop();
+  }
+
+  return true;
+}
+
 RVNGInputStreamPtr_t &IWORKParser::getInput()
 {
   return m_input;
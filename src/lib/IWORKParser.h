@@ -31,6 +31,16 @@ public:
   virtual ~IWORKParser() = 0;
   bool parse();
 
+  /** Select the XML parsing backend.
+    *
+    * The default is xmlTextReader. SAX2 is not enabled by any of the
+    * document parsers yet; the tests check that it produces the same
+    * result as the reader.
+    *
+    * @arg[in] useSAX use libxml2's SAX2 interface instead of xmlTextReader
+    */
+  void setUseSAX(bool useSAX);
+
   RVNGInputStreamPtr_t &getInput();
   RVNGInputStreamPtr_t getInput() const;
   RVNGInputStreamPtr_t &getPackage();
@@ -42,12 +52,16 @@ protected:
   void setInput(const RVNGInputStreamPtr_t &input);
 
 private:
+  bool parseWithReader();
+  bool parseWithSAX();
+
   virtual IWORKXMLContextPtr_t createDocumentContext() = 0;
   virtual IWORKXMLContextPtr_t createDiscardContext() = 0;
 
 private:
   RVNGInputStreamPtr_t m_input;
   RVNGInputStreamPtr_t m_package;
+  bool m_useSAX;
 };
 
 } // namespace libetonyek
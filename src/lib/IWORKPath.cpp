@@ -9,24 +9,17 @@
 
 #include "IWORKPath.h"
 
+#include <algorithm>
 #include <cassert>
-#include <deque>
 #include <sstream>
 #include <utility>
-
-#include <boost/fusion/include/adapt_struct.hpp>
-#include <boost/spirit/include/qi.hpp>
-#include <boost/variant.hpp>
+#include <vector>
 
 #include "libetonyek_utils.h"
+#include "libetonyek_xml.h"
 #include "IWORKTransformation.h"
 #include "IWORKTypes.h"
 
-namespace phoenix = boost::phoenix;
-
-using boost::apply_visitor;
-using boost::static_visitor;
-
 using librevenge::RVNGPropertyList;
 using librevenge::RVNGPropertyListVector;
 
@@ -35,401 +28,205 @@ using std::string;
 namespace libetonyek
 {
 
-struct MoveTo
-{
-  double m_x;
-  double m_y;
-};
-
-struct LineTo
-{
-  double m_x;
-  double m_y;
-};
-
-struct CCurveTo
-{
-  double m_x1;
-  double m_y1;
-  double m_x2;
-  double m_y2;
-  double m_x;
-  double m_y;
-};
-
-struct QCurveTo
-{
-  double m_x1;
-  double m_y1;
-  double m_x;
-  double m_y;
-};
-
-struct ClosePolygon
-{
-  char m_char;
-  //operator bool() const { return true; }
-};
-
-typedef boost::variant<MoveTo, LineTo, CCurveTo, QCurveTo, ClosePolygon> CurveElement_t;
-typedef std::deque<CurveElement_t> Curve_t;
-typedef std::deque<Curve_t> Path_t;
-
+/** The path is stored as flat arrays: the commands and the x and y
+  * coordinates of their points.
+  *
+  * The commands are M (move to), L (line to), C (cubic curve to),
+  * Q (quadratic curve to) and Z (close). Every curve starts with M.
+  * The points are stored in the order they appear in SVG; see
+  * getPointCount() for the number of points of each command. Keeping
+  * x and y apart lets transformations and bounding box computations
+  * run as simple loops over all the points.
+  */
 struct IWORKPath::Impl
 {
   Impl();
 
-  Path_t m_path;
+  std::size_t getPointCount() const;
+
+  std::vector<char> m_commands;
+  std::vector<double> m_xs;
+  std::vector<double> m_ys;
   bool m_closed;
 };
 
 IWORKPath::Impl::Impl()
-  : m_path()
+  : m_commands()
+  , m_xs()
+  , m_ys()
   , m_closed(false)
 {
 }
 
-}
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::MoveTo,
-  (double, m_x)
-  (double, m_y)
-)
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::LineTo,
-  (double, m_x)
-  (double, m_y)
-)
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::CCurveTo,
-  (double, m_x1)
-  (double, m_y1)
-  (double, m_x2)
-  (double, m_y2)
-  (double, m_x)
-  (double, m_y)
-)
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::QCurveTo,
-  (double, m_x1)
-  (double, m_y1)
-  (double, m_x)
-  (double, m_y)
-)
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::ClosePolygon,
-  (char, m_char)
-)
-
-BOOST_FUSION_ADAPT_STRUCT(
-  libetonyek::IWORKPath::Impl,
-  (libetonyek::Path_t, m_path)
-)
-
-namespace libetonyek
+std::size_t IWORKPath::Impl::getPointCount() const
 {
+  return m_xs.size();
+}
 
 namespace
 {
 
-namespace ascii = boost::spirit::ascii;
-namespace qi = boost::spirit::qi;
-
-#if defined _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4100) // unreferenced formal parameter in boost
-#endif
-
-template<typename Iterator>
-struct PathGrammar : public qi::grammar<Iterator, IWORKPath::Impl(), ascii::space_type>
+unsigned getPointCount(const char command)
 {
-  PathGrammar()
-    : PathGrammar::base_type(path, "path")
-    , path()
-    , curve()
-    , move()
-    , line()
-    , cCurve()
-    , qCurve()
-    , close('Z')
+  switch (command)
   {
-    using qi::attr;
-    using qi::as;
-    using qi::double_;
-    using qi::lit;
-    using qi::omit;
-
-    move %= 'M' >> double_ >> double_;
-
-    line %= 'L' >> double_ >> double_;
-
-    qCurve %= 'Q' >> double_ >> double_ >> double_ >> double_;
-
-    cCurve %= 'C' >> double_ >> double_ >> double_ >> double_ >> double_ >> double_;
-
-    curve %= as<Curve_t>()[move >> +(line | cCurve | qCurve) >> -close];
-    path %= as<Path_t>()[+curve >> *(omit[move]) ];
-
-    close.name("close");
-    move.name("move");
-    line.name("line");
-    cCurve.name("cCurve");
-    qCurve.name("qCurve");
-    curve.name("curve");
-    path.name("path");
+  case 'M' :
+  case 'L' :
+    return 1;
+  case 'C' :
+    return 3;
+  case 'Q' :
+    return 2;
+  default :
+    break;
   }
-
-  qi::rule<Iterator, IWORKPath::Impl(), ascii::space_type> path;
-  qi::rule<Iterator, Curve_t(), ascii::space_type> curve;
-  qi::rule<Iterator, MoveTo(), ascii::space_type> move;
-  qi::rule<Iterator, LineTo(), ascii::space_type> line;
-  qi::rule<Iterator, CCurveTo(), ascii::space_type> cCurve;
-  qi::rule<Iterator, QCurveTo(), ascii::space_type> qCurve;
-  qi::rule<Iterator, ClosePolygon(), ascii::space_type> close;
-};
-
-#if defined _MSC_VER
-#pragma warning(pop)
-#endif
-
+  return 0;
 }
 
-namespace
-{
-
-struct Transformer : public static_visitor<void>
+/** A parser of the SVG subset used for paths by IWORK.
+  *
+  * A path consists of curves, each of which starts with a move,
+  * continues with at least one line or curve and may be closed. A
+  * path may end with moves, which are ignored. Tokens may be separated
+  * by whitespace.
+  */
+class PathParser
 {
-  explicit Transformer(const glm::dmat3 &tr)
-    : m_tr(tr)
-  {
-  }
-
-  template<typename T>
-  void operator()(T &element) const
-  {
-    transform(element.m_x, element.m_y);
-  }
+public:
+  PathParser(const string &path, IWORKPath::Impl &impl);
 
-  void operator()(CCurveTo &element) const
-  {
-    transform(element.m_x1, element.m_y1);
-    transform(element.m_x2, element.m_y2);
-    transform(element.m_x, element.m_y);
-  }
+  bool parse();
 
-  void operator()(QCurveTo &element) const
-  {
-    transform(element.m_x1, element.m_y1);
-    transform(element.m_x, element.m_y);
-  }
-
-  void operator()(ClosePolygon &) const
-  {
-  }
 private:
-  void transform(double &x, double &y) const
-  {
-    glm::dvec3 vec = m_tr * glm::dvec3(x, y, 1);
-
-    x = vec[0];
-    y = vec[1];
-  }
+  void skipSpace();
+  bool parseCommand(char command);
+  bool parseNumber(double &value);
 
 private:
-  const glm::dmat3 &m_tr;
+  const char *m_pos;
+  const char *const m_end;
+  std::vector<char> &m_commands;
+  std::vector<double> &m_xs;
+  std::vector<double> &m_ys;
 };
 
+PathParser::PathParser(const string &path, IWORKPath::Impl &impl)
+  : m_pos(path.data())
+  , m_end(path.data() + path.size())
+  , m_commands(impl.m_commands)
+  , m_xs(impl.m_xs)
+  , m_ys(impl.m_ys)
+{
 }
 
-namespace
+bool PathParser::parse()
 {
+  bool seenCurve = false;
 
-struct Writer : public static_visitor<void>
-{
-  explicit Writer(RVNGPropertyListVector &path, double deltaX, double deltaY)
-    : m_path(path)
-    , m_deltaX(deltaX)
-    , m_deltaY(deltaY)
-  {
-  }
+  // a rough estimate, to avoid repeated reallocations
+  m_xs.reserve(std::size_t(m_end - m_pos) / 8);
+  m_ys.reserve(std::size_t(m_end - m_pos) / 8);
+  m_commands.reserve(std::size_t(m_end - m_pos) / 16);
 
-  void operator()(const MoveTo &element) const
+  skipSpace();
+  while (m_pos != m_end)
   {
-    RVNGPropertyList command;
-    command.insert("librevenge:path-action", "M");
-    command.insert("svg:x", pt2in(element.m_x+m_deltaX));
-    command.insert("svg:y", pt2in(element.m_y+m_deltaY));
-    m_path.append(command);
-  }
-
-  void operator()(const LineTo &element) const
-  {
-    RVNGPropertyList command;
-    command.insert("librevenge:path-action", "L");
-    command.insert("svg:x", pt2in(element.m_x+m_deltaX));
-    command.insert("svg:y", pt2in(element.m_y+m_deltaY));
-    m_path.append(command);
-  }
-
-  void operator()(const CCurveTo &element) const
-  {
-    RVNGPropertyList command;
-    command.insert("librevenge:path-action", "C");
-    command.insert("svg:x", pt2in(element.m_x+m_deltaX));
-    command.insert("svg:y", pt2in(element.m_y+m_deltaY));
-    command.insert("svg:x1", pt2in(element.m_x1+m_deltaX));
-    command.insert("svg:y1", pt2in(element.m_y1+m_deltaY));
-    command.insert("svg:x2", pt2in(element.m_x2+m_deltaX));
-    command.insert("svg:y2", pt2in(element.m_y2+m_deltaY));
-    m_path.append(command);
-  }
+    if (*m_pos != 'M')
+      return false;
+    ++m_pos;
+    const std::size_t curveStart = m_commands.size();
+    const std::size_t pointStart = m_xs.size();
+    if (!parseCommand('M'))
+      return false;
 
-  void operator()(const QCurveTo &element) const
-  {
-    RVNGPropertyList command;
-    command.insert("librevenge:path-action", "Q");
-    command.insert("svg:x", pt2in(element.m_x+m_deltaX));
-    command.insert("svg:y", pt2in(element.m_y+m_deltaY));
-    command.insert("svg:x1", pt2in(element.m_x1+m_deltaX));
-    command.insert("svg:y1", pt2in(element.m_y1+m_deltaY));
-    m_path.append(command);
-  }
+    bool seenSegment = false;
+    skipSpace();
+    while (m_pos != m_end)
+    {
+      const char c = *m_pos;
+      if ((c == 'L') || (c == 'C') || (c == 'Q'))
+      {
+        ++m_pos;
+        if (!parseCommand(c))
+          return false;
+        seenSegment = true;
+        skipSpace();
+      }
+      else
+      {
+        if ((c == 'Z') && seenSegment)
+        {
+          ++m_pos;
+          m_commands.push_back('Z');
+          skipSpace();
+        }
+        break;
+      }
+    }
 
-  void operator()(const ClosePolygon &) const
-  {
-    RVNGPropertyList command;
-    command.insert("librevenge:path-action", "Z");
-    m_path.append(command);
+    if (!seenSegment)
+    {
+      // a single move: it is only allowed at the end, after at least one curve
+      m_commands.resize(curveStart);
+      m_xs.resize(pointStart);
+      m_ys.resize(pointStart);
+      if (!seenCurve)
+        return false;
+      while (m_pos != m_end)
+      {
+        if (*m_pos != 'M')
+          return false;
+        ++m_pos;
+        double dummy;
+        if (!parseNumber(dummy) || !parseNumber(dummy))
+          return false;
+        skipSpace();
+      }
+      return true;
+    }
+    seenCurve = true;
   }
-private:
-  RVNGPropertyListVector &m_path;
-  double m_deltaX;
-  double m_deltaY;
-};
 
+  return seenCurve;
 }
 
-namespace
+void PathParser::skipSpace()
 {
+  while ((m_pos != m_end) && ((*m_pos == ' ') || ((*m_pos >= '\t') && (*m_pos <= '\r'))))
+    ++m_pos;
+}
 
-struct Comparator : public static_visitor<bool>
+bool PathParser::parseCommand(const char command)
 {
-  explicit Comparator(double eps)
-    : m_eps(eps)
-  {
-  }
-
-  template<typename T, typename U>
-  bool operator()(const T &, const U &) const
-  {
-    return false;
-  }
-
-  template<typename T>
-  bool operator()(const T &left, const T &right) const
-  {
-    return approxEqual(left, right);
-  }
-
-private:
-  template<typename T>
-  bool approxEqual(const T &left, const T &right) const
-  {
-    using libetonyek::approxEqual;
-    return approxEqual(left.m_x, right.m_x, m_eps) && approxEqual(left.m_y, right.m_y, m_eps);
-  }
-
-  bool approxEqual(const QCurveTo &left, const QCurveTo &right) const
-  {
-    using libetonyek::approxEqual;
-    return approxEqual(left.m_x1, right.m_x1, m_eps) && approxEqual(left.m_y1, right.m_y1, m_eps)
-           && approxEqual(left.m_x, right.m_x, m_eps) && approxEqual(left.m_y, right.m_y, m_eps)
-           ;
-  }
-
-  bool approxEqual(const CCurveTo &left, const CCurveTo &right) const
-  {
-    using libetonyek::approxEqual;
-    return approxEqual(left.m_x1, right.m_x1, m_eps) && approxEqual(left.m_y1, right.m_y1, m_eps)
-           && approxEqual(left.m_x2, right.m_x2, m_eps) && approxEqual(left.m_y2, right.m_y2, m_eps)
-           && approxEqual(left.m_x, right.m_x, m_eps) && approxEqual(left.m_y, right.m_y, m_eps)
-           ;
-  }
-
-  bool approxEqual(const ClosePolygon &, const ClosePolygon &) const
+  m_commands.push_back(command);
+  for (unsigned i = getPointCount(command); i != 0; --i)
   {
-    return true;
+    double x;
+    double y;
+    if (!parseNumber(x) || !parseNumber(y))
+      return false;
+    m_xs.push_back(x);
+    m_ys.push_back(y);
   }
-
-private:
-  const double m_eps;
-};
-
+  return true;
 }
 
-namespace
-{
-
-using std::ostringstream;
-
-struct SVGPrinter : public static_visitor<void>
+bool PathParser::parseNumber(double &value)
 {
-  explicit SVGPrinter(ostringstream &sink)
-    : m_sink(sink)
-  {
-  }
-
-  void operator()(const MoveTo &element) const
-  {
-    m_sink << "M " << element.m_x << ' ' << element.m_y;
-  }
-
-  void operator()(const LineTo &element) const
-  {
-    m_sink << "L " << element.m_x << ' ' << element.m_y;
-  }
-
-  void operator()(const CCurveTo &element) const
-  {
-    m_sink
-        << 'C'
-        << ' ' << element.m_x1 << ' ' << element.m_y1
-        << ' ' << element.m_x2 << ' ' << element.m_y2
-        << ' ' << element.m_x << ' ' << element.m_y
-        ;
-  }
-
-  void operator()(const QCurveTo &element) const
-  {
-    m_sink
-        << 'Q'
-        << ' ' << element.m_x1 << ' ' << element.m_y1
-        << ' ' << element.m_x << ' ' << element.m_y
-        ;
-  }
-
-  void operator()(const ClosePolygon &) const
-  {
-    m_sink
-        << 'Z'
-        ;
-  }
-private:
-  ostringstream &m_sink;
-};
-
+  skipSpace();
+  const char *const next = parseDouble(m_pos, m_end, value);
+  if (next == m_pos)
+    return false;
+  m_pos = next;
+  return true;
 }
 
+}
 
 namespace
 {
 
-struct ComputeBoundingBox : public static_visitor<void>
+struct ComputeBoundingBox
 {
   explicit ComputeBoundingBox()
     : m_first(true)
@@ -439,36 +236,29 @@ struct ComputeBoundingBox : public static_visitor<void>
     for (int i=0; i<2; ++i) m_boundX[i]=m_boundY[i]=0;
   }
 
-  void operator()(const MoveTo &element)
-  {
-    m_x=element.m_x;
-    m_y=element.m_y;
-    addPoint(m_x, m_y);
-  }
-
-  void operator()(const LineTo &element)
-  {
-    m_x=element.m_x;
-    m_y=element.m_y;
-    addPoint(m_x, m_y);
-  }
-
-  void operator()(const CCurveTo &element)
-  {
-    getCubicBezierBBox(m_x, m_y, element.m_x1, element.m_y1, element.m_x2, element.m_y2, element.m_x, element.m_y);
-    m_x=element.m_x;
-    m_y=element.m_y;
-  }
-
-  void operator()(const QCurveTo &element)
-  {
-    getQuadraticBezierBBox(m_x, m_y, element.m_x1, element.m_y1, element.m_x, element.m_y);
-    m_x=element.m_x;
-    m_y=element.m_y;
-  }
-
-  void operator()(const ClosePolygon &)
+  void add(const char command, const double *const xs, const double *const ys)
   {
+    switch (command)
+    {
+    case 'M' :
+    case 'L' :
+      m_x=xs[0];
+      m_y=ys[0];
+      addPoint(m_x, m_y);
+      break;
+    case 'C' :
+      getCubicBezierBBox(m_x, m_y, xs[0], ys[0], xs[1], ys[1], xs[2], ys[2]);
+      m_x=xs[2];
+      m_y=ys[2];
+      break;
+    case 'Q' :
+      getQuadraticBezierBBox(m_x, m_y, xs[0], ys[0], xs[1], ys[1]);
+      m_x=xs[1];
+      m_y=ys[1];
+      break;
+    default :
+      break;
+    }
   }
 public:
   double m_boundX[2], m_boundY[2];
@@ -558,11 +348,8 @@ IWORKPath::IWORKPath()
 IWORKPath::IWORKPath(const std::string &path)
   : m_impl(new Impl())
 {
-  PathGrammar<string::const_iterator> grammar;
-  string::const_iterator it = path.begin();
-  const bool r = qi::phrase_parse(it, path.end(), grammar, ascii::space, *m_impl);
-
-  if (!r || (path.end() != it))
+  PathParser parser(path, *m_impl);
+  if (!parser.parse())
   {
     ETONYEK_DEBUG_MSG(("parsing of path '%s' failed\n", path.c_str()));
     throw InvalidException();
@@ -574,6 +361,17 @@ IWORKPath::IWORKPath(const IWORKPath &other)
 {
 }
 
+IWORKPath::IWORKPath(const IWORKPath &other, const glm::dmat3 &tr)
+  : m_impl(new Impl())
+{
+  const std::size_t count = other.m_impl->getPointCount();
+  m_impl->m_commands = other.m_impl->m_commands;
+  m_impl->m_xs.resize(count);
+  m_impl->m_ys.resize(count);
+  m_impl->m_closed = other.m_impl->m_closed;
+  transformPoints(tr, count, other.m_impl->m_xs.data(), other.m_impl->m_ys.data(), m_impl->m_xs.data(), m_impl->m_ys.data());
+}
+
 IWORKPath &IWORKPath::operator=(const IWORKPath &other)
 {
   IWORKPath copy(other);
@@ -588,97 +386,121 @@ void IWORKPath::swap(IWORKPath &other)
 
 void IWORKPath::clear()
 {
-  m_impl->m_path.clear();
+  m_impl->m_commands.clear();
+  m_impl->m_xs.clear();
+  m_impl->m_ys.clear();
   m_impl->m_closed = false;
 }
 
 bool IWORKPath::empty() const
 {
-  return m_impl->m_path.empty();
+  return m_impl->m_commands.empty();
 }
 
 void IWORKPath::appendMoveTo(const double x, const double y)
 {
-  if (!m_impl->m_path.empty() && m_impl->m_path.back().size()<=1)
+  if (!m_impl->m_commands.empty() && m_impl->m_commands.back()=='M')
   {
     ETONYEK_DEBUG_MSG(("IWORKPath::appendMoveTo: find a single point path\n"));
-    m_impl->m_path.pop_back();
+    m_impl->m_commands.pop_back();
+    m_impl->m_xs.pop_back();
+    m_impl->m_ys.pop_back();
   }
-  MoveTo element;
-  element.m_x = x;
-  element.m_y = y;
-  m_impl->m_path.push_back(Curve_t());
-  m_impl->m_path.back().push_back(element);
+  m_impl->m_commands.push_back('M');
+  m_impl->m_xs.push_back(x);
+  m_impl->m_ys.push_back(y);
   m_impl->m_closed=false;
 }
 
 void IWORKPath::appendLineTo(const double x, const double y)
 {
-  assert(!m_impl->m_closed && !m_impl->m_path.empty());
+  assert(!m_impl->m_closed && !m_impl->m_commands.empty());
 
-  LineTo element;
-  element.m_x = x;
-  element.m_y = y;
-  m_impl->m_path.back().push_back(element);
+  m_impl->m_commands.push_back('L');
+  m_impl->m_xs.push_back(x);
+  m_impl->m_ys.push_back(y);
 }
 
 void IWORKPath::appendCCurveTo(const double x1, const double y1, const double x2, const double y2, const double x, const double y)
 {
-  assert(!m_impl->m_closed && !m_impl->m_path.empty());
+  assert(!m_impl->m_closed && !m_impl->m_commands.empty());
 
-  CCurveTo element;
-  element.m_x1 = x1;
-  element.m_y1 = y1;
-  element.m_x2 = x2;
-  element.m_y2 = y2;
-  element.m_x = x;
-  element.m_y = y;
-  m_impl->m_path.back().push_back(element);
+  m_impl->m_commands.push_back('C');
+  const double xs[] = {x1, x2, x};
+  const double ys[] = {y1, y2, y};
+  m_impl->m_xs.insert(m_impl->m_xs.end(), xs, xs + 3);
+  m_impl->m_ys.insert(m_impl->m_ys.end(), ys, ys + 3);
 }
 
 void IWORKPath::appendQCurveTo(const double x1, const double y1, const double x, const double y)
 {
-  assert(!m_impl->m_closed && !m_impl->m_path.empty());
+  assert(!m_impl->m_closed && !m_impl->m_commands.empty());
 
-  QCurveTo element;
-  element.m_x1 = x1;
-  element.m_y1 = y1;
-  element.m_x = x;
-  element.m_y = y;
-  m_impl->m_path.back().push_back(element);
+  m_impl->m_commands.push_back('Q');
+  const double xs[] = {x1, x};
+  const double ys[] = {y1, y};
+  m_impl->m_xs.insert(m_impl->m_xs.end(), xs, xs + 2);
+  m_impl->m_ys.insert(m_impl->m_ys.end(), ys, ys + 2);
 }
 
 void IWORKPath::appendClose()
 {
-  assert(!m_impl->m_closed && !m_impl->m_path.empty());
-  if (m_impl->m_path.back().size()==1)
+  assert(!m_impl->m_closed && !m_impl->m_commands.empty());
+  if (m_impl->m_commands.back()=='M')
   {
     ETONYEK_DEBUG_MSG(("IWORKPath::appendClose: impossible to close an path with one point\n"));
-    m_impl->m_path.pop_back();
+    m_impl->m_commands.pop_back();
+    m_impl->m_xs.pop_back();
+    m_impl->m_ys.pop_back();
     m_impl->m_closed = true;
     return;
   }
-  m_impl->m_path.back().push_back(ClosePolygon());
+  m_impl->m_commands.push_back('Z');
 
   m_impl->m_closed = true;
 }
 
 void IWORKPath::operator*=(const glm::dmat3 &tr)
 {
-  for (auto &it : m_impl->m_path)
-  {
-    for (auto &cIt : it)
-      apply_visitor(Transformer(tr), cIt);
-  }
+  const std::size_t count = m_impl->getPointCount();
+  transformPoints(tr, count, m_impl->m_xs.data(), m_impl->m_ys.data(), m_impl->m_xs.data(), m_impl->m_ys.data());
 }
 
 void IWORKPath::computeBoundingBox(double &minX, double &minY, double &maxX, double &maxY, double factor) const
 {
+  const std::vector<char> &commands = m_impl->m_commands;
+  const std::vector<double> &xs = m_impl->m_xs;
+  const std::vector<double> &ys = m_impl->m_ys;
+  const char curves[] = {'C', 'Q'};
+  if (std::find_first_of(commands.begin(), commands.end(), curves, curves + 2) == commands.end())
+  {
+    // only straight lines: the bounding box of the points is the result
+    double bounds[4] = {0, 0, 0, 0};
+    if (!xs.empty())
+    {
+      bounds[0] = bounds[2] = xs[0];
+      bounds[1] = bounds[3] = ys[0];
+      for (std::size_t i = 1; i < xs.size(); ++i)
+      {
+        bounds[0] = std::min(bounds[0], xs[i]);
+        bounds[2] = std::max(bounds[2], xs[i]);
+        bounds[1] = std::min(bounds[1], ys[i]);
+        bounds[3] = std::max(bounds[3], ys[i]);
+      }
+    }
+    minX=factor*bounds[0];
+    minY=factor*bounds[1];
+    maxX=factor*bounds[2];
+    maxY=factor*bounds[3];
+    return;
+  }
+
   ComputeBoundingBox bdCompute;
-  for (auto const &it : m_impl->m_path)
+  std::size_t point = 0;
+  for (const char command : commands)
   {
-    for (auto const &cIt : it)
-      apply_visitor(bdCompute, cIt);
+    bdCompute.add(command, xs.data() + point, ys.data() + point);
+    point += getPointCount(command);
   }
   minX=factor*bdCompute.m_boundX[0];
   maxX=factor*bdCompute.m_boundX[1];
@@ -688,30 +510,20 @@ void IWORKPath::computeBoundingBox(double &minX, double &minY, double &maxX, dou
 
 bool IWORKPath::isRectangle() const
 {
-  if (m_impl->m_path.size()!=1) return false;
-  Curve_t const &curve=m_impl->m_path[0];
-  if (curve.size()!=4 && (curve.size()!=5 || !boost::get<ClosePolygon>(&curve.back())))
+  const std::vector<char> &commands = m_impl->m_commands;
+  if (commands.size()!=4 && (commands.size()!=5 || commands.back()!='Z'))
+    return false;
+  if (commands[0]!='M' || commands[1]!='L' || commands[2]!='L' || commands[3]!='L')
     return false;
   double x[5] = {0};
   double y[5] = {0};
-  int pt=0;
-  for (const auto &it : curve)
+  for (int pt=0; pt<4; ++pt)
   {
-    if (pt==0 && boost::get<MoveTo>(&it))
-    {
-      x[0]=x[4]=boost::get<MoveTo>(&it)->m_x;
-      y[0]=y[4]=boost::get<MoveTo>(&it)->m_y;
-    }
-    else if (pt && boost::get<LineTo>(&it))
-    {
-      x[pt]=boost::get<LineTo>(&it)->m_x;
-      y[pt]=boost::get<LineTo>(&it)->m_y;
-    }
-    else
-      return false;
-    if (++pt==4)
-      break;
+    x[pt]=m_impl->m_xs[std::size_t(pt)];
+    y[pt]=m_impl->m_ys[std::size_t(pt)];
   }
+  x[4]=x[0];
+  y[4]=y[0];
   int id=(x[0]<=x[1] && x[0]>=x[1]) ? 0 : 1;
   if (x[id]<x[id+1] || x[id]>x[id+1] || // check axis
       y[id+1]<y[id+2] || y[id+1]>y[id+2] ||
@@ -735,46 +547,46 @@ bool IWORKPath::isRectangle() const
 
 void IWORKPath::closePath(bool closeOnlyIsSamePoint)
 {
+  std::vector<char> &commands = m_impl->m_commands;
+  const std::vector<double> &xs = m_impl->m_xs;
+  const std::vector<double> &ys = m_impl->m_ys;
   bool lastClosed=false;
-  for (auto &curve : m_impl->m_path)
-  {
+  std::size_t i=0;
+  std::size_t point=0;
+  while (i<commands.size())
+  {
+    // find the end of the curve
+    const std::size_t begin=i;
+    const std::size_t beginPoint=point;
+    do
+    {
+      point+=getPointCount(commands[i]);
+      ++i;
+    }
+    while (i<commands.size() && commands[i]!='M');
+
     lastClosed=false;
-    if (curve.size()<=1) continue;
-    const CurveElement_t front=curve.front();
-    const CurveElement_t back=curve.back();
+    if (i-begin<=1) continue;
+    const char back=commands[i-1];
     if (!closeOnlyIsSamePoint)
     {
-      if (!boost::get<ClosePolygon>(&back) && (curve.size()>1 || !boost::get<LineTo>(&back)))
+      if (back!='Z')
       {
-        curve.push_back(ClosePolygon());
+        commands.insert(commands.begin()+long(i), 'Z');
+        ++i;
         lastClosed=true;
       }
       continue;
     }
-    if (!boost::get<MoveTo>(&front)) return;
-    double origin[2]= {boost::get<MoveTo>(&front)->m_x,boost::get<MoveTo>(&front)->m_y};
-    double dest[2];
-    if (boost::get<LineTo>(&back))
-    {
-      dest[0]=boost::get<LineTo>(&back)->m_x;
-      dest[1]=boost::get<LineTo>(&back)->m_y;
-    }
-    else if (boost::get<CCurveTo>(&back))
-    {
-      dest[0]=boost::get<CCurveTo>(&back)->m_x;
-      dest[1]=boost::get<CCurveTo>(&back)->m_y;
-    }
-    else if (boost::get<QCurveTo>(&back))
-    {
-      dest[0]=boost::get<QCurveTo>(&back)->m_x;
-      dest[1]=boost::get<QCurveTo>(&back)->m_y;
-    }
-    else
+    if (back=='Z')
       return;
+    const double origin[2]= {xs[beginPoint], ys[beginPoint]};
+    const double dest[2]= {xs[point-1], ys[point-1]};
     if (origin[0]<=dest[0] && origin[0]>=dest[0] &&
         origin[1]<=dest[1] && origin[1]>=dest[1])
     {
-      curve.push_back(ClosePolygon());
+      commands.insert(commands.begin()+long(i), 'Z');
+      ++i;
       lastClosed=true;
     }
   }
@@ -784,19 +596,19 @@ void IWORKPath::closePath(bool closeOnlyIsSamePoint)
 
 const std::string IWORKPath::str() const
 {
-  ostringstream sink;
+  std::ostringstream sink;
 
+  std::size_t point = 0;
   bool first=true;
-  for (Path_t::const_iterator it = m_impl->m_path.begin(); it != m_impl->m_path.end(); ++it)
+  for (const char command : m_impl->m_commands)
   {
-    for (const auto &cIt : *it)
-    {
-      if (!first)
-        sink << ' ';
-      else
-        first=false;
-      apply_visitor(SVGPrinter(sink), cIt);
-    }
+    if (!first)
+      sink << ' ';
+    else
+      first=false;
+    sink << command;
+    for (unsigned i = getPointCount(command); i != 0; --i, ++point)
+      sink << ' ' << m_impl->m_xs[point] << ' ' << m_impl->m_ys[point];
   }
 
   return sink.str();
@@ -804,28 +616,54 @@ const std::string IWORKPath::str() const
 
 void IWORKPath::write(librevenge::RVNGPropertyListVector &vec, double deltaX, double deltaY) const
 {
-  for (Path_t::const_iterator it = m_impl->m_path.begin(); it != m_impl->m_path.end(); ++it)
+  std::size_t point = 0;
+  for (const char command : m_impl->m_commands)
   {
-    for (const auto &cIt : *it)
-      apply_visitor(Writer(vec, deltaX, deltaY), cIt);
+    const double *const xs = m_impl->m_xs.data() + point;
+    const double *const ys = m_impl->m_ys.data() + point;
+    RVNGPropertyList element;
+    const char action[] = {command, 0};
+    element.insert("librevenge:path-action", action);
+    switch (command)
+    {
+    case 'M' :
+    case 'L' :
+      element.insert("svg:x", pt2in(xs[0]+deltaX));
+      element.insert("svg:y", pt2in(ys[0]+deltaY));
+      break;
+    case 'C' :
+      element.insert("svg:x", pt2in(xs[2]+deltaX));
+      element.insert("svg:y", pt2in(ys[2]+deltaY));
+      element.insert("svg:x1", pt2in(xs[0]+deltaX));
+      element.insert("svg:y1", pt2in(ys[0]+deltaY));
+      element.insert("svg:x2", pt2in(xs[1]+deltaX));
+      element.insert("svg:y2", pt2in(ys[1]+deltaY));
+      break;
+    case 'Q' :
+      element.insert("svg:x", pt2in(xs[1]+deltaX));
+      element.insert("svg:y", pt2in(ys[1]+deltaY));
+      element.insert("svg:x1", pt2in(xs[0]+deltaX));
+      element.insert("svg:y1", pt2in(ys[0]+deltaY));
+      break;
+    default :
+      break;
+    }
+    vec.append(element);
+    point += getPointCount(command);
   }
 }
 
 bool approxEqual(const IWORKPath &left, const IWORKPath &right, const double eps)
 {
   if ((left.m_impl->m_closed != right.m_impl->m_closed)
-      || (left.m_impl->m_path.size() != right.m_impl->m_path.size()))
+      || (left.m_impl->m_commands != right.m_impl->m_commands))
     return false;
-  for (Path_t::const_iterator lit = left.m_impl->m_path.begin(), rit = right.m_impl->m_path.begin();
-       lit != left.m_impl->m_path.end();
-       ++lit, ++rit)
+  const std::size_t count = left.m_impl->getPointCount();
+  for (std::size_t i = 0; i < count; ++i)
   {
-    if (lit->size()!=rit->size()) return false;
-    for (auto cLit = lit->begin(), cRit = rit->begin(); cLit != lit->end(); ++cLit, ++cRit)
-    {
-      if (!apply_visitor(Comparator(eps), *cLit, *cRit))
-        return false;
-    }
+    if (!approxEqual(left.m_impl->m_xs[i], right.m_impl->m_xs[i], eps)
+        || !approxEqual(left.m_impl->m_ys[i], right.m_impl->m_ys[i], eps))
+      return false;
   }
   return true;
 }
@@ -842,9 +680,7 @@ bool operator!=(const IWORKPath &left, const IWORKPath &right)
 
 IWORKPath operator*(const IWORKPath &path, const glm::dmat3 &tr)
 {
-  IWORKPath newPath(path);
-  newPath *= tr;
-  return newPath;
+  return IWORKPath(path, tr);
 }
 
 IWORKConnectionPath::IWORKConnectionPath()
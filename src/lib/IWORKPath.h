@@ -37,6 +37,15 @@ public:
   IWORKPath();
   explicit IWORKPath(const std::string &path);
   IWORKPath(const IWORKPath &other);
+  /** Create a transformed copy of a path.
+    *
+    * This transforms all the points in one pass, without copying
+    * them first.
+    *
+    * @arg[in] other the path
+    * @arg[in] tr the transformation
+    */
+  IWORKPath(const IWORKPath &other, const glm::dmat3 &tr);
   IWORKPath &operator=(const IWORKPath &other);
 
   void swap(IWORKPath &other);
@@ -0,0 +1,45 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "IWORKPropertyInfo.h"
+
+#include <vector>
+
+namespace libetonyek
+{
+
+namespace
+{
+
+// Properties are registered during static initialization, so the
+// registry must be constructed on first use.
+std::vector<const char *> &getPropertyNames()
+{
+  static std::vector<const char *> names(1, "");
+  return names;
+}
+
+}
+
+IWORKPropertyID_t registerProperty(const char *const name)
+{
+  std::vector<const char *> &names = getPropertyNames();
+  names.push_back(name);
+  return IWORKPropertyID_t(names.size() - 1);
+}
+
+const char *getPropertyName(const IWORKPropertyID_t id)
+{
+  const std::vector<const char *> &names = getPropertyNames();
+  return id < names.size() ? names[id] : "";
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
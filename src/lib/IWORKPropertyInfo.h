@@ -10,12 +10,31 @@
 #ifndef IWORKPROPERTYINFO_H_INCLUDED
 #define IWORKPROPERTYINFO_H_INCLUDED
 
-#include <string>
-
 namespace libetonyek
 {
 
-typedef std::string IWORKPropertyID_t;
+/** Property ID.
+  *
+  * IDs are small integers, assigned to properties in order of their
+  * registration, so they can be used as a cheap key. 0 is never used.
+  */
+typedef unsigned IWORKPropertyID_t;
+
+/** Register a new property.
+  *
+  * @arg[in] name the name of the property. It is only used for
+  *   debugging, so there is no check for uniqueness.
+  * @returns the ID of the property.
+  */
+IWORKPropertyID_t registerProperty(const char *name);
+
+/** Get the name of a property.
+  *
+  * @arg[in] id the ID of the property.
+  * @returns the name of the property or an empty string if the ID is
+  *   unknown.
+  */
+const char *getPropertyName(IWORKPropertyID_t id);
 
 template<typename Name>
 struct IWORKPropertyInfo
@@ -37,7 +56,7 @@ struct IWORKPropertyInfo<property::name> \
 }
 
 #define IWORK_IMPLEMENT_PROPERTY(name) \
-const IWORKPropertyID_t IWORKPropertyInfo<property::name>::id = #name
+const IWORKPropertyID_t IWORKPropertyInfo<property::name>::id = registerProperty(#name)
 
 }
 
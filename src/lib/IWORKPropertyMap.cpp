@@ -15,18 +15,21 @@ namespace libetonyek
 IWORKPropertyMap::IWORKPropertyMap()
   : m_map()
   , m_parent(nullptr)
+  , m_flattened()
 {
 }
 
 IWORKPropertyMap::IWORKPropertyMap(const IWORKPropertyMap *const parent)
   : m_map()
   , m_parent(parent)
+  , m_flattened()
 {
 }
 
 IWORKPropertyMap::IWORKPropertyMap(const IWORKPropertyMap &other)
   : m_map(other.m_map)
   , m_parent(other.m_parent)
+  , m_flattened(other.m_flattened)
 {
 }
 
@@ -42,11 +45,66 @@ void IWORKPropertyMap::swap(IWORKPropertyMap &other)
   using std::swap;
   swap(m_map, other.m_map);
   swap(m_parent, other.m_parent);
+  swap(m_flattened, other.m_flattened);
 }
 
 void IWORKPropertyMap::setParent(const IWORKPropertyMap *const parent)
 {
   m_parent = parent;
+  m_flattened.reset();
+}
+
+void IWORKPropertyMap::flatten()
+{
+  // there is nothing to gain without a parent
+  if (!m_parent)
+  {
+    m_flattened.reset();
+    return;
+  }
+
+  // a map without properties of its own has the same ones as its parent
+  if (m_map.empty() && m_parent->m_flattened)
+  {
+    m_flattened = m_parent->m_flattened;
+    return;
+  }
+
+  const std::shared_ptr<Map_t> flattened = std::make_shared<Map_t>(m_map);
+  if (m_parent->m_flattened)
+  {
+    flattened->insert(m_parent->m_flattened->begin(), m_parent->m_flattened->end());
+  }
+  else
+  {
+    // a property of this map, or of a closer parent, has precedence
+    for (const IWORKPropertyMap *parent = m_parent; parent; parent = parent->m_parent)
+      flattened->insert(parent->m_map.begin(), parent->m_map.end());
+  }
+  m_flattened = flattened;
+}
+
+bool IWORKPropertyMap::isFlattened() const
+{
+  return bool(m_flattened);
+}
+
+const boost::any *IWORKPropertyMap::find(const IWORKPropertyID_t id, const bool lookInParent) const
+{
+  if (lookInParent && m_flattened)
+  {
+    const auto it = m_flattened->find(id);
+    return (m_flattened->end() != it) ? &it->second : nullptr;
+  }
+
+  const auto it = m_map.find(id);
+  if (m_map.end() != it)
+    return &it->second;
+
+  if (lookInParent && m_parent)
+    return m_parent->find(id, lookInParent);
+
+  return nullptr;
 }
 
 }
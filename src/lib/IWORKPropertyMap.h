@@ -10,9 +10,11 @@
 #ifndef IWORKPROPERTYMAP_H_INCLUDED
 #define IWORKPROPERTYMAP_H_INCLUDED
 
-#include <unordered_map>
+#include <cassert>
+#include <memory>
 
 #include <boost/any.hpp>
+#include <boost/container/flat_map.hpp>
 
 #include "IWORKPropertyInfo.h"
 
@@ -27,7 +29,8 @@ public:
   class NotFoundException {};
 
 private:
-  typedef std::unordered_map<IWORKPropertyID_t, boost::any> Map_t;
+  // Property maps are small, so a sorted vector is faster than a hash map.
+  typedef boost::container::flat_map<IWORKPropertyID_t, boost::any> Map_t;
 
 public:
   /** Construct an empty map.
@@ -65,6 +68,21 @@ public:
     */
   void setParent(const IWORKPropertyMap *parent);
 
+  /** Take a snapshot of the properties of this map and its parent maps.
+    *
+    * The snapshot is used by lookups that search the parent maps, so
+    * they need only one search, whatever the depth of the hierarchy.
+    * Lookups in this map alone still only see its own properties. A
+    * change of this map or of its parent drops the snapshot, but later
+    * changes of the parent maps themselves are not reflected, so this
+    * must only be done once the hierarchy is complete.
+    */
+  void flatten();
+
+  /** Check if there is a snapshot of the properties of the parent maps.
+    */
+  bool isFlattened() const;
+
   /** Check for the presence of a property.
     *
     * If the property is not found in this map and @c lookInParent is @c
@@ -77,27 +95,15 @@ public:
   template<class Property>
   bool has(bool lookInParent = false) const
   {
-    const auto it = m_map.find(IWORKPropertyInfo<Property>::id);
-    if (m_map.end() != it)
-      return !it->second.empty();
-
-    if (lookInParent && m_parent)
-      return m_parent->has<Property>(lookInParent);
-
-    return false;
+    const boost::any *const value = find(IWORKPropertyInfo<Property>::id, lookInParent);
+    return value && !value->empty();
   }
 
   template<class Property>
   bool clears(bool lookInParent = false) const
   {
-    const auto it = m_map.find(IWORKPropertyInfo<Property>::id);
-    if (m_map.end() != it)
-      return it->second.empty();
-
-    if (lookInParent && m_parent)
-      return m_parent->clears<Property>(lookInParent);
-
-    return false;
+    const boost::any *const value = find(IWORKPropertyInfo<Property>::id, lookInParent);
+    return value && value->empty();
   }
 
   /** Retrieve the value of a property.
@@ -112,18 +118,30 @@ public:
   template<class Property>
   const typename IWORKPropertyInfo<Property>::ValueType &get(bool lookInParent = false) const
   {
-    const auto it = m_map.find(IWORKPropertyInfo<Property>::id);
-    if (m_map.end() != it)
-    {
-      if (!it->second.empty())
-        return boost::any_cast<const typename IWORKPropertyInfo<Property>::ValueType &>(it->second);
-    }
-    else if (lookInParent && m_parent)
-    {
-      return m_parent->get<Property>(lookInParent);
-    }
-
-    throw NotFoundException();
+    const boost::any *const value = find(IWORKPropertyInfo<Property>::id, lookInParent);
+    if (!value || value->empty())
+      throw NotFoundException();
+    // put() only ever stores the property's value type, so there is no need to check it
+    return *boost::unsafe_any_cast<typename IWORKPropertyInfo<Property>::ValueType>(value);
+  }
+
+  /** Look up a property.
+    *
+    * This does the work of has(), clears() and get() at once.
+    *
+    * @arg[out] cleared set to true if the property is cleared
+    * @arg[in] lookInParent should the parent map be searched if the
+    * property is not found in this map?
+    * @returns the found value or @c nullptr
+    */
+  template<class Property>
+  const typename IWORKPropertyInfo<Property>::ValueType *lookup(bool &cleared, bool lookInParent = false) const
+  {
+    const boost::any *const value = find(IWORKPropertyInfo<Property>::id, lookInParent);
+    cleared = value && value->empty();
+    if (!value || value->empty())
+      return nullptr;
+    return boost::unsafe_any_cast<typename IWORKPropertyInfo<Property>::ValueType>(value);
   }
 
   /** Insert a new value for key @c key.
@@ -133,7 +151,9 @@ public:
   template<class Property>
   void put(const typename IWORKPropertyInfo<Property>::ValueType &value)
   {
+    assert(IWORKPropertyInfo<Property>::id != 0);
     m_map[IWORKPropertyInfo<Property>::id] = value;
+    m_flattened.reset();
   }
 
   /** Clear property.
@@ -144,12 +164,27 @@ public:
   template<class Property>
   void clear()
   {
+    assert(IWORKPropertyInfo<Property>::id != 0);
     m_map[IWORKPropertyInfo<Property>::id] = boost::any();
+    m_flattened.reset();
   }
 
+private:
+  /** Find the value of a property.
+    *
+    * @arg[in] id the property ID
+    * @arg[in] lookInParent should the parent map be searched if the
+    * property is not found in this map?
+    * @returns the value, which is empty if the property is cleared, or
+    * @c nullptr if the property is not found
+    */
+  const boost::any *find(IWORKPropertyID_t id, bool lookInParent) const;
+
 private:
   Map_t m_map;
   const IWORKPropertyMap *m_parent;
+  /// The properties of this map and its parents, shared by maps that have the same ones.
+  std::shared_ptr<const Map_t> m_flattened;
 };
 
 }
@@ -0,0 +1,50 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "IWORKSkipContext.h"
+
+#include <memory>
+
+namespace libetonyek
+{
+
+IWORKSkipContext::IWORKSkipContext()
+{
+}
+
+void IWORKSkipContext::startOfElement()
+{
+}
+
+void IWORKSkipContext::attribute(int, const char *)
+{
+}
+
+IWORKXMLContextPtr_t IWORKSkipContext::element(int)
+{
+  // only reached if the parser does not skip the content
+  return allocateContext<IWORKSkipContext>();
+}
+
+void IWORKSkipContext::text(const char *)
+{
+}
+
+void IWORKSkipContext::endOfElement()
+{
+}
+
+bool IWORKSkipContext::skipContent() const
+{
+  return true;
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,43 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IWORKSKIPCONTEXT_H_INCLUDED
+#define IWORKSKIPCONTEXT_H_INCLUDED
+
+#include "IWORKXMLContext.h"
+
+namespace libetonyek
+{
+
+/** A context for elements whose content is of no interest.
+  *
+  * Unlike IWORKDiscardContext, which still walks the subtree to pick up
+  * styles and other referenceable objects, this lets the parser skip the
+  * whole subtree. It must only be used for elements that are known not
+  * to contain anything referenced from elsewhere.
+  */
+class IWORKSkipContext : public IWORKXMLContext
+{
+public:
+  IWORKSkipContext();
+
+private:
+  void startOfElement() override;
+  void attribute(int name, const char *value) override;
+  IWORKXMLContextPtr_t element(int name) override;
+  void text(const char *value) override;
+  void endOfElement() override;
+  bool skipContent() const override;
+};
+
+}
+
+#endif // IWORKSKIPCONTEXT_H_INCLUDED
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
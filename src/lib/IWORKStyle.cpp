@@ -61,7 +61,7 @@ bool IWORKStyle::link(const IWORKStylesheetPtr_t &stylesheet)
 
 void IWORKStyle::flatten()
 {
-  // TODO: implement me
+  m_props.flatten();
 }
 
 const IWORKPropertyMap &IWORKStyle::getPropertyMap() const
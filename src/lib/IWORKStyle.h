@@ -38,9 +38,14 @@ public:
     */
   bool link(const IWORKStylesheetPtr_t &stylesheet);
 
-  /** Copy attributes from parent style (recursively).
+  /** Take a snapshot of the properties inherited from parent styles.
     *
-    * @todo Will this have any effect on performance anyway?
+    * This makes lookups independent of the depth of the style
+    * hierarchy. It must only be done when the hierarchy is complete,
+    * i.e., after the style and all its ancestors have been linked, and
+    * the ancestors should be flattened first.
+    *
+    * @see IWORKPropertyMap::flatten
     */
   void flatten();
 
@@ -10,12 +10,22 @@
 #include "IWORKStyleStack.h"
 
 #include <cassert>
+#include <functional>
 
 #include "IWORKPropertyMap.h"
 
 namespace libetonyek
 {
 
+std::size_t IWORKStyleStack::KeyHash::operator()(const Key_t &key) const
+{
+  const std::hash<const IWORKStyle *> hash;
+  std::size_t seed = key.size();
+  for (const auto &style : key)
+    seed ^= hash(style.get()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
 IWORKStyleStack::IWORKStyleStack()
   : m_stack()
 {
@@ -50,6 +60,11 @@ void IWORKStyleStack::set(const IWORKStylePtr_t &style)
   m_stack.front() = style;
 }
 
+void IWORKStyleStack::getKey(Key_t &key) const
+{
+  key.assign(m_stack.begin(), m_stack.end());
+}
+
 }
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -10,7 +10,9 @@
 #ifndef IWORKSTYLESTACK_H_INCLUDED
 #define IWORKSTYLESTACK_H_INCLUDED
 
+#include <cstddef>
 #include <deque>
+#include <vector>
 
 #include <boost/any.hpp>
 
@@ -40,6 +42,15 @@ class IWORKStyleStack
     */
   typedef std::deque<IWORKStylePtr_t> Stack_t;
 
+public:
+  /// A combination of styles, from the top of the stack.
+  typedef std::vector<IWORKStylePtr_t> Key_t;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key_t &key) const;
+  };
+
 public:
   /** Construct an empty context.
     */
@@ -65,6 +76,16 @@ public:
 
   void set(const IWORKStylePtr_t &style);
 
+  /** Get the current combination of styles.
+    *
+    * The result of any lookup depends only on the combination of
+    * styles, so it can be used as a key of a cache of resolved
+    * properties, as long as the styles themselves do not change.
+    *
+    * @arg[out] key the combination of styles
+    */
+  void getKey(Key_t &key) const;
+
   template<class Property>
   bool has(const bool lookInParent = true) const
   {
@@ -72,9 +93,10 @@ public:
     {
       if (*it)
       {
-        if ((*it)->getPropertyMap().has<Property>(lookInParent))
+        bool cleared = false;
+        if ((*it)->getPropertyMap().lookup<Property>(cleared, lookInParent))
           return true;
-        else if ((*it)->getPropertyMap().clears<Property>(lookInParent))
+        else if (cleared)
           break;
       }
     }
@@ -88,9 +110,11 @@ public:
     {
       if (*it)
       {
-        if ((*it)->getPropertyMap().has<Property>(lookInParent))
-          return (*it)->getPropertyMap().get<Property>(lookInParent);
-        else if ((*it)->getPropertyMap().clears<Property>(lookInParent))
+        bool cleared = false;
+        const typename IWORKPropertyInfo<Property>::ValueType *const value = (*it)->getPropertyMap().lookup<Property>(cleared, lookInParent);
+        if (value)
+          return *value;
+        else if (cleared)
           break;
       }
     }
@@ -528,6 +528,9 @@ IWORKText::IWORKText(const IWORKLanguageManager &langManager, const bool discard
   , m_spanStyleChanged(false)
   , m_inSpan(false)
   , m_oldSpanStyle()
+  , m_paraPropLists()
+  , m_spanPropLists()
+  , m_styleKey()
   , m_recorder()
 {
 }
@@ -1026,7 +1029,7 @@ void IWORKText::closePara()
 void IWORKText::fillParaPropList(librevenge::RVNGPropertyList &propList, bool realParagraph)
 {
   m_paraStyleStack.push(m_paraStyle);
-  libetonyek::fillParaPropList(m_paraStyleStack, propList);
+  propList = resolvePropList(m_paraPropLists, libetonyek::fillParaPropList);
 
   if (realParagraph)
   {
@@ -1050,8 +1053,11 @@ void IWORKText::openSpan()
   m_paraStyleStack.push(m_paraStyle);
   m_paraStyleStack.push(m_spanStyle);
   m_paraStyleStack.push(m_langStyle);
-  librevenge::RVNGPropertyList props;
-  fillCharPropList(m_paraStyleStack, m_langManager, props);
+  const IWORKLanguageManager &langManager = m_langManager;
+  const librevenge::RVNGPropertyList &props = resolvePropList(m_spanPropLists, [&langManager](const IWORKStyleStack &styleStack, RVNGPropertyList &propList)
+  {
+    fillCharPropList(styleStack, langManager, propList);
+  });
   m_paraStyleStack.pop();
   m_paraStyleStack.pop();
   m_paraStyleStack.pop();
@@ -1068,6 +1074,21 @@ void IWORKText::closeSpan()
   m_inSpan = false;
 }
 
+const librevenge::RVNGPropertyList &IWORKText::resolvePropList(PropListCache_t &cache, const PropListFiller_t &fill)
+{
+  // Texts usually use just a few combinations of styles, but many times.
+  m_paraStyleStack.getKey(m_styleKey);
+  const auto it = cache.find(m_styleKey);
+  if (it != cache.end())
+    return it->second;
+
+  if (cache.size() >= 1024)
+    cache.clear();
+  RVNGPropertyList &props = cache[m_styleKey];
+  fill(m_paraStyleStack, props);
+  return props;
+}
+
 bool IWORKText::needsSection() const
 {
   if (!m_checkedSection)
@@ -13,7 +13,9 @@
 #include "IWORKText_fwd.h"
 
 #include <deque>
+#include <functional>
 #include <stack>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 
@@ -104,6 +106,13 @@ private:
   void openSpan();
   void closeSpan();
 
+private:
+  /// Property lists resolved from combinations of styles.
+  typedef std::unordered_map<IWORKStyleStack::Key_t, librevenge::RVNGPropertyList, IWORKStyleStack::KeyHash> PropListCache_t;
+  typedef std::function<void(const IWORKStyleStack &, librevenge::RVNGPropertyList &)> PropListFiller_t;
+
+  const librevenge::RVNGPropertyList &resolvePropList(PropListCache_t &cache, const PropListFiller_t &fill);
+
 private:
   const IWORKLanguageManager &m_langManager;
 
@@ -143,6 +152,10 @@ private:
 
   IWORKStylePtr_t m_oldSpanStyle;
 
+  PropListCache_t m_paraPropLists;
+  PropListCache_t m_spanPropLists;
+  IWORKStyleStack::Key_t m_styleKey;
+
   std::shared_ptr<IWORKTextRecorder> m_recorder;
 };
 
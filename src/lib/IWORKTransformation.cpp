@@ -44,6 +44,24 @@ glm::dmat3 makeTransformation(const IWORKGeometry &geometry)
   return tr;
 }
 
+void transformPoints(const glm::dmat3 &tr, const std::size_t count, const double *const xs, const double *const ys, double *const outXs, double *const outYs)
+{
+  // only the affine part is used, the same as when multiplying (x, y, 1)
+  const double xx = tr[0][0];
+  const double xy = tr[1][0];
+  const double x0 = tr[2][0];
+  const double yx = tr[0][1];
+  const double yy = tr[1][1];
+  const double y0 = tr[2][1];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double x = xs[i];
+    const double y = ys[i];
+    outXs[i] = xx * x + xy * y + x0;
+    outYs[i] = yx * x + yy * y + y0;
+  }
+}
+
 namespace transformations
 {
 
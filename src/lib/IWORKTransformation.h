@@ -11,6 +11,7 @@
 #define IWORKTRANSFORMATION_H_INCLUDED
 
 #include <cassert>
+#include <cstddef>
 
 #include <glm/glm.hpp>
 
@@ -28,6 +29,21 @@ struct IWORKGeometry;
   */
 glm::dmat3 makeTransformation(const IWORKGeometry &geometry);
 
+/** Transform a sequence of points.
+  *
+  * The coordinates are passed in separate arrays, so the transformation
+  * is a simple loop that can be vectorized. The output arrays may be
+  * the same as the input ones.
+  *
+  * @arg[in] tr the transformation
+  * @arg[in] count the number of points
+  * @arg[in] xs the x coordinates of the points
+  * @arg[in] ys the y coordinates of the points
+  * @arg[out] outXs the transformed x coordinates
+  * @arg[out] outYs the transformed y coordinates
+  */
+void transformPoints(const glm::dmat3 &tr, std::size_t count, const double *xs, const double *ys, double *outXs, double *outYs);
+
 /// Special transformation constructors.
 namespace transformations
 {
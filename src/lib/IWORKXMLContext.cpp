@@ -7,6 +7,8 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <cstddef>
+
 #include "libetonyek_xml.h"
 
 #include "IWORKXMLContext.h"
@@ -14,6 +16,134 @@
 namespace libetonyek
 {
 
+namespace
+{
+
+const std::size_t POOL_GRANULARITY = 16;
+const std::size_t POOL_CLASSES = 32; // blocks of up to 512 bytes are pooled
+const std::size_t POOL_MAX_FREE = 256; // free blocks kept per size class
+
+struct FreeBlock
+{
+  FreeBlock *m_next;
+};
+
+/// Lists of freed context memory of one thread, by size class.
+class ContextPool
+{
+  // disable copying
+  ContextPool(const ContextPool &);
+  ContextPool &operator=(const ContextPool &);
+
+public:
+  ContextPool();
+  ~ContextPool();
+
+  void *allocate(std::size_t size);
+  void release(void *block, std::size_t size);
+
+#ifdef DEBUG
+  IWORKXMLContextAllocationStats m_stats;
+#endif
+
+private:
+  FreeBlock *m_freeBlocks[POOL_CLASSES];
+  std::size_t m_freeCounts[POOL_CLASSES];
+};
+
+ContextPool::ContextPool()
+#ifdef DEBUG
+  : m_stats()
+  , m_freeBlocks()
+#else
+  : m_freeBlocks()
+#endif
+  , m_freeCounts()
+{
+}
+
+ContextPool::~ContextPool()
+{
+  for (FreeBlock *block : m_freeBlocks)
+  {
+    while (block)
+    {
+      FreeBlock *const next = block->m_next;
+      ::operator delete(block);
+      block = next;
+    }
+  }
+}
+
+void *ContextPool::allocate(const std::size_t size)
+{
+  ETONYEK_DEBUG(++m_stats.m_allocations);
+  const std::size_t sizeClass = (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY;
+  if ((sizeClass > 0) && (sizeClass <= POOL_CLASSES))
+  {
+    FreeBlock *&freeBlocks = m_freeBlocks[sizeClass - 1];
+    if (freeBlocks)
+    {
+      FreeBlock *const block = freeBlocks;
+      freeBlocks = block->m_next;
+      --m_freeCounts[sizeClass - 1];
+      return block;
+    }
+    ETONYEK_DEBUG(++m_stats.m_heapAllocations);
+    return ::operator new(sizeClass * POOL_GRANULARITY);
+  }
+  ETONYEK_DEBUG(++m_stats.m_heapAllocations);
+  return ::operator new(size);
+}
+
+void ContextPool::release(void *const block, const std::size_t size)
+{
+  const std::size_t sizeClass = (size + POOL_GRANULARITY - 1) / POOL_GRANULARITY;
+  if ((sizeClass > 0) && (sizeClass <= POOL_CLASSES) && (m_freeCounts[sizeClass - 1] < POOL_MAX_FREE))
+  {
+    FreeBlock *const freeBlock = static_cast<FreeBlock *>(block);
+    freeBlock->m_next = m_freeBlocks[sizeClass - 1];
+    m_freeBlocks[sizeClass - 1] = freeBlock;
+    ++m_freeCounts[sizeClass - 1];
+  }
+  else
+  {
+    ::operator delete(block);
+  }
+}
+
+ContextPool &getContextPool()
+{
+  // a block freed on another thread just goes to that thread's lists
+  thread_local ContextPool pool;
+  return pool;
+}
+
+}
+
+void *allocateContextMemory(const std::size_t size)
+{
+  return getContextPool().allocate(size);
+}
+
+void releaseContextMemory(void *const block, const std::size_t size)
+{
+  getContextPool().release(block, size);
+}
+
+#ifdef DEBUG
+IWORKXMLContextAllocationStats::IWORKXMLContextAllocationStats()
+  : m_allocations(0)
+  , m_heapAllocations(0)
+{
+}
+
+IWORKXMLContextAllocationStats getContextAllocationStats()
+{
+  return getContextPool().m_stats;
+}
+#endif
+
 IWORKXMLContext::~IWORKXMLContext()
 {
 }
@@ -23,6 +153,11 @@ void IWORKXMLContext::CDATA(const char */*value*/)
   ETONYEK_DEBUG_MSG(("IWORKXMLContext::cData: find unexpected CDATA block\n"));
 }
 
+bool IWORKXMLContext::skipContent() const
+{
+  return false;
+}
+
 }
 
 /* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -10,7 +10,9 @@
 #ifndef IWORKXMLCONTEXT_H_INCLUDED
 #define IWORKXMLCONTEXT_H_INCLUDED
 
+#include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace libetonyek
 {
@@ -56,11 +58,102 @@ public:
     */
   virtual void CDATA(const char *value);
 
+  /** Check whether the content of the element can be skipped.
+    *
+    * This is called after all attributes have been processed. If it
+    * returns true, the parser skips child elements and text of the
+    * element, without tokenizing or copying them, and continues with
+    * endOfElement().
+    *
+    * The default implementation returns false.
+    */
+  virtual bool skipContent() const;
+
   /** Signalize the end of an element.
     */
   virtual void endOfElement() = 0;
 };
 
+/** Get memory for a context.
+  *
+  * A context only lives while its element is parsed, so freed blocks
+  * are kept in per-thread free lists, by size, and handed out again.
+  *
+  * @arg[in] size the size of the block
+  * @return the block
+  */
+void *allocateContextMemory(std::size_t size);
+
+/** Return memory got from allocateContextMemory().
+  *
+  * @arg[in] block the block
+  * @arg[in] size the size the block was allocated with
+  */
+void releaseContextMemory(void *block, std::size_t size);
+
+#ifdef DEBUG
+/// Counts of context allocations on the current thread.
+struct IWORKXMLContextAllocationStats
+{
+  IWORKXMLContextAllocationStats();
+
+  unsigned long m_allocations;
+  unsigned long m_heapAllocations;
+};
+
+IWORKXMLContextAllocationStats getContextAllocationStats();
+#endif
+
+/// An allocator that takes its memory from allocateContextMemory().
+template<typename T>
+class IWORKXMLContextAllocator
+{
+public:
+  typedef T value_type;
+
+  IWORKXMLContextAllocator()
+  {
+  }
+
+  template<typename U>
+  IWORKXMLContextAllocator(const IWORKXMLContextAllocator<U> &)
+  {
+  }
+
+  T *allocate(const std::size_t n)
+  {
+    return static_cast<T *>(allocateContextMemory(n * sizeof(T)));
+  }
+
+  void deallocate(T *const p, const std::size_t n)
+  {
+    releaseContextMemory(p, n * sizeof(T));
+  }
+};
+
+template<typename T, typename U>
+bool operator==(const IWORKXMLContextAllocator<T> &, const IWORKXMLContextAllocator<U> &)
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const IWORKXMLContextAllocator<T> &, const IWORKXMLContextAllocator<U> &)
+{
+  return false;
+}
+
+/** Create a context, like std::make_shared, with pooled memory.
+  *
+  * The object and its reference count are allocated together with
+  * IWORKXMLContextAllocator.
+  */
+template<class T, typename... Args>
+std::shared_ptr<T> allocateContext(Args &&... args)
+{
+  return std::allocate_shared<T>(IWORKXMLContextAllocator<T>(), std::forward<Args>(args)...);
+}
+
 }
 
 #endif // IWORKXMLCONTEXT_H_INCLUDED
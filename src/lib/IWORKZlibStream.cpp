@@ -9,6 +9,7 @@
 
 #include "IWORKZlibStream.h"
 
+#include <utility>
 #include <vector>
 
 #include <zlib.h>
@@ -101,7 +102,8 @@ RVNGInputStreamPtr_t getInflatedStream(const RVNGInputStreamPtr_t &input)
 
     (void)inflateEnd(&strm);
 
-    return RVNGInputStreamPtr_t(new IWORKMemoryStream(&data[0], (unsigned) strm.total_out));
+    data.resize(strm.total_out);
+    return RVNGInputStreamPtr_t(new IWORKMemoryStream(std::move(data)));
   }
 }
 
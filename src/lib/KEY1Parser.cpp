@@ -19,6 +19,7 @@
 #include "IWORKDiscardContext.h"
 #include "IWORKProperties.h"
 #include "IWORKRecorder.h"
+#include "IWORKSkipContext.h"
 #include "IWORKText.h"
 #include "IWORKTokenizer.h"
 #include "KEYCollector.h"
@@ -348,12 +349,12 @@ IWORKXMLContextPtr_t BulletElement::element(const int name)
   switch (name)
   {
   case KEY1Token::character_bullet_style | KEY1Token::NS_URI_KEY :
-    return std::make_shared<BulletCharacterStyleElement>(getState());
+    return allocateContext<BulletCharacterStyleElement>(getState());
   case KEY1Token::image_bullet_style | KEY1Token::NS_URI_KEY : // README
   case KEY1Token::sequence_bullet_style | KEY1Token::NS_URI_KEY : // README
     break;
   case KEY1Token::content | KEY1Token::NS_URI_KEY :
-    return std::make_shared<KEY1ContentElement>(getState());
+    return allocateContext<KEY1ContentElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("BulletElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -412,7 +413,7 @@ IWORKXMLContextPtr_t BulletsElement::element(const int name)
   switch (name)
   {
   case KEY1Token::bullet | KEY1Token::NS_URI_KEY :
-    return std::make_shared<BulletElement>(getState());
+    return allocateContext<BulletElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("BulletsElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -494,7 +495,7 @@ IWORKXMLContextPtr_t BasicShapeElement::element(const int name)
   switch (name)
   {
   case KEY1Token::styles | KEY1Token::NS_URI_KEY :
-    return std::make_shared<KEY1StylesContext>(getState(), m_style, IWORKStylePtr_t());
+    return allocateContext<KEY1StylesContext>(getState(), m_style, IWORKStylePtr_t());
   default :
     ETONYEK_DEBUG_MSG(("BasicShapeElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -930,7 +931,7 @@ IWORKXMLContextPtr_t PlaceholderElement::element(const int name)
   switch (name)
   {
   case KEY1Token::text_attributes | KEY1Token::NS_URI_KEY :
-    return std::make_shared<TextAttributesElement>(getState(), m_spanStyle, m_paragraphStyle);
+    return allocateContext<TextAttributesElement>(getState(), m_spanStyle, m_paragraphStyle);
   default:
     break;
   }
@@ -1118,7 +1119,7 @@ IWORKXMLContextPtr_t TextboxElement::element(const int name)
   switch (name)
   {
   case KEY1Token::content | KEY1Token::NS_URI_KEY :
-    return std::make_shared<KEY1ContentElement>(getState());
+    return allocateContext<KEY1ContentElement>(getState());
   default:
     break;
   }
@@ -1214,7 +1215,7 @@ IWORKXMLContextPtr_t PluginDataElement::element(const int name)
   case KEY1Token::string  | KEY1Token::NS_URI_KEY : // with value dictionary, root
     break;
   case KEY1Token::table  | KEY1Token::NS_URI_KEY :
-    return std::make_shared<KEY1TableElement>(getState(), m_size);
+    return allocateContext<KEY1TableElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("PluginDataElement::element[KEY1Parser.cpp]: unknown element\n"));
   }
@@ -1276,9 +1277,9 @@ IWORKXMLContextPtr_t PluginElement::element(const int name)
   switch (name)
   {
   case KEY1Token::plugin_data  | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginDataElement>(getState(), m_size, false);
+    return allocateContext<PluginDataElement>(getState(), m_size, false);
   case KEY1Token::prototype_data  | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginDataElement>(getState(), m_size, true);
+    return allocateContext<PluginDataElement>(getState(), m_size, true);
   default :
     return BasicShapeElement::element(name);
   }
@@ -1349,19 +1350,19 @@ IWORKXMLContextPtr_t GroupElement::element(const int name)
   switch (name)
   {
   case KEY1Token::g | KEY1Token::NS_URI_KEY :
-    return std::make_shared<GroupElement>(getState());
+    return allocateContext<GroupElement>(getState());
   case KEY1Token::image | KEY1Token::NS_URI_KEY :
-    return std::make_shared<ImageElement>(getState());
+    return allocateContext<ImageElement>(getState());
   case KEY1Token::line | KEY1Token::NS_URI_KEY :
-    return std::make_shared<LineElement>(getState());
+    return allocateContext<LineElement>(getState());
   case KEY1Token::page_number | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PageNumberElement>(getState());
+    return allocateContext<PageNumberElement>(getState());
   case KEY1Token::plugin | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginElement>(getState());
+    return allocateContext<PluginElement>(getState());
   case KEY1Token::shape | KEY1Token::NS_URI_KEY :
-    return std::make_shared<ShapeElement>(getState());
+    return allocateContext<ShapeElement>(getState());
   case KEY1Token::textbox | KEY1Token::NS_URI_KEY :
-    return std::make_shared<TextboxElement>(getState());
+    return allocateContext<TextboxElement>(getState());
   default :
     return BasicShapeElement::element(name);
   }
@@ -1404,23 +1405,23 @@ IWORKXMLContextPtr_t DrawablesElement::element(const int name)
   switch (name)
   {
   case KEY1Token::body | KEY1Token::NS_URI_KEY :
-    return std::make_shared<BodyElement>(getState());
+    return allocateContext<BodyElement>(getState());
   case KEY1Token::g | KEY1Token::NS_URI_KEY :
-    return std::make_shared<GroupElement>(getState());
+    return allocateContext<GroupElement>(getState());
   case KEY1Token::image | KEY1Token::NS_URI_KEY :
-    return std::make_shared<ImageElement>(getState());
+    return allocateContext<ImageElement>(getState());
   case KEY1Token::line | KEY1Token::NS_URI_KEY :
-    return std::make_shared<LineElement>(getState());
+    return allocateContext<LineElement>(getState());
   case KEY1Token::page_number | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PageNumberElement>(getState());
+    return allocateContext<PageNumberElement>(getState());
   case KEY1Token::plugin | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginElement>(getState());
+    return allocateContext<PluginElement>(getState());
   case KEY1Token::shape | KEY1Token::NS_URI_KEY :
-    return std::make_shared<ShapeElement>(getState());
+    return allocateContext<ShapeElement>(getState());
   case KEY1Token::textbox | KEY1Token::NS_URI_KEY :
-    return std::make_shared<TextboxElement>(getState());
+    return allocateContext<TextboxElement>(getState());
   case KEY1Token::title | KEY1Token::NS_URI_KEY :
-    return std::make_shared<TitleElement>(getState());
+    return allocateContext<TitleElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("DrawablesElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -1471,7 +1472,7 @@ IWORKXMLContextPtr_t PluginsElement::element(const int name)
   switch (name)
   {
   case KEY1Token::prototype_plugin | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginElement>(getState());
+    return allocateContext<PluginElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("PluginsElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -1565,25 +1566,25 @@ IWORKXMLContextPtr_t SlideElement::element(const int name)
   switch (name)
   {
   case KEY1Token::bullets | KEY1Token::NS_URI_KEY :
-    return std::make_shared<BulletsElement>(getState(), false);
+    return allocateContext<BulletsElement>(getState(), false);
   case KEY1Token::drawables | KEY1Token::NS_URI_KEY :
-    return std::make_shared<DrawablesElement>(getState(), false);
+    return allocateContext<DrawablesElement>(getState(), false);
   case KEY1Token::guides | KEY1Token::NS_URI_KEY : // list of guide, safe to ignore?
     break;
   case KEY1Token::notes | KEY1Token::NS_URI_KEY :
-    return std::make_shared<CDATAElement>(getState(), m_notes);
+    return allocateContext<CDATAElement>(getState(), m_notes);
   case KEY1Token::prototype_bullets | KEY1Token::NS_URI_KEY :
-    return std::make_shared<BulletsElement>(getState(), true);
+    return allocateContext<BulletsElement>(getState(), true);
   case KEY1Token::prototype_drawables | KEY1Token::NS_URI_KEY :
-    return std::make_shared<DrawablesElement>(getState(), true);
+    return allocateContext<DrawablesElement>(getState(), true);
   case KEY1Token::prototype_plugins | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginsElement>(getState(), true);
+    return allocateContext<PluginsElement>(getState(), true);
   case KEY1Token::background_fill_style | KEY1Token::NS_URI_KEY :
-    return std::make_shared<KEY1FillElement>(getState(), m_background);
+    return allocateContext<KEY1FillElement>(getState(), m_background);
   case KEY1Token::transition_style | KEY1Token::NS_URI_KEY :
-    return std::make_shared<TransitionStyleElement>(getState());
+    return allocateContext<TransitionStyleElement>(getState());
   case KEY1Token::thumbnails | KEY1Token::NS_URI_KEY : // ok to ignore
-    break;
+    return allocateContext<IWORKSkipContext>();
   default :
     ETONYEK_DEBUG_MSG(("SlideElement::element[KEY1Parser.cpp]: unknown element\n"));
     break;
@@ -1694,7 +1695,7 @@ IWORKXMLContextPtr_t SlideListElement::element(const int name)
   switch (name)
   {
   case KEY1Token::slide | KEY1Token::NS_URI_KEY :
-    return std::make_shared<SlideElement>(getState(), false);
+    return allocateContext<SlideElement>(getState(), false);
   default :
     ETONYEK_DEBUG_MSG(("SlideListElement::element[KEY1Parser.cpp]: unexpected element\n"));
     break;
@@ -1741,7 +1742,7 @@ IWORKXMLContextPtr_t MasterSlidesElement::element(const int name)
   switch (name)
   {
   case KEY1Token::master_slide | KEY1Token::NS_URI_KEY :
-    return std::make_shared<SlideElement>(getState(), true);
+    return allocateContext<SlideElement>(getState(), true);
   default :
     ETONYEK_DEBUG_MSG(("MasterSlidesElement::element[KEY1Parser.cpp]: unexpected element\n"));
     break;
@@ -1800,13 +1801,13 @@ IWORKXMLContextPtr_t ThemeElement::element(const int name)
   switch (name)
   {
   case KEY1Token::description | KEY1Token::NS_URI_KEY :
-    return std::make_shared<CDATAElement>(getState(), m_description);
+    return allocateContext<CDATAElement>(getState(), m_description);
   case KEY1Token::prototype_drawables | KEY1Token::NS_URI_KEY :
-    return std::make_shared<DrawablesElement>(getState(), true);
+    return allocateContext<DrawablesElement>(getState(), true);
   case KEY1Token::prototype_plugins | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PluginsElement>(getState(), true);
+    return allocateContext<PluginsElement>(getState(), true);
   case KEY1Token::master_slides | KEY1Token::NS_URI_KEY :
-    return std::make_shared<MasterSlidesElement>(getState());
+    return allocateContext<MasterSlidesElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("ThemeElement::element[KEY1Parser.cpp]: unexpected element\n"));
     break;
@@ -1863,13 +1864,13 @@ IWORKXMLContextPtr_t PresentationElement::element(const int name)
   switch (name)
   {
   case KEY1Token::metadata | KEY1Token::NS_URI_KEY :
-    return std::make_shared<MetadataElement>(getState());
+    return allocateContext<MetadataElement>(getState());
   case KEY1Token::theme | KEY1Token::NS_URI_KEY :
-    return std::make_shared<ThemeElement>(getState());
+    return allocateContext<ThemeElement>(getState());
   case KEY1Token::slide_list | KEY1Token::NS_URI_KEY :
-    return std::make_shared<SlideListElement>(getState());
+    return allocateContext<SlideListElement>(getState());
   case KEY1Token::ui_state | KEY1Token::NS_URI_KEY : // safe to ignore
-    break;
+    return allocateContext<IWORKSkipContext>();
   default :
     ETONYEK_DEBUG_MSG(("PresentationElement::element[KEY1Parser.cpp]: unexpected element\n"));
     break;
@@ -1911,7 +1912,7 @@ IWORKXMLContextPtr_t XMLDocument::element(const int name)
   switch (name)
   {
   case KEY1Token::presentation | KEY1Token::NS_URI_KEY :
-    return std::make_shared<PresentationElement>(m_state);
+    return allocateContext<PresentationElement>(m_state);
   default:
     ETONYEK_DEBUG_MSG(("XMLDocument::element[KEY1Parser.cpp]: unexpected element\n"));
     break;
@@ -1971,7 +1972,7 @@ IWORKXMLContextPtr_t KEY1Parser::createDocumentContext()
 
 IWORKXMLContextPtr_t KEY1Parser::createDiscardContext()
 {
-  return std::make_shared<DiscardContext>(m_state);
+  return allocateContext<DiscardContext>(m_state);
 }
 
 const IWORKTokenizer &KEY1Parser::getTokenizer() const
@@ -26,6 +26,7 @@
 #include "IWORKRefContext.h"
 #include "IWORKShapeContext.h"
 #include "IWORKSizeElement.h"
+#include "IWORKSkipContext.h"
 #include "IWORKStringElement.h"
 #include "IWORKStyle.h"
 #include "IWORKStyleContainer.h"
@@ -103,7 +104,7 @@ StringContentContext::StringContentContext(KEY2ParserState &state, optional<stri
 IWORKXMLContextPtr_t StringContentContext::element(const int name)
 {
   if (name == (KEY2Token::NS_URI_KEY | KEY2Token::string))
-    return std::make_shared<IWORKStringElement>(getState(), m_value);
+    return allocateContext<IWORKStringElement>(getState(), m_value);
   return IWORKXMLContextPtr_t();
 }
 
@@ -142,13 +143,13 @@ IWORKXMLContextPtr_t MetadataElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::authors :
-    return std::make_shared<StringContentContext>(getState(), m_author);
+    return allocateContext<StringContentContext>(getState(), m_author);
   case KEY2Token::NS_URI_KEY | KEY2Token::comment :
-    return std::make_shared<StringContentContext>(getState(), m_comment);
+    return allocateContext<StringContentContext>(getState(), m_comment);
   case KEY2Token::NS_URI_KEY | KEY2Token::keywords :
-    return std::make_shared<StringContentContext>(getState(), m_keywords);
+    return allocateContext<StringContentContext>(getState(), m_keywords);
   case KEY2Token::NS_URI_KEY | KEY2Token::title :
-    return std::make_shared<StringContentContext>(getState(), m_title);
+    return allocateContext<StringContentContext>(getState(), m_title);
   default:
     break;
   }
@@ -197,10 +198,10 @@ IWORKXMLContextPtr_t StylesContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::placeholder_style :
-    return std::make_shared<IWORKStyleContext>(getState(), &getState().getDictionary().m_placeholderStyles);
+    return allocateContext<IWORKStyleContext>(getState(), &getState().getDictionary().m_placeholderStyles);
   case KEY2Token::NS_URI_KEY | KEY2Token::slide_style : // v5
   case IWORKToken::NS_URI_SF | IWORKToken::slide_style : // v2-v4
-    return std::make_shared<KEY2StyleContext>(getState(), &getState().getDictionary().m_slideStyles);
+    return allocateContext<KEY2StyleContext>(getState(), &getState().getDictionary().m_slideStyles);
   default:
     break;
   }
@@ -237,11 +238,11 @@ IWORKXMLContextPtr_t StylesheetElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::styles :
-    return std::make_shared<StylesContext>(getState(), false);
+    return allocateContext<StylesContext>(getState(), false);
   case IWORKToken::NS_URI_SF | IWORKToken::anon_styles :
-    return std::make_shared<StylesContext>(getState(), true);
+    return allocateContext<StylesContext>(getState(), true);
   case IWORKToken::NS_URI_SF | IWORKToken::parent_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_parent);
+    return allocateContext<IWORKRefContext>(getState(), m_parent);
   default:
     break;
   }
@@ -292,7 +293,7 @@ IWORKXMLContextPtr_t ProxyMasterLayerElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::layer_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   default:
     break;
   }
@@ -389,11 +390,11 @@ IWORKXMLContextPtr_t ConnectionLineElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::path :
-    return std::make_shared<IWORKPathElement>(getState());
+    return allocateContext<IWORKPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::style :
-    return std::make_shared<ConnectionStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
+    return allocateContext<ConnectionStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
   default:
     break;
   }
@@ -477,9 +478,9 @@ IWORKXMLContextPtr_t HeadlineElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::style_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::text :
-    return std::make_shared<IWORKTextElement>(getState());
+    return allocateContext<IWORKTextElement>(getState());
   default:
     ETONYEK_DEBUG_MSG(("HeadlineElement::element[KEY2Parser.cpp]: unknown element\n"));
     break;
@@ -552,13 +553,13 @@ IWORKXMLContextPtr_t StickyNoteElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::path : // use me
-    return std::make_shared<IWORKPathElement>(getState());
+    return allocateContext<IWORKPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::style : // use me
-    return std::make_shared<GraphicStyleContext>(getState(), m_graphicStyle, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_graphicStyle, getState().getDictionary().m_graphicStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::text :
-    return std::make_shared<IWORKTextElement>(getState());
+    return allocateContext<IWORKTextElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::wrap : // README
     return IWORKXMLContextPtr_t();
   default:
@@ -619,7 +620,7 @@ IWORKXMLContextPtr_t BulletsElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::headline :
-    return std::make_shared<HeadlineElement>(getState());
+    return allocateContext<HeadlineElement>(getState());
   default:
     break;
   }
@@ -674,30 +675,30 @@ IWORKXMLContextPtr_t DrawablesElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::body_placeholder_ref :
   case KEY2Token::NS_URI_KEY | KEY2Token::body_placeholder_ref :
-    return std::make_shared<PlaceholderRefContext>(getState(), PLACEHOLDER_BODY);
+    return allocateContext<PlaceholderRefContext>(getState(), PLACEHOLDER_BODY);
   case IWORKToken::NS_URI_SF | IWORKToken::connection_line :
-    return std::make_shared<ConnectionLineElement>(getState());
+    return allocateContext<ConnectionLineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::group :
-    return std::make_shared<IWORKGroupElement>(getState());
+    return allocateContext<IWORKGroupElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::image :
-    return std::make_shared<IWORKImageElement>(getState());
+    return allocateContext<IWORKImageElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::line :
-    return std::make_shared<IWORKLineElement>(getState());
+    return allocateContext<IWORKLineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::media :
-    return std::make_shared<IWORKMediaElement>(getState());
+    return allocateContext<IWORKMediaElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::shape :
-    return std::make_shared<IWORKShapeContext>(getState());
+    return allocateContext<IWORKShapeContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::sticky_note :
-    return std::make_shared<StickyNoteElement>(getState());
+    return allocateContext<StickyNoteElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::table_info :
-    return std::make_shared<IWORKTableInfoElement>(getState());
+    return allocateContext<IWORKTableInfoElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tabular_info :
-    return std::make_shared<IWORKTabularInfoElement>(getState());
+    return allocateContext<IWORKTabularInfoElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::title_placeholder_ref :
   case KEY2Token::NS_URI_KEY | KEY2Token::title_placeholder_ref :
-    return std::make_shared<PlaceholderRefContext>(getState(), PLACEHOLDER_TITLE);
+    return allocateContext<PlaceholderRefContext>(getState(), PLACEHOLDER_TITLE);
   case KEY2Token::NS_URI_KEY | KEY2Token::sticky_note :
-    return std::make_shared<StickyNoteElement>(getState());
+    return allocateContext<StickyNoteElement>(getState());
   default:
     break;
   }
@@ -743,7 +744,7 @@ IWORKXMLContextPtr_t LayerElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::drawables :
-    return std::make_shared<DrawablesElement>(getState());
+    return allocateContext<DrawablesElement>(getState());
   default:
     break;
   }
@@ -790,9 +791,9 @@ IWORKXMLContextPtr_t LayersElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::layer :
-    return std::make_shared<LayerElement>(getState());
+    return allocateContext<LayerElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::proxy_master_layer :
-    return std::make_shared<ProxyMasterLayerElement>(getState());
+    return allocateContext<ProxyMasterLayerElement>(getState());
   default:
     break;
   }
@@ -830,9 +831,9 @@ IWORKXMLContextPtr_t PageElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   case IWORKToken::NS_URI_SF | IWORKToken::layers :
-    return std::make_shared<LayersElement>(getState());
+    return allocateContext<LayersElement>(getState());
   default:
     break;
   }
@@ -870,7 +871,7 @@ StyleElement::StyleElement(KEY2ParserState &state, optional<ID_t> &ref)
 IWORKXMLContextPtr_t StyleElement::element(const int name)
 {
   if ((IWORKToken::NS_URI_SF | IWORKToken::placeholder_style_ref) == name)
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
 
   return IWORKXMLContextPtr_t();
 }
@@ -922,9 +923,9 @@ IWORKXMLContextPtr_t PlaceholderContext::element(const int name)
     // ignore; the real geometry comes from style
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::style :
-    return std::make_shared<StyleElement>(getState(), m_styleRef);
+    return allocateContext<StyleElement>(getState(), m_styleRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::text :
-    return std::make_shared<IWORKTextElement>(getState());
+    return allocateContext<IWORKTextElement>(getState());
   default:
     break;
   }
@@ -994,7 +995,7 @@ IWORKXMLContextPtr_t NotesElement::element(const int name)
   switch (name)
   {
   case IWORKToken::text_storage | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKTextStorageElement>(getState());
+    return allocateContext<IWORKTextStorageElement>(getState());
   default:
     break;
   }
@@ -1036,7 +1037,7 @@ IWORKXMLContextPtr_t StickyNotesElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::sticky_note :
-    return std::make_shared<StickyNoteElement>(getState());
+    return allocateContext<StickyNoteElement>(getState());
   default:
     break;
   }
@@ -1121,27 +1122,29 @@ IWORKXMLContextPtr_t SlideElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::bullets :
-    return std::make_shared<BulletsElement>(getState(), m_bodyText, m_titleText);
+    return allocateContext<BulletsElement>(getState(), m_bodyText, m_titleText);
   case KEY2Token::NS_URI_KEY | KEY2Token::notes :
-    return std::make_shared<NotesElement>(getState());
+    return allocateContext<NotesElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::page :
-    return std::make_shared<PageElement>(getState());
+    return allocateContext<PageElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::master_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_masterRef);
+    return allocateContext<IWORKRefContext>(getState(), m_masterRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::sticky_notes :
-    return std::make_shared<StickyNotesElement>(getState());
+    return allocateContext<StickyNotesElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::style_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::body_placeholder :
-    return std::make_shared<PlaceholderContext>(getState(), PLACEHOLDER_BODY, m_bodyRef);
+    return allocateContext<PlaceholderContext>(getState(), PLACEHOLDER_BODY, m_bodyRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::object_placeholder :
-    return std::make_shared<PlaceholderContext>(getState(), PLACEHOLDER_OBJECT, m_objectRef);
+    return allocateContext<PlaceholderContext>(getState(), PLACEHOLDER_OBJECT, m_objectRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::slide_number_placeholder :
-    return std::make_shared<PlaceholderContext>(getState(), PLACEHOLDER_SLIDENUMBER, m_slidenumberRef);
+    return allocateContext<PlaceholderContext>(getState(), PLACEHOLDER_SLIDENUMBER, m_slidenumberRef);
   case KEY2Token::NS_URI_KEY | KEY2Token::title_placeholder :
-    return std::make_shared<PlaceholderContext>(getState(), PLACEHOLDER_TITLE, m_titleRef);
+    return allocateContext<PlaceholderContext>(getState(), PLACEHOLDER_TITLE, m_titleRef);
+  case KEY2Token::NS_URI_KEY | KEY2Token::thumbnails : // ok to ignore
+    return allocateContext<IWORKSkipContext>();
   default:
     break;
   }
@@ -1269,7 +1272,7 @@ IWORKXMLContextPtr_t SlideListElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::slide :
-    return std::make_shared<SlideElement>(getState(), false);
+    return allocateContext<SlideElement>(getState(), false);
   default:
     break;
   }
@@ -1315,7 +1318,7 @@ IWORKXMLContextPtr_t MasterSlidesElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::master_slide :
-    return std::make_shared<SlideElement>(getState(), true);
+    return allocateContext<SlideElement>(getState(), true);
   default:
     break;
   }
@@ -1357,11 +1360,11 @@ IWORKXMLContextPtr_t ThemeElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   case KEY2Token::NS_URI_KEY | KEY2Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::master_slides :
-    return std::make_shared<MasterSlidesElement>(getState());
+    return allocateContext<MasterSlidesElement>(getState());
   default:
     break;
   }
@@ -1401,7 +1404,7 @@ IWORKXMLContextPtr_t ThemeListElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::theme :
-    return std::make_shared<ThemeElement>(getState());
+    return allocateContext<ThemeElement>(getState());
   default:
     break;
   }
@@ -1482,14 +1485,16 @@ IWORKXMLContextPtr_t PresentationElement::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::metadata :
-    return std::make_shared<MetadataElement>(getState());
+    return allocateContext<MetadataElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::theme_list :
-    return std::make_shared<ThemeListElement>(getState());
+    return allocateContext<ThemeListElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::slide_list :
-    return std::make_shared<SlideListElement>(getState());
+    return allocateContext<SlideListElement>(getState());
   case KEY2Token::NS_URI_KEY | KEY2Token::size :
     m_pendingSize = true;
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
+  case KEY2Token::NS_URI_KEY | KEY2Token::ui_state : // safe to ignore
+    return allocateContext<IWORKSkipContext>();
   default:
     break;
   }
@@ -1530,7 +1535,7 @@ IWORKXMLContextPtr_t XMLDocument::element(const int name)
   switch (name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::presentation :
-    return std::make_shared<PresentationElement>(m_state);
+    return allocateContext<PresentationElement>(m_state);
   default:
     break;
   }
@@ -1575,10 +1580,10 @@ IWORKXMLContextPtr_t DiscardContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::placeholder_style :
-    return std::make_shared<IWORKStyleContext>(getState(), &getState().getDictionary().m_placeholderStyles);
+    return allocateContext<IWORKStyleContext>(getState(), &getState().getDictionary().m_placeholderStyles);
   case KEY2Token::NS_URI_KEY | KEY2Token::slide_style : // v5
   case IWORKToken::NS_URI_SF | IWORKToken::slide_style : // v2-v4
-    return std::make_shared<KEY2StyleContext>(getState(), &getState().getDictionary().m_slideStyles);
+    return allocateContext<KEY2StyleContext>(getState(), &getState().getDictionary().m_slideStyles);
   case KEY2Token::NS_URI_KEY | KEY2Token::stylesheet :
     if (!m_savedStylesheet)
     {
@@ -1586,7 +1591,7 @@ IWORKXMLContextPtr_t DiscardContext::element(const int name)
       m_savedStylesheet = m_state.m_stylesheet;
       m_state.m_stylesheet.reset();
     }
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   default:
     break;
   }
@@ -1613,7 +1618,7 @@ IWORKXMLContextPtr_t KEY2Parser::createDocumentContext()
 
 IWORKXMLContextPtr_t KEY2Parser::createDiscardContext()
 {
-  return std::make_shared<DiscardContext>(m_state);
+  return allocateContext<DiscardContext>(m_state);
 }
 
 const IWORKTokenizer &KEY2Parser::getTokenizer() const
@@ -82,9 +82,11 @@ enum
   text,
   theme,
   theme_list,
+  thumbnails,
   title,
   title_placeholder,
   title_placeholder_ref,
+  ui_state,
 
   // attributes
   depth,
@@ -15,6 +15,7 @@
 
 #include "IWAMessage.h"
 #include "IWAObjectType.h"
+#include "IWORKOutputElements.h"
 #include "IWORKProperties.h"
 #include "IWORKText.h"
 #include "KEY6ObjectType.h"
@@ -38,7 +39,6 @@ KEY6Parser::KEY6Parser(const RVNGInputStreamPtr_t &fragments, const RVNGInputStr
   : IWAParser(fragments, package, collector)
   , m_collector(collector)
   , m_masterSlides()
-  , m_slides()
   , m_slideStyles()
 {
 }
@@ -66,6 +66,7 @@ bool KEY6Parser::parsePresentation(const unsigned id)
   if (size && get(size).float_(1) && get(size).float_(2))
     m_collector.collectPresentationSize(IWORKSize(get(size).float_(1).get(), get(size).float_(2).get()));
   m_collector.startSlides();
+  m_collector.sendMetadata();
   bool success = true;
   if (get(msg).message(3))
   {
@@ -83,7 +84,6 @@ bool KEY6Parser::parsePresentation(const unsigned id)
   }
   m_collector.endSlides();
 
-  m_collector.sendSlides(m_slides);
   m_collector.endDocument();
   return success;
 }
@@ -116,43 +116,56 @@ KEYSlidePtr_t KEY6Parser::parseSlide(const unsigned id, const bool master)
       masterSlide=parseSlide(get(masterRef), true);
   }
 
-  m_collector.startPage();
-  m_collector.startLayer();
-
-  IWORKStylePtr_t style;
-  const optional<unsigned> &styleRef = readRef(get(msg), 1);
-  if (styleRef)
-    style = querySlideStyle(get(styleRef));
-  m_collector.setSlideStyle(style);
-  if (!master)
+  KEYSlidePtr_t slide;
   {
-    const optional<unsigned> &titlePlaceholderRef = readRef(get(msg), 5);
-    if (titlePlaceholderRef)
-      parsePlaceholder(get(titlePlaceholderRef));
-    const optional<unsigned> &bodyPlaceholderRef = readRef(get(msg), 6);
-    if (bodyPlaceholderRef)
-      parsePlaceholder(get(bodyPlaceholderRef));
-  }
+    // The slide is sent as soon as it is complete, so let its content
+    // have its own storage, which is freed with the slide.
+    const IWORKOutputElements::DefaultStorageScope storageScope(IWORKOutputElements::createStorage());
+
+    m_collector.startPage();
+    m_collector.startLayer();
+
+    IWORKStylePtr_t style;
+    const optional<unsigned> &styleRef = readRef(get(msg), 1);
+    if (styleRef)
+      style = querySlideStyle(get(styleRef));
+    m_collector.setSlideStyle(style);
+    if (!master)
+    {
+      const optional<unsigned> &titlePlaceholderRef = readRef(get(msg), 5);
+      if (titlePlaceholderRef)
+        parsePlaceholder(get(titlePlaceholderRef));
+      const optional<unsigned> &bodyPlaceholderRef = readRef(get(msg), 6);
+      if (bodyPlaceholderRef)
+        parsePlaceholder(get(bodyPlaceholderRef));
+    }
 
-  const deque<unsigned> &shapeRefs = readRefs(get(msg), 7);
-  for_each(shapeRefs.begin(), shapeRefs.end(), bind(&KEY6Parser::dispatchShape, this, _1));
+    dispatchShapes(readRefs(get(msg), 7));
 
-  const optional<unsigned> &notesRef = readRef(get(msg), 27);
-  if (notesRef)
-    parseNotes(get(notesRef));
+    const optional<unsigned> &notesRef = readRef(get(msg), 27);
+    if (notesRef)
+      parseNotes(get(notesRef));
 
-  const KEYLayerPtr_t layer = m_collector.collectLayer();
-  m_collector.endLayer();
-  m_collector.insertLayer(layer);
+    const KEYLayerPtr_t layer = m_collector.collectLayer();
+    m_collector.endLayer();
+    m_collector.insertLayer(layer);
+    m_collector.releaseLayer(layer);
 
-  KEYSlidePtr_t slide=m_collector.collectSlide();
-  m_collector.endPage();
+    slide=m_collector.collectSlide();
+    m_collector.endPage();
+  }
 
   if (slide)
   {
     slide->m_masterSlide=masterSlide;
     if (!master)
-      m_slides.push_back(slide);
+    {
+      m_collector.sendSlide(slide);
+      // the master has been sent by now too
+      if (masterSlide)
+        masterSlide->m_content.clear();
+      slide->m_content.clear();
+    }
     else
       m_masterSlides[id]=slide;
   }
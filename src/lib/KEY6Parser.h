@@ -43,7 +43,6 @@ private:
   KEYCollector &m_collector;
 
   mutable std::unordered_map<unsigned, KEYSlidePtr_t> m_masterSlides;
-  mutable std::deque<KEYSlidePtr_t> m_slides;
   mutable StyleMap_t m_slideStyles;
 };
 
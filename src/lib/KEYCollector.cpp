@@ -12,7 +12,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
-#include <set>
+#include <sstream>
 
 #include <glm/glm.hpp>
 
@@ -42,6 +42,9 @@ KEYCollector::KEYCollector(IWORKDocumentInterface *const document)
   , m_pageOpened(false)
   , m_layerOpened(false)
   , m_layerCount(0)
+  , m_masterNameMap()
+  , m_masterNames()
+  , m_masterNameId(0)
 {
   assert(!m_inSlides);
 }
@@ -98,6 +101,12 @@ void KEYCollector::insertLayer(const KEYLayerPtr_t &layer)
   }
 }
 
+void KEYCollector::releaseLayer(const KEYLayerPtr_t &layer)
+{
+  if (bool(layer) && layer->m_outputId)
+    getOutputManager().get(get(layer->m_outputId)).clear();
+}
+
 KEYSlidePtr_t KEYCollector::collectSlide()
 {
   assert(m_pageOpened);
@@ -237,48 +246,51 @@ void KEYCollector::startDocument()
 }
 
 void KEYCollector::sendSlides(const std::deque<KEYSlidePtr_t> &slides)
+{
+  sendMetadata();
+  for (auto slide : slides)
+    sendSlide(slide);
+}
+
+void KEYCollector::sendMetadata()
 {
   RVNGPropertyList metadata;
   fillMetadata(metadata);
   m_document->setDocumentMetaData(metadata);
+}
 
-  std::map<KEYSlide const *, std::string> masterToNameMap;
-  std::set<std::string> nameSet;
-  unsigned nameId=0;
-  for (auto slide : slides)
+void KEYCollector::sendSlide(const KEYSlidePtr_t &slide)
+{
+  if (!slide) return;
+  boost::optional<std::string> name;
+  if (slide->m_masterSlide)
   {
-    if (!slide) continue;
-    boost::optional<std::string> name;
-    if (slide->m_masterSlide)
+    if (m_masterNameMap.find(slide->m_masterSlide.get())==m_masterNameMap.end())
     {
-      if (masterToNameMap.find(slide->m_masterSlide.get())==masterToNameMap.end())
+      if (slide->m_masterSlide->m_name && m_masterNames.find(get(slide->m_masterSlide->m_name))==m_masterNames.end())
+        name=get(slide->m_masterSlide->m_name);
+      else
       {
-        if (slide->m_masterSlide->m_name && nameSet.find(get(slide->m_masterSlide->m_name))==nameSet.end())
-          name=get(slide->m_masterSlide->m_name);
-        else
+        // ok try to find an unused name
+        do
         {
-          // ok try to find an unused name
-          do
-          {
-            std::stringstream s;
-            if (slide->m_masterSlide->m_name)
-              s << get(slide->m_masterSlide->m_name) << nameId++;
-            else
-              s << "MasterSlide" << nameId++;
-            name=s.str();
-          }
-          while (nameSet.find(get(name))!=nameSet.end());
+          std::stringstream s;
+          if (slide->m_masterSlide->m_name)
+            s << get(slide->m_masterSlide->m_name) << m_masterNameId++;
+          else
+            s << "MasterSlide" << m_masterNameId++;
+          name=s.str();
         }
-        nameSet.insert(get(name));
-        masterToNameMap[slide->m_masterSlide.get()]=get(name);
-        insertSlide(slide->m_masterSlide, true, name);
+        while (m_masterNames.find(get(name))!=m_masterNames.end());
       }
-      else
-        name=masterToNameMap.find(slide->m_masterSlide.get())->second;
+      m_masterNames.insert(get(name));
+      m_masterNameMap[slide->m_masterSlide.get()]=get(name);
+      insertSlide(slide->m_masterSlide, true, name);
     }
-    insertSlide(slide, false, name);
+    else
+      name=m_masterNameMap.find(slide->m_masterSlide.get())->second;
   }
-
+  insertSlide(slide, false, name);
 }
 
 void KEYCollector::endDocument()
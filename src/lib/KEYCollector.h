@@ -11,6 +11,9 @@
 #define KEYCOLLECTOR_H_INCLUDED
 
 #include <deque>
+#include <map>
+#include <set>
+#include <string>
 
 #include "IWORKCollector.h"
 #include "IWORKPath_fwd.h"
@@ -33,6 +36,11 @@ public:
 
   KEYLayerPtr_t collectLayer();
   void insertLayer(const KEYLayerPtr_t &layer);
+  /** Drop the recorded content of a layer that has been inserted.
+    *
+    * @arg[in] layer the layer
+    */
+  void releaseLayer(const KEYLayerPtr_t &layer);
   KEYSlidePtr_t collectSlide();
 
   KEYPlaceholderPtr_t collectTextPlaceholder(const IWORKStylePtr_t &style, bool title, const boost::optional<unsigned> &resizeFlags=boost::none);
@@ -48,6 +56,16 @@ public:
 
   void startDocument();
   void sendSlides(const std::deque<KEYSlidePtr_t> &slides);
+  /** Send the document metadata.
+    *
+    * This must be called before the first slide is sent.
+    */
+  void sendMetadata();
+  /** Send a slide, preceded by its master if that has not been sent yet.
+    *
+    * @arg[in] slide the slide
+    */
+  void sendSlide(const KEYSlidePtr_t &slide);
   void endDocument();
 
   void startSlides();
@@ -84,6 +102,10 @@ private:
   bool m_pageOpened;
   bool m_layerOpened;
   int m_layerCount;
+
+  std::map<KEYSlide const *, std::string> m_masterNameMap;
+  std::set<std::string> m_masterNames;
+  unsigned m_masterNameId;
 };
 
 } // namespace libetonyek
@@ -93,13 +93,13 @@ IWORKXMLContextPtr_t StickyNoteElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::path : // use me
-    return std::make_shared<IWORKPathElement>(getState());
+    return allocateContext<IWORKPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::style : // use me
-    return std::make_shared<GraphicStyleContext>(getState(), m_graphicStyle, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_graphicStyle, getState().getDictionary().m_graphicStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::text :
-    return std::make_shared<IWORKTextElement>(getState());
+    return allocateContext<IWORKTextElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::wrap : // README
     return IWORKXMLContextPtr_t();
   default:
@@ -157,29 +157,29 @@ IWORKXMLContextPtr_t DrawablesElement::element(const int name)
   switch (name)
   {
   // case IWORKToken::NS_URI_SF | IWORKToken::body_placeholder_ref :
-  //   return std::make_shared<PlaceholderRefContext>(getState(), false);
+  //   return allocateContext<PlaceholderRefContext>(getState(), false);
   case IWORKToken::NS_URI_SF | IWORKToken::cell_comment_drawable_info:
-    return std::make_shared<IWORKCellCommentDrawableInfoElement>(getState());
+    return allocateContext<IWORKCellCommentDrawableInfoElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::chart_info :
-    return std::make_shared<IWORKChartInfoElement>(getState());
+    return allocateContext<IWORKChartInfoElement>(getState());
   // case IWORKToken::NS_URI_SF | IWORKToken::connection_line :
-  //   return std::make_shared<ConnectionLineElement>(getState());
+  //   return allocateContext<ConnectionLineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::group :
-    return std::make_shared<IWORKGroupElement>(getState());
+    return allocateContext<IWORKGroupElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::image :
-    return std::make_shared<IWORKImageElement>(getState());
+    return allocateContext<IWORKImageElement>(getState());
   // case IWORKToken::NS_URI_SF | IWORKToken::line :
-  //   return std::make_shared<LineElement>(getState());
+  //   return allocateContext<LineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::media :
-    return std::make_shared<IWORKMediaElement>(getState());
+    return allocateContext<IWORKMediaElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::shape :
-    return std::make_shared<IWORKShapeContext>(getState());
+    return allocateContext<IWORKShapeContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::sticky_note :
-    return std::make_shared<StickyNoteElement>(getState());
+    return allocateContext<StickyNoteElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tabular_info :
-    return std::make_shared<IWORKTabularInfoElement>(getState());
+    return allocateContext<IWORKTabularInfoElement>(getState());
   // case IWORKToken::NS_URI_SF | IWORKToken::title_placeholder_ref :
-  //   return std::make_shared<PlaceholderRefContext>(getState(), true);
+  //   return allocateContext<PlaceholderRefContext>(getState(), true);
   default:
     break;
   }
@@ -217,7 +217,7 @@ IWORKXMLContextPtr_t LayerElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::drawables :
-    return std::make_shared<DrawablesElement>(getState());
+    return allocateContext<DrawablesElement>(getState());
   default:
     break;
   }
@@ -249,7 +249,7 @@ IWORKXMLContextPtr_t LayersElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::layer :
-    return std::make_shared<LayerElement>(getState());
+    return allocateContext<LayerElement>(getState());
   default:
     break;
   }
@@ -282,7 +282,7 @@ IWORKXMLContextPtr_t PageInfoElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::layers :
-    return std::make_shared<LayersElement>(getState());
+    return allocateContext<LayersElement>(getState());
   default:
     break;
   }
@@ -319,7 +319,7 @@ IWORKXMLContextPtr_t StylesContext::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::workspace_style :
   case NUM1Token::NS_URI_LS | NUM1Token::workspace_style :
-    return std::make_shared<IWORKStyleContext>(getState(), &getState().getDictionary().m_workspaceStyles);
+    return allocateContext<IWORKStyleContext>(getState(), &getState().getDictionary().m_workspaceStyles);
   default:
     break;
   }
@@ -349,9 +349,9 @@ IWORKXMLContextPtr_t StylesheetElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::styles :
-    return std::make_shared<StylesContext>(getState(), false);
+    return allocateContext<StylesContext>(getState(), false);
   case IWORKToken::NS_URI_SF | IWORKToken::anon_styles :
-    return std::make_shared<StylesContext>(getState(), true);
+    return allocateContext<StylesContext>(getState(), true);
   default:
     break;
   }
@@ -406,7 +406,7 @@ IWORKXMLContextPtr_t WorkSpaceElement::element(const int name)
   switch (name)
   {
   case NUM1Token::NS_URI_LS | NUM1Token::page_info:
-    return std::make_shared<PageInfoElement>(getState());
+    return allocateContext<PageInfoElement>(getState());
   default:
     break;
   }
@@ -444,7 +444,7 @@ IWORKXMLContextPtr_t WorkSpaceArrayElement::element(const int name)
   switch (name)
   {
   case NUM1Token::NS_URI_LS | NUM1Token::workspace:
-    return std::make_shared<WorkSpaceElement>(getState());
+    return allocateContext<WorkSpaceElement>(getState());
   default:
     break;
   }
@@ -503,11 +503,11 @@ IWORKXMLContextPtr_t DocumentElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::metadata :
-    return std::make_shared<IWORKMetadataElement>(getState());
+    return allocateContext<IWORKMetadataElement>(getState());
   case NUM1Token::NS_URI_LS | NUM1Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   case NUM1Token::NS_URI_LS | NUM1Token::workspace_array :
-    return std::make_shared<WorkSpaceArrayElement>(getState());
+    return allocateContext<WorkSpaceArrayElement>(getState());
   default:
     break;
   }
@@ -545,7 +545,7 @@ IWORKXMLContextPtr_t XMLDocument::element(const int name)
   switch (name)
   {
   case NUM1Token::NS_URI_LS | NUM1Token::document :
-    return std::make_shared<DocumentElement>(m_state);
+    return allocateContext<DocumentElement>(m_state);
   default:
     break;
   }
@@ -577,9 +577,9 @@ IWORKXMLContextPtr_t DiscardContext::element(const int name)
   switch (name)
   {
   case NUM1Token::NS_URI_LS | NUM1Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   case NUM1Token::NS_URI_LS | NUM1Token::workspace_style :
-    return std::make_shared<IWORKStyleContext>(getState(), &getState().getDictionary().m_workspaceStyles);
+    return allocateContext<IWORKStyleContext>(getState(), &getState().getDictionary().m_workspaceStyles);
   default:
     break;
   }
@@ -606,7 +606,7 @@ IWORKXMLContextPtr_t NUM1Parser::createDocumentContext()
 
 IWORKXMLContextPtr_t NUM1Parser::createDiscardContext()
 {
-  return std::make_shared<DiscardContext>(m_state);
+  return allocateContext<DiscardContext>(m_state);
 }
 
 const IWORKTokenizer &NUM1Parser::getTokenizer() const
@@ -35,9 +35,7 @@ bool NUM3Parser::parseSheet(unsigned id)
   // 2: is the list of table/other drawing in this page
   boost::optional<std::string> name = get(msg).string(1).optional();
   m_collector.startWorkSpace(name);
-  const std::deque<unsigned> &tableListRefs = readRefs(get(msg), 2);
-  for (auto cId : tableListRefs)
-    dispatchShape(cId);
+  dispatchShapes(readRefs(get(msg), 2));
   m_collector.endWorkSpace(m_tableNameMap);
 
   return true;
@@ -91,7 +91,7 @@ AnnotationsElement::AnnotationsElement(PAG1ParserState &state)
 IWORKXMLContextPtr_t AnnotationsElement::element(const int name)
 {
   if (name == (IWORKToken::NS_URI_SF | IWORKToken::annotation))
-    return std::make_shared<PAG1AnnotationContext>(getState(),
+    return allocateContext<PAG1AnnotationContext>(getState(),
                                                    std::bind(&PAGCollector::collectAnnotation, std::ref(getCollector()), _1));
   return IWORKXMLContextPtr_t();
 }
@@ -115,7 +115,7 @@ FootersElement::FootersElement(PAG1ParserState &state)
 IWORKXMLContextPtr_t FootersElement::element(const int name)
 {
   if (name == (IWORKToken::NS_URI_SF | IWORKToken::footer))
-    return std::make_shared<IWORKHeaderFooterContext>(getState(),
+    return allocateContext<IWORKHeaderFooterContext>(getState(),
                                                       std::bind(&IWORKCollector::collectFooter, std::ref(getCollector()), _1));
   return IWORKXMLContextPtr_t();
 }
@@ -144,10 +144,10 @@ IWORKXMLContextPtr_t GroupElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::drawable_shape :
     PAG1XMLContextBase<IWORKGroupElement>::ensureClosed();
-    return std::make_shared<PAG1ShapeContext>(getState());
+    return allocateContext<PAG1ShapeContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::group :
     PAG1XMLContextBase<IWORKGroupElement>::ensureClosed();
-    return std::make_shared<GroupElement>(getState());
+    return allocateContext<GroupElement>(getState());
   default:
     break;
   }
@@ -177,7 +177,7 @@ HeadersElement::HeadersElement(PAG1ParserState &state)
 IWORKXMLContextPtr_t HeadersElement::element(const int name)
 {
   if (name == (IWORKToken::NS_URI_SF | IWORKToken::header))
-    return std::make_shared<IWORKHeaderFooterContext>(getState(),
+    return allocateContext<IWORKHeaderFooterContext>(getState(),
                                                       std::bind(&IWORKCollector::collectHeader, std::ref(getCollector()), _1));
   return IWORKXMLContextPtr_t();
 }
@@ -208,9 +208,9 @@ IWORKXMLContextPtr_t StylesContext::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::sectionstyle :
     // TODO: setting of the default parent would also be a good candidate for leaveElement(),
     // if we ever add this, as it seems to be limited to a few style types.
-    return std::make_shared<PAG1StyleContext>(getState(), &getState().getDictionary().m_sectionStyles, "section-style-default");
+    return allocateContext<PAG1StyleContext>(getState(), &getState().getDictionary().m_sectionStyles, "section-style-default");
   case IWORKToken::NS_URI_SF | IWORKToken::sectionstyle_ref :
-    return std::make_shared<IWORKStyleRefContext>(getState(), getState().getDictionary().m_sectionStyles);
+    return allocateContext<IWORKStyleRefContext>(getState(), getState().getDictionary().m_sectionStyles);
   default:
     break;
   }
@@ -242,9 +242,9 @@ IWORKXMLContextPtr_t StylesheetElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::anon_styles :
-    return std::make_shared<StylesContext>(getState(), true);
+    return allocateContext<StylesContext>(getState(), true);
   case IWORKToken::NS_URI_SF | IWORKToken::styles :
-    return std::make_shared<StylesContext>(getState(), false);
+    return allocateContext<StylesContext>(getState(), false);
   default:
     break;
   }
@@ -274,7 +274,7 @@ PrototypeElement::PrototypeElement(PAG1ParserState &state)
 IWORKXMLContextPtr_t PrototypeElement::element(const int name)
 {
   if (name == (IWORKToken::NS_URI_SF | IWORKToken::stylesheet))
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   return IWORKXMLContextPtr_t();
 }
 
@@ -300,7 +300,7 @@ SectionPrototypesElement::SectionPrototypesElement(PAG1ParserState &state)
 IWORKXMLContextPtr_t SectionPrototypesElement::element(const int name)
 {
   if (name == (PAG1Token::NS_URI_SL | PAG1Token::prototype))
-    return std::make_shared<PrototypeElement>(getState());
+    return allocateContext<PrototypeElement>(getState());
   return IWORKXMLContextPtr_t();
 }
 
@@ -359,7 +359,7 @@ SLCreationDatePropertyElement::SLCreationDatePropertyElement(PAG1ParserState &st
 IWORKXMLContextPtr_t SLCreationDatePropertyElement::element(const int name)
 {
   if (name == (PAG1Token::NS_URI_SL | PAG1Token::SLCreationDateProperty))
-    return std::make_shared<DateElement>(getState(), m_value);
+    return allocateContext<DateElement>(getState(), m_value);
   return IWORKXMLContextPtr_t();
 }
 
@@ -392,7 +392,7 @@ template<class T, class C, int I>
 IWORKXMLContextPtr_t DocumentPropertyContext<T, C, I>::element(const int name)
 {
   if (name == I)
-    return std::make_shared<C>(getState(), m_value);
+    return allocateContext<C>(getState(), m_value);
   return IWORKXMLContextPtr_t();
 }
 
@@ -458,11 +458,11 @@ IWORKXMLContextPtr_t PublicationInfoElement::element(const int name)
   switch (name)
   {
   case PAG1Token::NS_URI_SL | PAG1Token::kSFWPFootnoteGapProperty :
-    return std::make_shared<KSFWPFootnoteGapPropertyElement>(getState(), m_pubInfo.m_footnoteGap);
+    return allocateContext<KSFWPFootnoteGapPropertyElement>(getState(), m_pubInfo.m_footnoteGap);
   case PAG1Token::NS_URI_SL | PAG1Token::kSFWPFootnoteKindProperty :
-    return std::make_shared<KSFWPFootnoteKindPropertyElement>(getState(), m_footnoteKind);
+    return allocateContext<KSFWPFootnoteKindPropertyElement>(getState(), m_footnoteKind);
   case PAG1Token::NS_URI_SL | PAG1Token::SLCreationDateProperty :
-    return std::make_shared<SLCreationDatePropertyElement>(getState(), m_pubInfo.m_creationDate);
+    return allocateContext<SLCreationDatePropertyElement>(getState(), m_pubInfo.m_creationDate);
   default:
   {
     static bool first=true;
@@ -607,7 +607,7 @@ IWORKXMLContextPtr_t SLPrintInfoElement::element(const int name)
   case PAG1Token::NS_URI_SL | PAG1Token::print_info:
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::page_margins:
-    return std::make_shared<PageMarginsElement>(getState(), m_printInfo);
+    return allocateContext<PageMarginsElement>(getState(), m_printInfo);
   default:
     ETONYEK_DEBUG_MSG(("SLPrintInfoElement::element[PAG1Parser.cpp]: find unknown element\n"));
     break;
@@ -677,17 +677,17 @@ IWORKXMLContextPtr_t PageGroupElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::drawable_shape :
-    return std::make_shared<PAG1ShapeContext>(getState());
+    return allocateContext<PAG1ShapeContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::group :
-    return std::make_shared<GroupElement>(getState());
+    return allocateContext<GroupElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::line :
-    return std::make_shared<IWORKLineElement>(getState());
+    return allocateContext<IWORKLineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::image :
-    return std::make_shared<IWORKImageElement>(getState());
+    return allocateContext<IWORKImageElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::media :
-    return std::make_shared<IWORKMediaElement>(getState());
+    return allocateContext<IWORKMediaElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tabular_info :
-    return std::make_shared<IWORKTabularInfoElement>(getState());
+    return allocateContext<IWORKTabularInfoElement>(getState());
   default:
     break;
   }
@@ -741,7 +741,7 @@ IWORKXMLContextPtr_t DrawablesElement::element(const int name)
   switch (name)
   {
   case PAG1Token::NS_URI_SL | PAG1Token::page_group :
-    return std::make_shared<PageGroupElement>(getState());
+    return allocateContext<PageGroupElement>(getState());
   // see also sl:master-groups which contains sl:section-drawables
   default:
     break;
@@ -804,27 +804,27 @@ IWORKXMLContextPtr_t DocumentElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::annotations :
-    return std::make_shared<AnnotationsElement>(getState());
+    return allocateContext<AnnotationsElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::calc_engine :
-    return std::make_shared<IWORKCalcEngineContext>(getState());
+    return allocateContext<IWORKCalcEngineContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::headers :
-    return std::make_shared<HeadersElement>(getState());
+    return allocateContext<HeadersElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::footers :
-    return std::make_shared<FootersElement>(getState());
+    return allocateContext<FootersElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::metadata :
-    return std::make_shared<IWORKMetadataElement>(getState());
+    return allocateContext<IWORKMetadataElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::text_storage :
-    return std::make_shared<PAG1TextStorageElement>(getState());
+    return allocateContext<PAG1TextStorageElement>(getState());
   case PAG1Token::NS_URI_SL | PAG1Token::drawables :
-    return std::make_shared<DrawablesElement>(getState());
+    return allocateContext<DrawablesElement>(getState());
   case PAG1Token::NS_URI_SL | PAG1Token::publication_info :
-    return std::make_shared<PublicationInfoElement>(getState());
+    return allocateContext<PublicationInfoElement>(getState());
   case PAG1Token::NS_URI_SL | PAG1Token::section_prototypes :
-    return std::make_shared<SectionPrototypesElement>(getState());
+    return allocateContext<SectionPrototypesElement>(getState());
   case PAG1Token::NS_URI_SL | PAG1Token::slprint_info :
-    return std::make_shared<SLPrintInfoElement>(getState());
+    return allocateContext<SLPrintInfoElement>(getState());
   case PAG1Token::NS_URI_SL | PAG1Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   default:
     break;
   }
@@ -862,7 +862,7 @@ IWORKXMLContextPtr_t XMLDocument::element(const int name)
   switch (name)
   {
   case PAG1Token::NS_URI_SL | PAG1Token::document :
-    return std::make_shared<DocumentElement>(m_state);
+    return allocateContext<DocumentElement>(m_state);
   default:
     break;
   }
@@ -893,10 +893,10 @@ IWORKXMLContextPtr_t DiscardContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::sectionstyle :
-    return std::make_shared<PAG1StyleContext>(getState(), &getState().getDictionary().m_sectionStyles, "section-style-default");
+    return allocateContext<PAG1StyleContext>(getState(), &getState().getDictionary().m_sectionStyles, "section-style-default");
   case IWORKToken::NS_URI_SF | IWORKToken::stylesheet :
   case PAG1Token::NS_URI_SL | PAG1Token::stylesheet :
-    return std::make_shared<StylesheetElement>(getState());
+    return allocateContext<StylesheetElement>(getState());
   default:
     break;
   }
@@ -923,7 +923,7 @@ IWORKXMLContextPtr_t PAG1Parser::createDocumentContext()
 
 IWORKXMLContextPtr_t PAG1Parser::createDiscardContext()
 {
-  return std::make_shared<DiscardContext>(m_state);
+  return allocateContext<DiscardContext>(m_state);
 }
 
 const IWORKTokenizer &PAG1Parser::getTokenizer() const
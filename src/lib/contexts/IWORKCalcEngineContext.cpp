@@ -43,7 +43,7 @@ IWORKXMLContextPtr_t CalcEngineEntities::element(const int name)
   switch (name)
   {
   case IWORKToken::tabular_model | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKTabularModelElement>(getState(), true);
+    return allocateContext<IWORKTabularModelElement>(getState(), true);
   default:
     break;
   }
@@ -63,7 +63,7 @@ IWORKXMLContextPtr_t IWORKCalcEngineContext::element(const int name)
   switch (name)
   {
   case IWORKToken::calc_engine_entities | IWORKToken::NS_URI_SF :
-    return std::make_shared<CalcEngineEntities>(getState());
+    return allocateContext<CalcEngineEntities>(getState());
   default:
     break;
   }
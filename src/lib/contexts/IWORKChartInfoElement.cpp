@@ -67,7 +67,7 @@ CachedDataElement::CachedDataElement(IWORKXMLParserState &state)
 IWORKXMLContextPtr_t CachedDataElement::element(const int name)
 {
   if (name == (IWORKToken::mutable_array | IWORKToken::NS_URI_SF))
-    return std::make_shared<MutableArrayElement>(getState());
+    return allocateContext<MutableArrayElement>(getState());
 
   return IWORKXMLContextPtr_t();
 }
@@ -128,17 +128,17 @@ IWORKXMLContextPtr_t FormulaChartModelElement::element(const int name)
   switch (name)
   {
   case IWORKToken::chart_column_names | IWORKToken::NS_URI_SF :
-    return std::make_shared<ChartRowColumnNamesElement>(getState(), m_chart.m_columnNames);
+    return allocateContext<ChartRowColumnNamesElement>(getState(), m_chart.m_columnNames);
   case IWORKToken::chart_row_names | IWORKToken::NS_URI_SF :
-    return std::make_shared<ChartRowColumnNamesElement>(getState(), m_chart.m_rowNames);
+    return allocateContext<ChartRowColumnNamesElement>(getState(), m_chart.m_rowNames);
   case IWORKToken::chart_name | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKStringElement>(getState(), m_chart.m_chartName);
+    return allocateContext<IWORKStringElement>(getState(), m_chart.m_chartName);
   case IWORKToken::value_title | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKStringElement>(getState(), m_chart.m_valueTitle);
+    return allocateContext<IWORKStringElement>(getState(), m_chart.m_valueTitle);
   case IWORKToken::category_title | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKStringElement>(getState(), m_chart.m_categoryTitle);
+    return allocateContext<IWORKStringElement>(getState(), m_chart.m_categoryTitle);
   case IWORKToken::cached_data | IWORKToken::NS_URI_SF :
-    return std::make_shared<CachedDataElement>(getState());
+    return allocateContext<CachedDataElement>(getState());
   default:
     break;
   }
@@ -175,7 +175,7 @@ IWORKXMLContextPtr_t ChartModelObjectElement::element(const int name)
   switch (name)
   {
   case IWORKToken::formula_chart_model | IWORKToken::NS_URI_SF :
-    return std::make_shared<FormulaChartModelElement>(getState(), m_chart);
+    return allocateContext<FormulaChartModelElement>(getState(), m_chart);
   default:
     break;
   }
@@ -214,9 +214,9 @@ IWORKXMLContextPtr_t IWORKChartInfoElement::element(const int name)
   switch (name)
   {
   case IWORKToken::geometry | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::chart_model_object | IWORKToken::NS_URI_SF :
-    return std::make_shared<ChartModelObjectElement>(getState(), m_chart);
+    return allocateContext<ChartModelObjectElement>(getState(), m_chart);
   default:
     break;
   }
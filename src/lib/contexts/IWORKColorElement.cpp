@@ -9,7 +9,9 @@
 
 #include "IWORKColorElement.h"
 
-#include <boost/lexical_cast.hpp>
+#include <boost/lexical_cast/bad_lexical_cast.hpp>
+
+#include "libetonyek_xml.h"
 
 #include "IWORKCollector.h"
 #include "IWORKDictionary.h"
@@ -19,8 +21,6 @@
 namespace libetonyek
 {
 
-using boost::lexical_cast;
-
 IWORKColorElement::IWORKColorElement(IWORKXMLParserState &state, boost::optional<IWORKColor> &color)
   : IWORKXMLEmptyContextBase(state)
   , m_color(color)
@@ -45,31 +45,31 @@ void IWORKColorElement::attribute(const int name, const char *const value)
     {
     // TODO: check xsi:type too
     case IWORKToken::NS_URI_SFA | IWORKToken::a :
-      m_a = lexical_cast<double>(value);
+      m_a = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::b :
-      m_b = lexical_cast<double>(value);
+      m_b = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::c :
-      m_c = lexical_cast<double>(value);
+      m_c = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::g :
-      m_g = lexical_cast<double>(value);
+      m_g = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::k :
-      m_k = lexical_cast<double>(value);
+      m_k = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::m :
-      m_m = lexical_cast<double>(value);
+      m_m = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::r :
-      m_r = lexical_cast<double>(value);
+      m_r = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::w :
-      m_w = lexical_cast<double>(value);
+      m_w = double_cast(value);
       break;
     case IWORKToken::NS_URI_SFA | IWORKToken::y :
-      m_y = lexical_cast<double>(value);
+      m_y = double_cast(value);
       break;
     case IWORKToken::NS_URI_XSI | IWORKToken::type :
       m_type = value;
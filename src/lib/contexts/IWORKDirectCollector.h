@@ -29,7 +29,7 @@ public:
   template<class Context, class State>
   IWORKXMLContextPtr_t makeContext(State &state) const
   {
-    return std::make_shared<Context>(state, m_collection);
+    return allocateContext<Context>(state, m_collection);
   }
 
   bool pending() const
@@ -51,7 +51,7 @@ IWORKXMLContextPtr_t IWORKFieldElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::span :
-    return std::make_shared<IWORKSpanElement>(getState());
+    return allocateContext<IWORKSpanElement>(getState());
   default:
     break;
   }
@@ -44,13 +44,13 @@ IWORKXMLContextPtr_t IWORKFilteredImageElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::unfiltered :
-    return std::make_shared<IWORKUnfilteredElement>(getState(), m_unfiltered);
+    return allocateContext<IWORKUnfilteredElement>(getState(), m_unfiltered);
   case IWORKToken::NS_URI_SF | IWORKToken::unfiltered_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_unfilteredId);
+    return allocateContext<IWORKRefContext>(getState(), m_unfilteredId);
   case IWORKToken::NS_URI_SF | IWORKToken::filtered :
-    return std::make_shared<IWORKFilteredElement>(getState(), m_filtered);
+    return allocateContext<IWORKFilteredElement>(getState(), m_filtered);
   case IWORKToken::NS_URI_SF | IWORKToken::leveled :
-    return std::make_shared<LeveledElement>(getState(), m_leveled);
+    return allocateContext<LeveledElement>(getState(), m_leveled);
   case IWORKToken::NS_URI_SF | IWORKToken::extent : // TODO readme
   case IWORKToken::NS_URI_SF | IWORKToken::filter_properties :
     break;
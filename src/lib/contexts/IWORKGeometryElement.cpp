@@ -9,8 +9,6 @@
 
 #include "IWORKGeometryElement.h"
 
-#include <boost/lexical_cast.hpp>
-
 #include "libetonyek_xml.h"
 #include "IWORKCollector.h"
 #include "IWORKDictionary.h"
@@ -22,8 +20,6 @@
 namespace libetonyek
 {
 
-using boost::lexical_cast;
-
 IWORKGeometryElement::IWORKGeometryElement(IWORKXMLParserState &state)
   : IWORKXMLElementContextBase(state)
   , m_geometry(nullptr)
@@ -61,7 +57,7 @@ void IWORKGeometryElement::attribute(const int name, const char *const value)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::angle :
-    m_angle = -deg2rad(lexical_cast<double>(value));
+    m_angle = -deg2rad(double_cast(value));
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::aspectRatioLocked :
     m_aspectRatioLocked = bool_cast(value);
@@ -70,10 +66,10 @@ void IWORKGeometryElement::attribute(const int name, const char *const value)
     m_horizontalFlip = bool_cast(value);
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::shearXAngle :
-    m_shearXAngle = deg2rad(lexical_cast<double>(value));
+    m_shearXAngle = deg2rad(double_cast(value));
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::shearYAngle :
-    m_shearYAngle = deg2rad(lexical_cast<double>(value));
+    m_shearYAngle = deg2rad(double_cast(value));
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::sizesLocked :
     m_sizesLocked = bool_cast(value);
@@ -92,11 +88,11 @@ IWORKXMLContextPtr_t IWORKGeometryElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::naturalSize :
-    return std::make_shared<IWORKSizeElement>(getState(), m_naturalSize);
+    return allocateContext<IWORKSizeElement>(getState(), m_naturalSize);
   case IWORKToken::NS_URI_SF | IWORKToken::position :
-    return std::make_shared<IWORKPositionElement>(getState(), m_pos);
+    return allocateContext<IWORKPositionElement>(getState(), m_pos);
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("IWORKGeometryElement::element: find unknown element\n"));
     break;
@@ -43,29 +43,29 @@ IWORKXMLContextPtr_t IWORKGroupElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::group :
     ensureClosed(); // checkme: creating a group in a group must be often possible
-    return std::make_shared<IWORKGroupElement>(getState());
+    return allocateContext<IWORKGroupElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::image :
     ensureOpened();
-    return std::make_shared<IWORKImageElement>(getState());
+    return allocateContext<IWORKImageElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::line :
     ensureOpened();
-    return std::make_shared<IWORKLineElement>(getState());
+    return allocateContext<IWORKLineElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::media :
     ensureOpened();
-    return std::make_shared<IWORKMediaElement>(getState());
+    return allocateContext<IWORKMediaElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::drawable_shape :
   case IWORKToken::NS_URI_SF | IWORKToken::shape :
     ensureOpened();
-    return std::make_shared<IWORKShapeContext>(getState());
+    return allocateContext<IWORKShapeContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::table_info :
     ensureClosed();
-    return std::make_shared<IWORKTableInfoElement>(getState());
+    return allocateContext<IWORKTableInfoElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tabular_info :
     ensureClosed();
-    return std::make_shared<IWORKTabularInfoElement>(getState());
+    return allocateContext<IWORKTabularInfoElement>(getState());
   default:
     break;
   }
@@ -46,7 +46,7 @@ void IWORKHeaderFooterContext::attribute(const int name, const char *const value
 IWORKXMLContextPtr_t IWORKHeaderFooterContext::element(const int name)
 {
   if (name == (IWORKToken::NS_URI_SF | IWORKToken::text_storage))
-    return std::make_shared<IWORKTextStorageElement>(getState());
+    return allocateContext<IWORKTextStorageElement>(getState());
   return IWORKXMLContextPtr_t();
 }
 
@@ -90,17 +90,17 @@ IWORKXMLContextPtr_t IWORKImageElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::binary :
-    return std::make_shared<IWORKBinaryElement>(getState(), m_content);
+    return allocateContext<IWORKBinaryElement>(getState(), m_content);
   case IWORKToken::NS_URI_SF | IWORKToken::binary_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_binaryRef);
+    return allocateContext<IWORKRefContext>(getState(), m_binaryRef);
   case IWORKToken::NS_URI_SF | IWORKToken::crop_geometry :
-    return std::make_shared<IWORKGeometryElement>(getState(), m_cropGeometry);
+    return allocateContext<IWORKGeometryElement>(getState(), m_cropGeometry);
   case IWORKToken::NS_URI_SF | IWORKToken::data :
-    return std::make_shared<IWORKDataElement>(getState(), m_data, m_fillColor);
+    return allocateContext<IWORKDataElement>(getState(), m_data, m_fillColor);
   case IWORKToken::NS_URI_SF | IWORKToken::filtered_image :
-    return std::make_shared<IWORKFilteredImageElement>(getState(), m_filteredImage);
+    return allocateContext<IWORKFilteredImageElement>(getState(), m_filteredImage);
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::masking_shape_path_source :
   {
     static bool first=true;
@@ -112,11 +112,11 @@ IWORKXMLContextPtr_t IWORKImageElement::element(const int name)
     break;
   }
   case IWORKToken::NS_URI_SF | IWORKToken::placeholder_size : // USEME
-    return std::make_shared<IWORKSizeElement>(getState(),m_placeholderSize);
+    return allocateContext<IWORKSizeElement>(getState(),m_placeholderSize);
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(),m_size);
+    return allocateContext<IWORKSizeElement>(getState(),m_size);
   case IWORKToken::NS_URI_SF | IWORKToken::style : // USEME
-    return std::make_shared<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
   default:
     ETONYEK_DEBUG_MSG(("IWORKImageElement::element: find some unknown element\n"));
     break;
@@ -44,13 +44,13 @@ IWORKXMLContextPtr_t IWORKLineElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::head :
-    return std::make_shared<IWORKPositionElement>(getState(), m_head);
+    return allocateContext<IWORKPositionElement>(getState(), m_head);
   case IWORKToken::NS_URI_SF | IWORKToken::style :
-    return std::make_shared<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::tail :
-    return std::make_shared<IWORKPositionElement>(getState(), m_tail);
+    return allocateContext<IWORKPositionElement>(getState(), m_tail);
   default:
     break;
   }
@@ -42,10 +42,10 @@ IWORKXMLContextPtr_t IWORKListLabelIndentsProperty::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::array :
   case IWORKToken::NS_URI_SF | IWORKToken::mutable_array :
-    return std::make_shared<MutableArrayElement>(getState(), getState().getDictionary().m_doubleArrays, m_elements);
+    return allocateContext<MutableArrayElement>(getState(), getState().getDictionary().m_doubleArrays, m_elements);
   case IWORKToken::NS_URI_SF | IWORKToken::mutable_array_ref :
   case IWORKToken::NS_URI_SF | IWORKToken::array_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   default:
     break;
   }
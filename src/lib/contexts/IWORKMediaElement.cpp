@@ -65,7 +65,7 @@ IWORKXMLContextPtr_t ImageMediaElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::alpha_mask_path : // README
     break;
   case IWORKToken::NS_URI_SF | IWORKToken::filtered_image :
-    return std::make_shared<IWORKFilteredImageElement>(getState(), m_content);
+    return allocateContext<IWORKFilteredImageElement>(getState(), m_content);
   case IWORKToken::NS_URI_SF | IWORKToken::traced_path : // README
     break;
   default:
@@ -108,9 +108,9 @@ IWORKXMLContextPtr_t OtherDatasElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::data :
-    return std::make_shared<IWORKDataElement>(getState(), m_data, m_fillColor);
+    return allocateContext<IWORKDataElement>(getState(), m_data, m_fillColor);
   case IWORKToken::NS_URI_SF | IWORKToken::data_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_dataRef);
+    return allocateContext<IWORKRefContext>(getState(), m_dataRef);
   default:
     ETONYEK_DEBUG_MSG(("OtherDatasElement::element[IWORKMediaElement.cpp]: unknown element %d\n", name));
   }
@@ -167,11 +167,11 @@ IWORKXMLContextPtr_t SelfContainedMovieElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::main_movie :
-    return std::make_shared<IWORKDataElement>(getState(), m_data, m_fillColor);
+    return allocateContext<IWORKDataElement>(getState(), m_data, m_fillColor);
   case IWORKToken::NS_URI_SF | IWORKToken::main_movie_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_mainMovieRef);
+    return allocateContext<IWORKRefContext>(getState(), m_mainMovieRef);
   case IWORKToken::NS_URI_SF | IWORKToken::other_datas :
-    return std::make_shared<OtherDatasElement>(getState(), m_otherData);
+    return allocateContext<OtherDatasElement>(getState(), m_otherData);
   default:
     ETONYEK_DEBUG_MSG(("SelfContainedMovieElement::element[IWORKMediaElement.cpp]: unknown element %d\n", name));
   }
@@ -235,13 +235,13 @@ IWORKXMLContextPtr_t MovieMediaElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::audio_only_image :
-    return std::make_shared<IWORKBinaryElement>(getState(), m_audioOnlyImage);
+    return allocateContext<IWORKBinaryElement>(getState(), m_audioOnlyImage);
   case IWORKToken::NS_URI_SF | IWORKToken::audio_only_image_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_audioOnlyImageRef);
+    return allocateContext<IWORKRefContext>(getState(), m_audioOnlyImageRef);
   case IWORKToken::NS_URI_SF | IWORKToken::poster_image :
-    return std::make_shared<IWORKBinaryElement>(getState(), m_posterImage);
+    return allocateContext<IWORKBinaryElement>(getState(), m_posterImage);
   case IWORKToken::NS_URI_SF | IWORKToken::self_contained_movie :
-    return std::make_shared<SelfContainedMovieElement>(getState(), m_data);
+    return allocateContext<SelfContainedMovieElement>(getState(), m_data);
   default:
     ETONYEK_DEBUG_MSG(("MovieMediaElement::element[IWORKMediaElement.cpp]: unknown element %d\n", name));
   }
@@ -306,9 +306,9 @@ IWORKXMLContextPtr_t ContentElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::image_media :
-    return std::make_shared<ImageMediaElement>(getState(), m_content);
+    return allocateContext<ImageMediaElement>(getState(), m_content);
   case IWORKToken::NS_URI_SF | IWORKToken::movie_media :
-    return std::make_shared<MovieMediaElement>(getState(), m_content);
+    return allocateContext<MovieMediaElement>(getState(), m_content);
   default:
     ETONYEK_DEBUG_MSG(("ContentElement::element[IWORKMediaElement.cpp]: unknown element %d\n", name));
   }
@@ -361,15 +361,15 @@ IWORKXMLContextPtr_t IWORKMediaElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::audio_only_image :
-    return std::make_shared<IWORKBinaryElement>(getState(), m_audioOnlyImage);
+    return allocateContext<IWORKBinaryElement>(getState(), m_audioOnlyImage);
   case IWORKToken::NS_URI_SF | IWORKToken::audio_only_image_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_audioOnlyImageRef);
+    return allocateContext<IWORKRefContext>(getState(), m_audioOnlyImageRef);
   case IWORKToken::NS_URI_SF | IWORKToken::content :
-    return std::make_shared<ContentElement>(getState(), m_content);
+    return allocateContext<ContentElement>(getState(), m_content);
   case IWORKToken::NS_URI_SF | IWORKToken::crop_geometry :
-    return std::make_shared<IWORKGeometryElement>(getState(), m_cropGeometry);
+    return allocateContext<IWORKGeometryElement>(getState(), m_cropGeometry);
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::masking_shape_path_source :
   {
     static bool first=true;
@@ -381,15 +381,15 @@ IWORKXMLContextPtr_t IWORKMediaElement::element(const int name)
     break;
   }
   case IWORKToken::NS_URI_SF | IWORKToken::placeholder_size : // USEME
-    return std::make_shared<IWORKSizeElement>(getState(),m_placeholderSize);
+    return allocateContext<IWORKSizeElement>(getState(),m_placeholderSize);
   case IWORKToken::NS_URI_SF | IWORKToken::poster_image :
-    return std::make_shared<IWORKBinaryElement>(getState(), m_posterImage);
+    return allocateContext<IWORKBinaryElement>(getState(), m_posterImage);
   case IWORKToken::NS_URI_SF | IWORKToken::self_contained_movie :
-    return std::make_shared<SelfContainedMovieElement>(getState(), m_movieData);
+    return allocateContext<SelfContainedMovieElement>(getState(), m_movieData);
   case IWORKToken::NS_URI_SF | IWORKToken::style : // USEME
-    return std::make_shared<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::wrap : // USEME
-    return std::make_shared<IWORKWrapElement>(getState(), m_wrap);
+    return allocateContext<IWORKWrapElement>(getState(), m_wrap);
   default:
     ETONYEK_DEBUG_MSG(("IWORKMediaElement::element: find some unknown elements\n"));
     break;
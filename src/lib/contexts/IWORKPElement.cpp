@@ -69,23 +69,23 @@ IWORKXMLContextPtr_t GhostTextElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::crbr :
   case IWORKToken::NS_URI_SF | IWORKToken::intratopicbr :
   case IWORKToken::NS_URI_SF | IWORKToken::lnbr :
-    return std::make_shared<IWORKBrContext>(getState());
+    return allocateContext<IWORKBrContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::pgbr :
     return IWORKXMLContextPtr_t();
   case IWORKToken::NS_URI_SF | IWORKToken::span :
-    return std::make_shared<IWORKSpanElement>(getState());
+    return allocateContext<IWORKSpanElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tab :
-    return std::make_shared<IWORKTabElement>(getState());
+    return allocateContext<IWORKTabElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::link :
-    return std::make_shared<IWORKLinkElement>(getState());
+    return allocateContext<IWORKLinkElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::date_time :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
   case IWORKToken::NS_URI_SF | IWORKToken::filename :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
   case IWORKToken::NS_URI_SF | IWORKToken::page_count :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
   case IWORKToken::NS_URI_SF | IWORKToken::page_number :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
   default:
     ETONYEK_DEBUG_MSG(("GhostTextElement::element[IWORKPElement.cpp]: find unknown element\n"));
     break;
@@ -145,30 +145,30 @@ IWORKXMLContextPtr_t IWORKPElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::crbr :
   case IWORKToken::NS_URI_SF | IWORKToken::intratopicbr :
   case IWORKToken::NS_URI_SF | IWORKToken::lnbr :
-    return std::make_shared<IWORKBrContext>(getState());
+    return allocateContext<IWORKBrContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::pgbr :
     m_delayedPageBreak=true;
     return IWORKXMLContextPtr_t();
   case IWORKToken::NS_URI_SF | IWORKToken::span :
-    return std::make_shared<IWORKSpanElement>(getState());
+    return allocateContext<IWORKSpanElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::tab :
-    return std::make_shared<IWORKTabElement>(getState());
+    return allocateContext<IWORKTabElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::link :
-    return std::make_shared<IWORKLinkElement>(getState());
+    return allocateContext<IWORKLinkElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::date_time :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
   case IWORKToken::NS_URI_SF | IWORKToken::filename :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
   case IWORKToken::NS_URI_SF | IWORKToken::ghost_text :
   case IWORKToken::NS_URI_SF | IWORKToken::ghost_text_ref :
     /* checkme: sf:ghost-text and sf:ghost-text-ref seems similar, but maybe
        sf:ghost-text-ref can also be called without the text data...
      */
-    return std::make_shared<GhostTextElement>(getState());
+    return allocateContext<GhostTextElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::page_count :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
   case IWORKToken::NS_URI_SF | IWORKToken::page_number :
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
   default:
     ETONYEK_DEBUG_MSG(("IWORKPElement::element: find unknown element\n"));
     break;
@@ -61,9 +61,9 @@ IWORKXMLContextPtr_t ConnectionPathElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::point :
-    return std::make_shared<IWORKPositionElement>(getState(), m_point);
+    return allocateContext<IWORKPositionElement>(getState(), m_point);
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("ConnectionPathElement::element[IWORKPathElement.cpp]: find unknown element\n"));
   }
@@ -147,9 +147,9 @@ IWORKXMLContextPtr_t PointPathElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::point :
-    return std::make_shared<IWORKPositionElement>(getState(), m_point);
+    return allocateContext<IWORKPositionElement>(getState(), m_point);
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("PointPathElement::element[IWORKPathElement.cpp]: find unknown element\n"));
   }
@@ -244,7 +244,7 @@ IWORKXMLContextPtr_t ScalarPathElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("ScalarPathElement::element[IWORKPathElement.cpp]: find unknown element\n"));
   }
@@ -297,9 +297,9 @@ IWORKXMLContextPtr_t BezierPathElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::bezier :
-    return std::make_shared<IWORKBezierElement>(getState(), m_path);
+    return allocateContext<IWORKBezierElement>(getState(), m_path);
   case IWORKToken::NS_URI_SF | IWORKToken::bezier_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   default:
     ETONYEK_DEBUG_MSG(("BezierPathElement::element[IWORKPathElement.cpp]: find unknown element\n"));
   }
@@ -390,7 +390,7 @@ IWORKXMLContextPtr_t Callout2PathElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::size :
-    return std::make_shared<IWORKSizeElement>(getState(), m_size);
+    return allocateContext<IWORKSizeElement>(getState(), m_size);
   default:
     ETONYEK_DEBUG_MSG(("Callout2PathElement::element[IWORKPathElement.cpp]: find unknown element\n"));
   }
@@ -417,15 +417,15 @@ IWORKXMLContextPtr_t IWORKPathElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::bezier_path :
   case IWORKToken::NS_URI_SF | IWORKToken::editable_bezier_path :
-    return std::make_shared<BezierPathElement>(getState());
+    return allocateContext<BezierPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::callout2_path :
-    return std::make_shared<Callout2PathElement>(getState());
+    return allocateContext<Callout2PathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::connection_path :
-    return std::make_shared<ConnectionPathElement>(getState());
+    return allocateContext<ConnectionPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::point_path :
-    return std::make_shared<PointPathElement>(getState());
+    return allocateContext<PointPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::scalar_path :
-    return std::make_shared<ScalarPathElement>(getState());
+    return allocateContext<ScalarPathElement>(getState());
   default:
     ETONYEK_DEBUG_MSG(("IWORKPathElement::element: find unknown element\n"));
   }
@@ -124,9 +124,9 @@ IWORKXMLContextPtr_t RefPropertyContext<Property, Context, TokenId, RefTokenId>:
   switch (name)
   {
   case TokenId :
-    return std::make_shared<Context>(getState(), m_data);
+    return allocateContext<Context>(getState(), m_data);
   case RefTokenId :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   case IWORKToken::NS_URI_SF | IWORKToken::null:
     return IWORKXMLContextPtr_t();
   default:
@@ -229,9 +229,9 @@ IWORKXMLContextPtr_t TabsProperty::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::tabs :
-    return std::make_shared<IWORKTabsElement>(getState(), m_tabs);
+    return allocateContext<IWORKTabsElement>(getState(), m_tabs);
   case IWORKToken::NS_URI_SF | IWORKToken::tabs_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   default:
     ETONYEK_DEBUG_MSG(("TabsProperty::element[IWORKPropertyMapElement.cpp]: find unknown element\n"));
   }
@@ -405,7 +405,7 @@ IWORKXMLContextPtr_t ColumnsElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::column :
     get(m_value).m_columns.push_back(IWORKColumns::Column());
-    return std::make_shared<ColumnElement>(getState(), get(m_value).m_columns.back());
+    return allocateContext<ColumnElement>(getState(), get(m_value).m_columns.back());
   default:
     ETONYEK_DEBUG_MSG(("ColumnsElement::element[IWORKPropertyMapElement.cpp]: find unknown element\n"));
   }
@@ -503,7 +503,7 @@ IWORKXMLContextPtr_t LanguageElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::string:
-    return std::make_shared<IWORKStringElement>(getState(), m_lang);
+    return allocateContext<IWORKStringElement>(getState(), m_lang);
   case IWORKToken::NS_URI_SF | IWORKToken::null:
     break;
   default:
@@ -555,7 +555,7 @@ private:
   IWORKXMLContextPtr_t element(int name) override
   {
     if (name==(IWORKToken::NS_URI_SF | IWORKToken::string))
-      return std::make_shared<IWORKStringElement>(Parent::getState(), m_string);
+      return allocateContext<IWORKStringElement>(Parent::getState(), m_string);
     else
       return Parent::element(name);
   }
@@ -618,17 +618,17 @@ IWORKXMLContextPtr_t OverridesElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::inputAngle :
-    return std::make_shared<NumberProperty>(getState(), m_value.m_angle);
+    return allocateContext<NumberProperty>(getState(), m_value.m_angle);
   case IWORKToken::NS_URI_SF | IWORKToken::inputColor :
-    return std::make_shared<ColorProperty>(getState(), m_value.m_color);
+    return allocateContext<ColorProperty>(getState(), m_value.m_color);
   case IWORKToken::NS_URI_SF | IWORKToken::inputDistance :
-    return std::make_shared<NumberProperty>(getState(), m_value.m_offset);
+    return allocateContext<NumberProperty>(getState(), m_value.m_offset);
   case IWORKToken::NS_URI_SF | IWORKToken::inputGlossiness :
-    return std::make_shared<NumberProperty>(getState(), m_value.m_glossiness);
+    return allocateContext<NumberProperty>(getState(), m_value.m_glossiness);
   case IWORKToken::NS_URI_SF | IWORKToken::inputOpacity :
-    return std::make_shared<NumberProperty>(getState(), m_value.m_opacity);
+    return allocateContext<NumberProperty>(getState(), m_value.m_opacity);
   case IWORKToken::NS_URI_SF | IWORKToken::inputRadius :
-    return std::make_shared<NumberProperty>(getState(), m_value.m_radius);
+    return allocateContext<NumberProperty>(getState(), m_value.m_radius);
   default:
     ETONYEK_DEBUG_MSG(("OverridesElement::element[IWORKPropertyMapElement.cpp]: find unknown element\n"));
   }
@@ -693,13 +693,13 @@ IWORKXMLContextPtr_t CoreImageFilterInfoElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::core_image_filter_descriptor :
-    return std::make_shared<IWORKCoreImageFilterDescriptorElement>(getState(), m_isShadow);
+    return allocateContext<IWORKCoreImageFilterDescriptorElement>(getState(), m_isShadow);
   case IWORKToken::NS_URI_SF | IWORKToken::core_image_filter_descriptor_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_descriptorRef);
+    return allocateContext<IWORKRefContext>(getState(), m_descriptorRef);
   case IWORKToken::NS_URI_SF | IWORKToken::overrides :
-    return std::make_shared<OverridesElement>(getState(), m_value);
+    return allocateContext<OverridesElement>(getState(), m_value);
   case IWORKToken::NS_URI_SF | IWORKToken::overrides_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_overridesRef);
+    return allocateContext<IWORKRefContext>(getState(), m_overridesRef);
   default:
     ETONYEK_DEBUG_MSG(("CoreImageFilterInfoElement::element[IWORKPropertyMapElement.cpp]: find unknown element\n"));
   }
@@ -776,12 +776,12 @@ IWORKXMLContextPtr_t FiltersElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::mutable_array:
   case IWORKToken::NS_URI_SF | IWORKToken::array:
-    return std::make_shared<MutableArrayElement>(getState(), getState().getDictionary().m_filters, getState().getDictionary().m_coreImageFilterInfos, m_elements);
+    return allocateContext<MutableArrayElement>(getState(), getState().getDictionary().m_filters, getState().getDictionary().m_coreImageFilterInfos, m_elements);
   case IWORKToken::NS_URI_SF | IWORKToken::mutable_array_ref:
   case IWORKToken::NS_URI_SF | IWORKToken::array_ref:
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   case IWORKToken::NS_URI_SF | IWORKToken::layoutStyle: // useme
-    return std::make_shared<FiltersLayoutStyle>(getState(), m_layout, getState().getDictionary().m_layoutStyles);
+    return allocateContext<FiltersLayoutStyle>(getState(), m_layout, getState().getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::null:
     break;
   default:
@@ -924,43 +924,43 @@ IWORKXMLContextPtr_t IWORKPropertyMapElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::alignment :
-    return std::make_shared<AlignmentElement>(getState(), *m_propMap);
+    return allocateContext<AlignmentElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::baselineShift :
-    return std::make_shared<BaselineShiftElement>(getState(), *m_propMap);
+    return allocateContext<BaselineShiftElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::bold :
-    return std::make_shared<BoldElement>(getState(), *m_propMap);
+    return allocateContext<BoldElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::capitalization :
-    return std::make_shared<CapitalizationElement>(getState(), *m_propMap);
+    return allocateContext<CapitalizationElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::columns :
-    return std::make_shared<ColumnsPropertyElement>(getState(), *m_propMap, getState().getDictionary().m_columnSets);
+    return allocateContext<ColumnsPropertyElement>(getState(), *m_propMap, getState().getDictionary().m_columnSets);
   case IWORKToken::NS_URI_SF | IWORKToken::externalTextWrap:
-    return std::make_shared<ExternalTextWrapElement>(getState(), *m_propMap, getState().getDictionary().m_externalTextWraps);
+    return allocateContext<ExternalTextWrapElement>(getState(), *m_propMap, getState().getDictionary().m_externalTextWraps);
   case IWORKToken::NS_URI_SF | IWORKToken::fill :
-    return std::make_shared<FillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<FillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::filters :
-    return std::make_shared<FiltersElement>(getState(), *m_propMap);
+    return allocateContext<FiltersElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::firstLineIndent :
-    return std::make_shared<FirstLineIndentElement>(getState(), *m_propMap);
+    return allocateContext<FirstLineIndentElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::followingLayoutStyle :
-    return std::make_shared<FollowingLayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
+    return allocateContext<FollowingLayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::followingParagraphStyle :
-    return std::make_shared<FollowingParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
+    return allocateContext<FollowingParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::fontColor :
-    return std::make_shared<FontColorElement>(getState(), *m_propMap);
+    return allocateContext<FontColorElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::fontName :
-    return std::make_shared<FontNameElement>(getState(), *m_propMap);
+    return allocateContext<FontNameElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::fontSize :
-    return std::make_shared<FontSizeElement>(getState(), *m_propMap);
+    return allocateContext<FontSizeElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<GeometryElement>(getState(), *m_propMap);
+    return allocateContext<GeometryElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::headLineEnd :
-    return std::make_shared<HeadLineEndElement>(getState(), *m_propMap);
+    return allocateContext<HeadLineEndElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::italic :
-    return std::make_shared<ItalicElement>(getState(), *m_propMap);
+    return allocateContext<ItalicElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::keepLinesTogether :
-    return std::make_shared<KeepLinesTogetherElement>(getState(), *m_propMap);
+    return allocateContext<KeepLinesTogetherElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::keepWithNext :
-    return std::make_shared<KeepWithNextElement>(getState(), *m_propMap);
+    return allocateContext<KeepWithNextElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::labelCharacterStyle1 :
   case IWORKToken::NS_URI_SF | IWORKToken::labelCharacterStyle2 :
   case IWORKToken::NS_URI_SF | IWORKToken::labelCharacterStyle3 :
@@ -971,47 +971,47 @@ IWORKXMLContextPtr_t IWORKPropertyMapElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::labelCharacterStyle8 :
   case IWORKToken::NS_URI_SF | IWORKToken::labelCharacterStyle9 :
     // CHANGE: this must be used to retrieve some Wingdings bullet character
-    return std::make_shared<LabelCharacterStyleElement>(getState(), *m_propMap, getState().getDictionary().m_characterStyles);
+    return allocateContext<LabelCharacterStyleElement>(getState(), *m_propMap, getState().getDictionary().m_characterStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::language :
-    return std::make_shared<LanguageElement>(getState(), *m_propMap);
+    return allocateContext<LanguageElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::layoutMargins :
-    return std::make_shared<LayoutMarginsElement>(getState(), *m_propMap, getState().getDictionary().m_paddings);
+    return allocateContext<LayoutMarginsElement>(getState(), *m_propMap, getState().getDictionary().m_paddings);
   case IWORKToken::NS_URI_SF | IWORKToken::layoutParagraphStyle :
-    return std::make_shared<LayoutParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
+    return allocateContext<LayoutParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::layoutStyle :
-    return std::make_shared<LayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
+    return allocateContext<LayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::leftIndent :
-    return std::make_shared<LeftIndentElement>(getState(), *m_propMap);
+    return allocateContext<LeftIndentElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::lineSpacing :
-    return std::make_shared<LineSpacingElement>(getState(), *m_propMap, getState().getDictionary().m_lineSpacings);
+    return allocateContext<LineSpacingElement>(getState(), *m_propMap, getState().getDictionary().m_lineSpacings);
   case IWORKToken::NS_URI_SF | IWORKToken::listLabelGeometries :
-    return std::make_shared<IWORKListLabelGeometriesProperty>(getState(), *m_propMap);
+    return allocateContext<IWORKListLabelGeometriesProperty>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::listLabelIndents :
-    return std::make_shared<IWORKListLabelIndentsProperty>(getState(), *m_propMap);
+    return allocateContext<IWORKListLabelIndentsProperty>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::listLabelTypes :
-    return std::make_shared<IWORKListLabelTypesProperty>(getState(), *m_propMap);
+    return allocateContext<IWORKListLabelTypesProperty>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::listStyle :
-    return std::make_shared<ListStyleElement>(getState(), *m_propMap, getState().getDictionary().m_listStyles);
+    return allocateContext<ListStyleElement>(getState(), *m_propMap, getState().getDictionary().m_listStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::listTextIndents :
-    return std::make_shared<IWORKListTextIndentsProperty>(getState(), *m_propMap);
+    return allocateContext<IWORKListTextIndentsProperty>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::opacity :
-    return std::make_shared<OpacityElement>(getState(), *m_propMap);
+    return allocateContext<OpacityElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::outline :
-    return std::make_shared<OutlineElement>(getState(), *m_propMap);
+    return allocateContext<OutlineElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::padding :
-    return std::make_shared<PaddingContext>(getState(), *m_propMap, getState().getDictionary().m_paddings);
+    return allocateContext<PaddingContext>(getState(), *m_propMap, getState().getDictionary().m_paddings);
   case IWORKToken::NS_URI_SF | IWORKToken::pageBreakBefore :
-    return std::make_shared<PageBreakBeforeElement>(getState(), *m_propMap);
+    return allocateContext<PageBreakBeforeElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::paragraphBorderType :
-    return std::make_shared<ParagraphBorderTypeElement>(getState(), *m_propMap);
+    return allocateContext<ParagraphBorderTypeElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::paragraphFill :
-    return std::make_shared<ParagraphFillElement>(getState(), *m_propMap);
+    return allocateContext<ParagraphFillElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::paragraphStroke :
-    return std::make_shared<ParagraphStrokeElement>(getState(), *m_propMap);
+    return allocateContext<ParagraphStrokeElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::rightIndent :
-    return std::make_shared<RightIndentElement>(getState(), *m_propMap);
+    return allocateContext<RightIndentElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::tailLineEnd :
-    return std::make_shared<TailLineEndElement>(getState(), *m_propMap);
+    return allocateContext<TailLineEndElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::Series_0 :
   case IWORKToken::NS_URI_SF | IWORKToken::Series_1 :
   case IWORKToken::NS_URI_SF | IWORKToken::Series_2 :
@@ -1021,109 +1021,109 @@ IWORKXMLContextPtr_t IWORKPropertyMapElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::Series_6 :
   case IWORKToken::NS_URI_SF | IWORKToken::Series_7 :
     // CHANGEME
-    return std::make_shared<SFSeriesElement>(getState(), *m_propMap, getState().getDictionary().m_chartSeriesStyles);
+    return allocateContext<SFSeriesElement>(getState(), *m_propMap, getState().getDictionary().m_chartSeriesStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC2DAreaFillProperty :
-    return std::make_shared<SFC2DAreaFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC2DAreaFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC2DColumnFillProperty :
-    return std::make_shared<SFC2DColumnFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC2DColumnFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC2DMixedColumnFillProperty :
-    return std::make_shared<SFC2DMixedColumnFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC2DMixedColumnFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC2DPieFillProperty :
-    return std::make_shared<SFC2DPieFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC2DPieFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC3DAreaFillProperty :
-    return std::make_shared<SFC3DAreaFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC3DAreaFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC3DColumnFillProperty :
-    return std::make_shared<SFC3DColumnFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC3DColumnFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFC3DPieFillProperty :
-    return std::make_shared<SFC2DPieFillPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFC2DPieFillPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTableCellStylePropertyFill :
-    return std::make_shared<SFTableCellStylePropertyFillElement>(getState(), *m_propMap);
+    return allocateContext<SFTableCellStylePropertyFillElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTableStylePropertyCellStyle :
-    return std::make_shared<SFTableStylePropertyCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
+    return allocateContext<SFTableStylePropertyCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTableStylePropertyHeaderColumnCellStyle :
-    return std::make_shared<SFTableStylePropertyHeaderColumnCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
+    return allocateContext<SFTableStylePropertyHeaderColumnCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTableStylePropertyHeaderRowCellStyle :
-    return std::make_shared<SFTableStylePropertyHeaderRowCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
+    return allocateContext<SFTableStylePropertyHeaderRowCellStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tableCellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTCellStylePropertyNumberFormat :
-    return std::make_shared<SFTCellStylePropertyNumberFormatElement>(getState(), *m_propMap, getState().getDictionary().m_numberFormats);
+    return allocateContext<SFTCellStylePropertyNumberFormatElement>(getState(), *m_propMap, getState().getDictionary().m_numberFormats);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTCellStylePropertyDateTimeFormat :
-    return std::make_shared<SFTCellStylePropertyDateTimeFormatElement>(getState(), *m_propMap, getState().getDictionary().m_dateTimeFormats);
+    return allocateContext<SFTCellStylePropertyDateTimeFormatElement>(getState(), *m_propMap, getState().getDictionary().m_dateTimeFormats);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTCellStylePropertyDurationFormat :
-    return std::make_shared<SFTCellStylePropertyDurationFormatElement>(getState(), *m_propMap, getState().getDictionary().m_durationFormats);
+    return allocateContext<SFTCellStylePropertyDurationFormatElement>(getState(), *m_propMap, getState().getDictionary().m_durationFormats);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTCellStylePropertyLayoutStyle :
-    return std::make_shared<SFTCellStylePropertyLayoutStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
+    return allocateContext<SFTCellStylePropertyLayoutStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTCellStylePropertyParagraphStyle :
-    return std::make_shared<SFTCellStylePropertyParagraphStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
+    return allocateContext<SFTCellStylePropertyParagraphStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultBodyCellStyleProperty :
-    return std::make_shared<SFTDefaultBodyCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
+    return allocateContext<SFTDefaultBodyCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultBodyVectorStyleProperty :
-    return std::make_shared<SFTDefaultBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultBorderVectorStyleProperty :
-    return std::make_shared<SFTDefaultBorderVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultBorderVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultFooterBodyVectorStyleProperty :
-    return std::make_shared<SFTDefaultFooterBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultFooterBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultFooterRowCellStyleProperty :
-    return std::make_shared<SFTDefaultFooterRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
+    return allocateContext<SFTDefaultFooterRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultFooterSeparatorVectorStyleProperty :
-    return std::make_shared<SFTDefaultFooterSeparatorVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultFooterSeparatorVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel0VectorStyleProperty:
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel1VectorStyleProperty:
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel2VectorStyleProperty:
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel3VectorStyleProperty:
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel4VectorStyleProperty:
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingLevel5VectorStyleProperty:
-    return std::make_shared<SFTDefaultGroupingLevelVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultGroupingLevelVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell0StyleProperty :
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell1StyleProperty :
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell2StyleProperty :
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell3StyleProperty :
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell4StyleProperty :
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultGroupingRowCell5StyleProperty :
-    return std::make_shared<SFTDefaultGroupingRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
+    return allocateContext<SFTDefaultGroupingRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultHeaderBodyVectorStyleProperty :
-    return std::make_shared<SFTDefaultHeaderBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultHeaderBodyVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultHeaderColumnCellStyleProperty :
-    return std::make_shared<SFTDefaultHeaderColumnCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
+    return allocateContext<SFTDefaultHeaderColumnCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultHeaderRowCellStyleProperty :
-    return std::make_shared<SFTDefaultHeaderRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
+    return allocateContext<SFTDefaultHeaderRowCellStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_cellStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTDefaultHeaderSeparatorVectorStyleProperty :
-    return std::make_shared<SFTDefaultHeaderSeparatorVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
+    return allocateContext<SFTDefaultHeaderSeparatorVectorStylePropertyElement>(getState(), *m_propMap, getState().getDictionary().m_vectorStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTTableNameStylePropertyLayoutStyle :
-    return std::make_shared<SFTTableNameStylePropertyLayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
+    return allocateContext<SFTTableNameStylePropertyLayoutStyleElement>(getState(), *m_propMap, getState().getDictionary().m_layoutStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTTableNameStylePropertyParagraphStyle :
-    return std::make_shared<SFTTableNameStylePropertyParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
+    return allocateContext<SFTTableNameStylePropertyParagraphStyleElement>(getState(), *m_propMap, getState().getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTHeaderColumnRepeatsProperty :
-    return std::make_shared<SFTHeaderColumnRepeatsPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFTHeaderColumnRepeatsPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTHeaderRowRepeatsProperty :
-    return std::make_shared<SFTHeaderRowRepeatsPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFTHeaderRowRepeatsPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTStrokeProperty :
-    return std::make_shared<SFTStrokePropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFTStrokePropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::SFTTableBandedRowsProperty :
-    return std::make_shared<SFTTableBandedRowsPropertyElement>(getState(), *m_propMap);
+    return allocateContext<SFTTableBandedRowsPropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::spaceAfter :
-    return std::make_shared<SpaceAfterElement>(getState(), *m_propMap);
+    return allocateContext<SpaceAfterElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::spaceBefore :
-    return std::make_shared<SpaceBeforeElement>(getState(), *m_propMap);
+    return allocateContext<SpaceBeforeElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::strikethru :
-    return std::make_shared<StrikethruElement>(getState(), *m_propMap);
+    return allocateContext<StrikethruElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::stroke :
-    return std::make_shared<StrokePropertyElement>(getState(), *m_propMap);
+    return allocateContext<StrokePropertyElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::superscript :
-    return std::make_shared<SuperscriptElement>(getState(), *m_propMap);
+    return allocateContext<SuperscriptElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::tabs :
-    return std::make_shared<TabsProperty>(getState(), *m_propMap);
+    return allocateContext<TabsProperty>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::textBackground :
-    return std::make_shared<TextBackgroundElement>(getState(), *m_propMap);
+    return allocateContext<TextBackgroundElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::tocStyle :
-    return std::make_shared<TocStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tocStyles, getState().getDictionary().m_paragraphStyles);
+    return allocateContext<TocStyleElement>(getState(), *m_propMap, getState().getDictionary().m_tocStyles, getState().getDictionary().m_paragraphStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::tracking :
-    return std::make_shared<TrackingElement>(getState(), *m_propMap);
+    return allocateContext<TrackingElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::underline :
-    return std::make_shared<UnderlineElement>(getState(), *m_propMap);
+    return allocateContext<UnderlineElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::verticalAlignment :
-    return std::make_shared<VerticalAlignmentElement>(getState(), *m_propMap);
+    return allocateContext<VerticalAlignmentElement>(getState(), *m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::widowControl :
-    return std::make_shared<WidowControlElement>(getState(), *m_propMap);
+    return allocateContext<WidowControlElement>(getState(), *m_propMap);
   default:
     if (name)
     {
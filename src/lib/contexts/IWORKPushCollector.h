@@ -34,7 +34,7 @@ public:
   template<class Context, class State>
   IWORKXMLContextPtr_t makeContext(State &state)
   {
-    return std::make_shared<Context>(state, m_value);
+    return allocateContext<Context>(state, m_value);
   }
 
   bool pending() const
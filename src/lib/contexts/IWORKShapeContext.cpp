@@ -83,15 +83,15 @@ IWORKXMLContextPtr_t IWORKShapeContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::geometry :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::path :
-    return std::make_shared<IWORKPathElement>(getState());
+    return allocateContext<IWORKPathElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::style :
-    return std::make_shared<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
+    return allocateContext<GraphicStyleContext>(getState(), m_style, getState().getDictionary().m_graphicStyles);
   case IWORKToken::NS_URI_SF | IWORKToken::text :
-    return std::make_shared<IWORKTextElement>(getState());
+    return allocateContext<IWORKTextElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::wrap : // USEME
-    return std::make_shared<IWORKWrapElement>(getState(), m_wrap);
+    return allocateContext<IWORKWrapElement>(getState(), m_wrap);
   default:
     ETONYEK_DEBUG_MSG(("IWORKShapeContext::element: find some unknown element\n"));
     break;
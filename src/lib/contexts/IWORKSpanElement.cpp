@@ -51,7 +51,7 @@ IWORKXMLContextPtr_t IWORKSpanElement::element(const int name)
   case IWORKToken::NS_URI_SF | IWORKToken::intratopicbr :
   case IWORKToken::NS_URI_SF | IWORKToken::lnbr :
     ensureOpened();
-    return std::make_shared<IWORKBrContext>(getState());
+    return allocateContext<IWORKBrContext>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::contbr :
     m_delayedBreak=IWORK_BREAK_COLUMN;
     return IWORKXMLContextPtr_t();
@@ -60,19 +60,19 @@ IWORKXMLContextPtr_t IWORKSpanElement::element(const int name)
     return IWORKXMLContextPtr_t();
   case IWORKToken::NS_URI_SF | IWORKToken::tab :
     ensureOpened();
-    return std::make_shared<IWORKTabElement>(getState());
+    return allocateContext<IWORKTabElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::date_time :
     ensureOpened();
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_DATETIME);
   case IWORKToken::NS_URI_SF | IWORKToken::filename :
     ensureOpened();
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_FILENAME);
   case IWORKToken::NS_URI_SF | IWORKToken::page_count :
     ensureOpened();
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGECOUNT);
   case IWORKToken::NS_URI_SF | IWORKToken::page_number :
     ensureOpened();
-    return std::make_shared<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
+    return allocateContext<IWORKFieldElement>(getState(),IWORK_FIELD_PAGENUMBER);
   case IWORKToken::NS_URI_SF | IWORKToken::insertion_point :
     return IWORKXMLContextPtr_t();
   default:
@@ -78,10 +78,10 @@ IWORKXMLContextPtr_t IWORKStyleContainer<TokenId, RefTokenId, TokenId2, RefToken
   switch (name)
   {
   case TokenId :
-    m_context = std::make_shared<IWORKStyleContext>(getState(), &m_styleMap);
+    m_context = allocateContext<IWORKStyleContext>(getState(), &m_styleMap);
     return m_context;
   case RefTokenId :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   case IWORKToken::NS_URI_SF | IWORKToken::null:
     return IWORKXMLContextPtr_t();
   case IWORKToken::INVALID_TOKEN: // TokenId2 and RefTokenId2 are optional, so avoid unintentional match
@@ -90,11 +90,11 @@ IWORKXMLContextPtr_t IWORKStyleContainer<TokenId, RefTokenId, TokenId2, RefToken
     if (!name) break;
     if (name==TokenId2)
     {
-      m_context = std::make_shared<IWORKStyleContext>(getState(), m_styleMap2);
+      m_context = allocateContext<IWORKStyleContext>(getState(), m_styleMap2);
       return m_context;
     }
     if (name==RefTokenId2)
-      return std::make_shared<IWORKRefContext>(getState(), m_ref2);
+      return allocateContext<IWORKRefContext>(getState(), m_ref2);
     break;
   }
   ETONYEK_DEBUG_MSG(("IWORKStyleContainer<...>::element: unknown element %d\n", name));
@@ -81,7 +81,7 @@ IWORKXMLContextPtr_t TableCellContentElement::element(const int name)
   {
   case IWORKToken::text_storage | IWORKToken::NS_URI_SF :
     getState().m_tableData->m_type = IWORK_CELL_TYPE_TEXT;
-    return std::make_shared<IWORKTextStorageElement>(getState());
+    return allocateContext<IWORKTextStorageElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("TableCellContentElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -126,7 +126,7 @@ IWORKXMLContextPtr_t TableCellValueElement::element(const int name)
   {
   case IWORKToken::number | IWORKToken::NS_URI_SF :
     getState().m_tableData->m_type = IWORK_CELL_TYPE_NUMBER;
-    return std::make_shared<IWORKNumberElement<double> >(getState(), m_value);
+    return allocateContext<IWORKNumberElement<double> >(getState(), m_value);
   default:
     ETONYEK_DEBUG_MSG(("TableCellValueElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
   }
@@ -194,21 +194,21 @@ IWORKXMLContextPtr_t TableCellElement::element(const int name)
   switch (name)
   {
   case IWORKToken::tableCellStyle_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   case IWORKToken::tableCellMinXSide_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_minXBorderRef);
+    return allocateContext<IWORKRefContext>(getState(), m_minXBorderRef);
   case IWORKToken::tableCellMaxXSide_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_maxXBorderRef);
+    return allocateContext<IWORKRefContext>(getState(), m_maxXBorderRef);
   case IWORKToken::tableCellMinYSide_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_minYBorderRef);
+    return allocateContext<IWORKRefContext>(getState(), m_minYBorderRef);
   case IWORKToken::tableCellMaxYSide_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_maxYBorderRef);
+    return allocateContext<IWORKRefContext>(getState(), m_maxYBorderRef);
   case IWORKToken::tableCellContent | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableCellContentElement>(getState());
+    return allocateContext<TableCellContentElement>(getState());
   case IWORKToken::tableCellFormula | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKTableCellFormulaElement>(getState());
+    return allocateContext<IWORKTableCellFormulaElement>(getState());
   case IWORKToken::tableCellValue | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableCellValueElement>(getState());
+    return allocateContext<TableCellValueElement>(getState());
   default:
     ETONYEK_DEBUG_MSG(("TableCellElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -372,9 +372,9 @@ IWORKXMLContextPtr_t TableModelCellsElement::element(const int name)
   switch (name)
   {
   case IWORKToken::tableCellArrayCellsByColumn | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableCellArrayElement>(getState(), m_dict, getState().getDictionary().m_tableCells, m_columnsCell);
+    return allocateContext<TableCellArrayElement>(getState(), m_dict, getState().getDictionary().m_tableCells, m_columnsCell);
   case IWORKToken::tableCellArrayCellsByRow | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableCellArrayElement>(getState(), m_dict, getState().getDictionary().m_tableCells, m_rowsCell);
+    return allocateContext<TableCellArrayElement>(getState(), m_dict, getState().getDictionary().m_tableCells, m_rowsCell);
   default:
     ETONYEK_DEBUG_MSG(("TableModelCellsElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -440,7 +440,7 @@ IWORKXMLContextPtr_t TableVectorElement::element(const int name)
   switch (name)
   {
   case IWORKToken::tableVectorStyle_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   default:
     ETONYEK_DEBUG_MSG(("TableVectorElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -490,9 +490,9 @@ IWORKXMLContextPtr_t TableModelVectorsElement::element(const int name)
   switch (name)
   {
   case IWORKToken::tableVectorArrayColumnVectors | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableVectorArrayElement>(getState(), m_dict, getState().getDictionary().m_tableVectors, m_columnsVector);
+    return allocateContext<TableVectorArrayElement>(getState(), m_dict, getState().getDictionary().m_tableVectors, m_columnsVector);
   case IWORKToken::tableVectorArrayRowVectors | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableVectorArrayElement>(getState(), m_dict, getState().getDictionary().m_tableVectors, m_rowsVector);
+    return allocateContext<TableVectorArrayElement>(getState(), m_dict, getState().getDictionary().m_tableVectors, m_rowsVector);
   default:
     ETONYEK_DEBUG_MSG(("TableModelVectorsElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -617,15 +617,15 @@ IWORKXMLContextPtr_t TableInfoTableElement::element(const int name)
   switch (name)
   {
   case IWORKToken::tableModelStyle_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   case IWORKToken::tableModelPartitionSource | IWORKToken::NS_URI_SF : // contains id + frame data
     break;
   case IWORKToken::tableModelVectors | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableModelVectorsElement>(getState(), m_columnsVector, m_rowsVector);
+    return allocateContext<TableModelVectorsElement>(getState(), m_columnsVector, m_rowsVector);
   case IWORKToken::tableModelCells | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableModelCellsElement>(getState(), m_columnsCell, m_rowsCell);
+    return allocateContext<TableModelCellsElement>(getState(), m_columnsCell, m_rowsCell);
   case IWORKToken::tableModelTableID | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKStringElement>(getState(), m_tableId);
+    return allocateContext<IWORKStringElement>(getState(), m_tableId);
   default:
     ETONYEK_DEBUG_MSG(("TableInfoTableElement::element[IWORKTableInfoElement.cpp]: find some unknown element\n"));
     break;
@@ -670,13 +670,13 @@ IWORKXMLContextPtr_t IWORKTableInfoElement::element(const int name)
   switch (name)
   {
   case IWORKToken::geometry | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKGeometryElement>(getState());
+    return allocateContext<IWORKGeometryElement>(getState());
   case IWORKToken::style | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableStyleContext>(getState(), m_style, getState().getDictionary().m_tableStyles);
+    return allocateContext<TableStyleContext>(getState(), m_style, getState().getDictionary().m_tableStyles);
   case IWORKToken::tableInfoTable | IWORKToken::NS_URI_SF :
-    return std::make_shared<TableInfoTableElement>(getState());
+    return allocateContext<TableInfoTableElement>(getState());
   case IWORKToken::NS_URI_SF | IWORKToken::wrap : // USEME
-    return std::make_shared<IWORKWrapElement>(getState(), m_wrap);
+    return allocateContext<IWORKWrapElement>(getState(), m_wrap);
   default:
     ETONYEK_DEBUG_MSG(("IWORKTableInfoElement::element: find some unknown element\n"));
   }
@@ -14,8 +14,6 @@
 #include <memory>
 #include <sstream>
 
-#include <boost/lexical_cast.hpp>
-
 #include "libetonyek_xml.h"
 #include "IWORKCollector.h"
 #include "IWORKDictionary.h"
@@ -35,7 +33,6 @@
 namespace libetonyek
 {
 
-using boost::lexical_cast;
 using boost::optional;
 using std::shared_ptr;
 using std::string;
@@ -65,10 +62,10 @@ void CellCoordinates::attribute(const int name, const char *const value)
   switch (name)
   {
   case IWORKToken::column | IWORKToken::NS_URI_SF :
-    m_column=lexical_cast<unsigned>(value);
+    m_column=unsigned_cast(value);
     break;
   case IWORKToken::row | IWORKToken::NS_URI_SF :
-    m_row=lexical_cast<unsigned>(value);
+    m_row=unsigned_cast(value);
     break;
   default : // none
     IWORKXMLEmptyContextBase::attribute(name, value);
@@ -104,7 +101,7 @@ IWORKXMLContextPtr_t CellCommentMappingKey::element(int name)
   switch (name)
   {
   case IWORKToken::cell_coordinates | IWORKToken::NS_URI_SF :
-    return std::make_shared<CellCoordinates>(getState(), m_coordinates);
+    return allocateContext<CellCoordinates>(getState(), m_coordinates);
   default:
     return IWORKXMLEmptyContextBase::element(name);
   }
@@ -135,9 +132,9 @@ IWORKXMLContextPtr_t CellCommentMappingPair::element(int name)
   switch (name)
   {
   case IWORKToken::value_ref | IWORKToken::NS_URI_SFA : // attributes: sfa:IDREF and sfa:class
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   case IWORKToken::key | IWORKToken::NS_URI_SFA :
-    return std::make_shared<CellCommentMappingKey>(getState(), m_coordinates);
+    return allocateContext<CellCommentMappingKey>(getState(), m_coordinates);
   default:
     return IWORKXMLEmptyContextBase::element(name);
   }
@@ -173,7 +170,7 @@ IWORKXMLContextPtr_t CellCommentMapping::element(int name)
   switch (name)
   {
   case IWORKToken::pair | IWORKToken::NS_URI_SFA :
-    return std::make_shared<CellCommentMappingPair>(getState(), m_coordinateCommentRefMap);
+    return allocateContext<CellCommentMappingPair>(getState(), m_coordinateCommentRefMap);
   default:
     return IWORKXMLEmptyContextBase::element(name);
   }
@@ -226,11 +223,11 @@ IWORKXMLContextPtr_t CfElement::element(int name)
   switch (name)
   {
   case IWORKToken::date_format | IWORKToken::NS_URI_SF : // USEME
-    return std::make_shared<IWORKDateTimeFormatElement>(getState(), m_dateTimeFormat);
+    return allocateContext<IWORKDateTimeFormatElement>(getState(), m_dateTimeFormat);
   case IWORKToken::duration_format | IWORKToken::NS_URI_SF : // USEME
-    return std::make_shared<IWORKDurationFormatElement>(getState(), m_durationFormat);
+    return allocateContext<IWORKDurationFormatElement>(getState(), m_durationFormat);
   case IWORKToken::number_format | IWORKToken::NS_URI_SF : // USEME
-    return std::make_shared<IWORKNumberFormatElement>(getState(), m_numberFormat);
+    return allocateContext<IWORKNumberFormatElement>(getState(), m_numberFormat);
   default:
     ETONYEK_DEBUG_MSG(("CfElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -268,13 +265,13 @@ void CellContextBase::attribute(const int name, const char *const value)
   switch (name)
   {
   case IWORKToken::col_span | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_columnSpan = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_columnSpan = unsigned_cast(value);
     break;
   case IWORKToken::ct | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_cellMove = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_cellMove = unsigned_cast(value);
     break;
   case IWORKToken::row_span | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_rowSpan = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_rowSpan = unsigned_cast(value);
     break;
   case IWORKToken::s | IWORKToken::NS_URI_SF :
     getState().m_tableData->m_style = getState().getStyleByName(value, getState().getDictionary().m_cellStyles);
@@ -296,9 +293,9 @@ IWORKXMLContextPtr_t CellContextBase::element(int name)
   switch (name)
   {
   case IWORKToken::cf | IWORKToken::NS_URI_SF :
-    return std::make_shared<CfElement>(getState());
+    return allocateContext<CfElement>(getState());
   case IWORKToken::cf_ref | IWORKToken::NS_URI_SF:
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
   default:
     ETONYEK_DEBUG_MSG(("CellContextBase::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -407,7 +404,7 @@ void GridColumnElement::attribute(const int name, const char *const value)
   case IWORKToken::preferred_width | IWORKToken::NS_URI_SF :
     break;
   case IWORKToken::width | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_columnSizes.push_back(IWORKColumnRowSize(lexical_cast<double>(value)));
+    getState().m_tableData->m_columnSizes.push_back(IWORKColumnRowSize(double_cast(value)));
     break;
   default :
     ETONYEK_DEBUG_MSG(("GridColumnElement::attribute[IWORKTabularModelElement.cpp]: find some unknown attribute\n"));
@@ -460,7 +457,7 @@ IWORKXMLContextPtr_t ColumnsElement::element(const int name)
   switch (name)
   {
   case IWORKToken::grid_column | IWORKToken::NS_URI_SF :
-    return std::make_shared<GridColumnElement>(getState());
+    return allocateContext<GridColumnElement>(getState());
   default:
     ETONYEK_DEBUG_MSG(("ColumnsElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -608,7 +605,7 @@ IWORKXMLContextPtr_t CtElement::element(const int name)
     {
       ETONYEK_DEBUG_MSG(("found a text cell with both simple and formatted content\n"));
     }
-    return std::make_shared<IWORKTextStorageElement>(getState());
+    return allocateContext<IWORKTextStorageElement>(getState());
   default :
     ETONYEK_DEBUG_MSG(("CtElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
     break;
@@ -720,7 +717,7 @@ IWORKXMLContextPtr_t TElement::element(const int name)
   case IWORKToken::ct | IWORKToken::NS_URI_SF :
     if (m_isResult && !getState().m_currentText)
       getState().m_currentText = getCollector().createText(getState().m_langManager, false);
-    return std::make_shared<CtElement>(getState());
+    return allocateContext<CtElement>(getState());
   default:
     break;
   }
@@ -782,16 +779,16 @@ IWORKXMLContextPtr_t RElement::element(int name)
   switch (name)
   {
   case IWORKToken::rb | IWORKToken::NS_URI_SF :
-    return std::make_shared<RbElement>(getState());
+    return allocateContext<RbElement>(getState());
     break;
   case IWORKToken::rd | IWORKToken::NS_URI_SF :
-    return std::make_shared<DElement>(getState(), true);
+    return allocateContext<DElement>(getState(), true);
     break;
   case IWORKToken::rn | IWORKToken::NS_URI_SF :
-    return std::make_shared<NElement>(getState(), true);
+    return allocateContext<NElement>(getState(), true);
     break;
   case IWORKToken::rt | IWORKToken::NS_URI_SF :
-    return std::make_shared<TElement>(getState(), true);
+    return allocateContext<TElement>(getState(), true);
     break;
   default:
     break;
@@ -825,11 +822,11 @@ IWORKXMLContextPtr_t FElement::element(int name)
   switch (name)
   {
   case IWORKToken::fo | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKFoElement>(getState());
+    return allocateContext<IWORKFoElement>(getState());
   case IWORKToken::of | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKOfElement>(getState());
+    return allocateContext<IWORKOfElement>(getState());
   case IWORKToken::r | IWORKToken::NS_URI_SF :
-    return std::make_shared<RElement>(getState());
+    return allocateContext<RElement>(getState());
   default:
     break;
   }
@@ -901,7 +898,7 @@ IWORKXMLContextPtr_t GroupingElement::element(int name)
     return IWORKXMLContextPtr_t();
   }
   case IWORKToken::fo | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKFoElement>(getState());
+    return allocateContext<IWORKFoElement>(getState());
   default:
     break;
   }
@@ -1027,7 +1024,7 @@ MenuChoicesElement::MenuChoicesElement(IWORKXMLParserState &state, std::map<ID_t
 IWORKXMLContextPtr_t MenuChoicesElement::element(int name)
 {
   if (name == (IWORKToken::t | IWORKToken::NS_URI_SF))
-    return std::make_shared<TElementInMenu>(getState(), m_contentMap);
+    return allocateContext<TElementInMenu>(getState(), m_contentMap);
 
   return IWORKXMLContextPtr_t();
 }
@@ -1041,10 +1038,10 @@ IWORKXMLContextPtr_t PmElement::element(int name)
   switch (name)
   {
   case IWORKToken::menu_choices | IWORKToken::NS_URI_SF :
-    return std::make_shared<MenuChoicesElement>(getState(), m_contentMap);
+    return allocateContext<MenuChoicesElement>(getState(), m_contentMap);
     break;
   case IWORKToken::proxied_cell_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_ref);
+    return allocateContext<IWORKRefContext>(getState(), m_ref);
     break;
   default:
     ETONYEK_DEBUG_MSG(("PmElement::element[IWORKTabularModelElement.cpp]: found unexpected element\n"));
@@ -1102,7 +1099,7 @@ void SElement::attribute(const int name, const char *const value)
   switch (name)
   {
   case IWORKToken::ct | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_cellMove = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_cellMove = unsigned_cast(value);
     break;
   case IWORKToken::ho | IWORKToken::NS_URI_SF : // offset to main cell
   case IWORKToken::vo | IWORKToken::NS_URI_SF :
@@ -1283,10 +1280,10 @@ void GenericCellElement::attribute(const int name, const char *const value)
     getState().m_tableData->m_row = (unsigned) int_cast(value);
     break;
   case IWORKToken::col_span | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_columnSpan = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_columnSpan = unsigned_cast(value);
     break;
   case IWORKToken::row_span | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_rowSpan = lexical_cast<unsigned>(value);
+    getState().m_tableData->m_rowSpan = unsigned_cast(value);
     break;
   default :
     ETONYEK_DEBUG_MSG(("GenericCellElement::attribute[IWORKTabularModelElement.cpp]: found unexpected attribute\n"));
@@ -1298,9 +1295,9 @@ IWORKXMLContextPtr_t GenericCellElement::element(int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::cell_style_ref :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
   case IWORKToken::NS_URI_SF | IWORKToken::content_size :
-    return std::make_shared<ContentSizeElement>(getState());
+    return allocateContext<ContentSizeElement>(getState());
   default:
     break;
   }
@@ -1535,7 +1532,7 @@ IWORKXMLContextPtr_t TextCellElement::element(const int name)
   switch (name)
   {
   case IWORKToken::cell_text | IWORKToken::NS_URI_SF :
-    return std::make_shared<CtElement>(getState());
+    return allocateContext<CtElement>(getState());
   default:
     break;
   }
@@ -1569,13 +1566,13 @@ IWORKXMLContextPtr_t ResultCellElement::element(int name)
   switch (name)
   {
   case IWORKToken::result_bool_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<BoolCellElement>(getState(), true);
+    return allocateContext<BoolCellElement>(getState(), true);
   case IWORKToken::result_date_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<DateCellElement>(getState(), true);
+    return allocateContext<DateCellElement>(getState(), true);
   case IWORKToken::result_number_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<NumberCellElement>(getState(), true);
+    return allocateContext<NumberCellElement>(getState(), true);
   case IWORKToken::result_text_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<TextCellElement>(getState(), true);
+    return allocateContext<TextCellElement>(getState(), true);
   default:
     break;
   }
@@ -1606,9 +1603,9 @@ IWORKXMLContextPtr_t FormulaCellElement::element(int name)
   switch (name)
   {
   case IWORKToken::formula | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKFormulaElement>(getState());
+    return allocateContext<IWORKFormulaElement>(getState());
   case IWORKToken::result_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<ResultCellElement>(getState());
+    return allocateContext<ResultCellElement>(getState());
   default:
     break;
   }
@@ -1652,43 +1649,43 @@ IWORKXMLContextPtr_t DatasourceElement::element(const int name)
   switch (name)
   {
   case IWORKToken::cb | IWORKToken::NS_URI_SF :
-    return std::make_shared<CbElement>(getState());
+    return allocateContext<CbElement>(getState());
   case IWORKToken::d | IWORKToken::NS_URI_SF :
-    return std::make_shared<DElement>(getState());
+    return allocateContext<DElement>(getState());
   case IWORKToken::du | IWORKToken::NS_URI_SF :
-    return std::make_shared<DuElement>(getState());
+    return allocateContext<DuElement>(getState());
   case IWORKToken::f | IWORKToken::NS_URI_SF :
-    return std::make_shared<FElement>(getState());
+    return allocateContext<FElement>(getState());
   case IWORKToken::g | IWORKToken::NS_URI_SF :
-    return std::make_shared<GElement>(getState());
+    return allocateContext<GElement>(getState());
   case IWORKToken::grouping | IWORKToken::NS_URI_SF :
-    return std::make_shared<GroupingElement>(getState());
+    return allocateContext<GroupingElement>(getState());
   case IWORKToken::n | IWORKToken::NS_URI_SF :
-    return std::make_shared<NElement>(getState());
+    return allocateContext<NElement>(getState());
   case IWORKToken::o | IWORKToken::NS_URI_SF :
-    return std::make_shared<OElement>(getState());
+    return allocateContext<OElement>(getState());
   case IWORKToken::pm | IWORKToken::NS_URI_SF :
-    return std::make_shared<PmElement>(getState());
+    return allocateContext<PmElement>(getState());
   case IWORKToken::s | IWORKToken::NS_URI_SF :
-    return std::make_shared<SElement>(getState());
+    return allocateContext<SElement>(getState());
   case IWORKToken::sl | IWORKToken::NS_URI_SF :
-    return std::make_shared<SlElement>(getState());
+    return allocateContext<SlElement>(getState());
   case IWORKToken::st | IWORKToken::NS_URI_SF :
-    return std::make_shared<StElement>(getState());
+    return allocateContext<StElement>(getState());
   case IWORKToken::t | IWORKToken::NS_URI_SF :
-    return std::make_shared<TElement>(getState());
+    return allocateContext<TElement>(getState());
   case IWORKToken::date_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<DateCellElement>(getState());
+    return allocateContext<DateCellElement>(getState());
   case IWORKToken::generic_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<GenericCellElement>(getState());
+    return allocateContext<GenericCellElement>(getState());
   case IWORKToken::formula_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<FormulaCellElement>(getState());
+    return allocateContext<FormulaCellElement>(getState());
   case IWORKToken::number_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<NumberCellElement>(getState());
+    return allocateContext<NumberCellElement>(getState());
   case IWORKToken::span_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<SpanCellElement>(getState());
+    return allocateContext<SpanCellElement>(getState());
   case IWORKToken::text_cell | IWORKToken::NS_URI_SF :
-    return std::make_shared<TextCellElement>(getState());
+    return allocateContext<TextCellElement>(getState());
   default:
     break;
   }
@@ -1801,7 +1798,7 @@ IWORKXMLContextPtr_t StyleRunElement::element(const int name)
   switch (name)
   {
   case IWORKToken::vector_style_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<VectorStyleRefElement>(getState(), m_line);
+    return allocateContext<VectorStyleRefElement>(getState(), m_line);
   default:
     ETONYEK_DEBUG_MSG(("StyleRunElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -1835,7 +1832,6 @@ void StyleRunElement::endOfElement()
 
 }
 
-
 namespace
 {
 
@@ -1863,7 +1859,7 @@ IWORKXMLContextPtr_t GridlineElement::element(const int name)
   switch (name)
   {
   case IWORKToken::style_run | IWORKToken::NS_URI_SF :
-    return std::make_shared<StyleRunElement>(getState(), m_gridLines, m_maxLines);
+    return allocateContext<StyleRunElement>(getState(), m_gridLines, m_maxLines);
   default:
     ETONYEK_DEBUG_MSG(("GridlineElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -1895,7 +1891,7 @@ void GridRowElement::attribute(const int name, const char *const value)
   switch (name)
   {
   case IWORKToken::height | IWORKToken::NS_URI_SF :
-    getState().m_tableData->m_rowSizes.push_back(IWORKColumnRowSize(lexical_cast<double>(value)));
+    getState().m_tableData->m_rowSizes.push_back(IWORKColumnRowSize(double_cast(value)));
     break;
   case IWORKToken::fitting_height | IWORKToken::NS_URI_SF :
   case IWORKToken::manually_sized | IWORKToken::NS_URI_SF :
@@ -1935,7 +1931,7 @@ IWORKXMLContextPtr_t RowsElement::element(const int name)
   switch (name)
   {
   case IWORKToken::grid_row | IWORKToken::NS_URI_SF :
-    return std::make_shared<GridRowElement>(getState());
+    return allocateContext<GridRowElement>(getState());
   default:
     ETONYEK_DEBUG_MSG(("RowsElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -1984,15 +1980,15 @@ IWORKXMLContextPtr_t GridElement::element(const int name)
   switch (name)
   {
   case IWORKToken::columns | IWORKToken::NS_URI_SF :
-    return std::make_shared<ColumnsElement>(getState());
+    return allocateContext<ColumnsElement>(getState());
   case IWORKToken::datasource | IWORKToken::NS_URI_SF :
-    return std::make_shared<DatasourceElement>(getState());
+    return allocateContext<DatasourceElement>(getState());
   case IWORKToken::rows | IWORKToken::NS_URI_SF :
-    return std::make_shared<RowsElement>(getState());
+    return allocateContext<RowsElement>(getState());
   case IWORKToken::vertical_gridline_styles | IWORKToken::NS_URI_SF :
-    return std::make_shared<GridlineElement>(getState(), getState().m_tableData->m_verticalLines, getState().m_tableData->m_numRows);
+    return allocateContext<GridlineElement>(getState(), getState().m_tableData->m_verticalLines, getState().m_tableData->m_numRows);
   case IWORKToken::horizontal_gridline_styles | IWORKToken::NS_URI_SF :
-    return std::make_shared<GridlineElement>(getState(), getState().m_tableData->m_horizontalLines, getState().m_tableData->m_numColumns);
+    return allocateContext<GridlineElement>(getState(), getState().m_tableData->m_horizontalLines, getState().m_tableData->m_numColumns);
   default:
     ETONYEK_DEBUG_MSG(("GridElement::element[IWORKTabularModelElement.cpp]: find some unknown element\n"));
   }
@@ -2059,12 +2055,12 @@ IWORKXMLContextPtr_t IWORKTabularModelElement::element(const int name)
   switch (name)
   {
   case IWORKToken::grid | IWORKToken::NS_URI_SF :
-    return std::make_shared<GridElement>(getState());
+    return allocateContext<GridElement>(getState());
   case IWORKToken::tabular_style_ref | IWORKToken::NS_URI_SF :
-    return std::make_shared<IWORKRefContext>(getState(), m_styleRef);
+    return allocateContext<IWORKRefContext>(getState(), m_styleRef);
 
   case IWORKToken::cell_comment_mapping | IWORKToken::NS_URI_SF :
-    return std::make_shared<CellCommentMapping>(getState(), m_coordinateCommentRefMap);
+    return allocateContext<CellCommentMapping>(getState(), m_coordinateCommentRefMap);
   case IWORKToken::error_warning_mapping | IWORKToken::NS_URI_SF :
   case IWORKToken::filterset | IWORKToken::NS_URI_SF :
   case IWORKToken::grouping_order | IWORKToken::NS_URI_SF :
@@ -110,15 +110,15 @@ IWORKXMLContextPtr_t TransitionAttributesElement::element(const int name)
   {
   case KEY2Token::NS_URI_KEY | KEY2Token::animationAuto :
   case KEY2Token::animationAuto :
-    return std::make_shared<BoolProperty>(getState(), get(m_transition).m_automatic);
+    return allocateContext<BoolProperty>(getState(), get(m_transition).m_automatic);
   case KEY2Token::animationDelay :
   case KEY2Token::NS_URI_KEY | KEY2Token::animationDelay :
-    return std::make_shared<DoubleProperty>(getState(), get(m_transition).m_delay);
+    return allocateContext<DoubleProperty>(getState(), get(m_transition).m_delay);
   case KEY2Token::animationDuration :
   case KEY2Token::NS_URI_KEY | KEY2Token::animationDuration :
-    return std::make_shared<DoubleProperty>(getState(), get(m_transition).m_duration);
+    return allocateContext<DoubleProperty>(getState(), get(m_transition).m_duration);
   case KEY2Token::NS_URI_KEY | KEY2Token::direction :
-    return std::make_shared<IntProperty>(getState(), get(m_transition).m_direction);
+    return allocateContext<IntProperty>(getState(), get(m_transition).m_direction);
   case KEY2Token::NS_URI_KEY | KEY2Token::BGBuildDurationProperty :
     break;
   default:
@@ -174,7 +174,7 @@ IWORKXMLContextPtr_t TransitionElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::transition_attributes :
-    return std::make_shared<TransitionAttributesElement>(getState(), m_transition);
+    return allocateContext<TransitionAttributesElement>(getState(), m_transition);
   default:
     ETONYEK_DEBUG_MSG(("TransitionElement::element[KEY2StyleContext.cpp]: found unexpected element %d\n", name));
     break;
@@ -216,15 +216,15 @@ IWORKXMLContextPtr_t PropertyMapElement::element(const int name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::animationAutoPlay :
   case KEY2Token::NS_URI_KEY | KEY2Token::animationAutoPlay :
-    return std::make_shared<AnimationAutoPlayPropertyElement>(getState(), m_propMap);
+    return allocateContext<AnimationAutoPlayPropertyElement>(getState(), m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::animationDelay :
   case KEY2Token::NS_URI_KEY | KEY2Token::animationDelay :
-    return std::make_shared<AnimationDelayPropertyElement>(getState(), m_propMap);
+    return allocateContext<AnimationDelayPropertyElement>(getState(), m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::animationDuration :
   case KEY2Token::NS_URI_KEY | KEY2Token::animationDuration :
-    return std::make_shared<AnimationDurationPropertyElement>(getState(), m_propMap);
+    return allocateContext<AnimationDurationPropertyElement>(getState(), m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::transition :
-    return std::make_shared<TransitionElement>(getState(), m_transition);
+    return allocateContext<TransitionElement>(getState(), m_transition);
   default:
     break;
   }
@@ -271,7 +271,7 @@ IWORKXMLContextPtr_t KEY2StyleContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::property_map :
-    return std::make_shared<PropertyMapElement>(getState(), m_props);
+    return allocateContext<PropertyMapElement>(getState(), m_props);
   default:
     ETONYEK_DEBUG_MSG(("KEY2StyleContext::element: found unexpected element %d\n", name));
   }
@@ -130,11 +130,11 @@ IWORKXMLContextPtr_t PropertyMapElement::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::evenPageMaster :
-    return std::make_shared<EvenPageMasterElement>(getState(), m_propMap);
+    return allocateContext<EvenPageMasterElement>(getState(), m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::firstPageMaster :
-    return std::make_shared<FirstPageMasterElement>(getState(), m_propMap);
+    return allocateContext<FirstPageMasterElement>(getState(), m_propMap);
   case IWORKToken::NS_URI_SF | IWORKToken::oddPageMaster :
-    return std::make_shared<OddPageMasterElement>(getState(), m_propMap);
+    return allocateContext<OddPageMasterElement>(getState(), m_propMap);
   default:
     break;
   }
@@ -176,7 +176,7 @@ IWORKXMLContextPtr_t PAG1StyleContext::element(const int name)
   switch (name)
   {
   case IWORKToken::NS_URI_SF | IWORKToken::property_map :
-    return std::make_shared<PropertyMapElement>(getState(), m_props);
+    return allocateContext<PropertyMapElement>(getState(), m_props);
   default:
     ETONYEK_DEBUG_MSG(("PAG1StyleContext::element: found unexpected element %d\n", name));
   }
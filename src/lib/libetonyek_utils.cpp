@@ -20,8 +20,6 @@
 namespace libetonyek
 {
 
-using std::numeric_limits;
-using std::vector;
 using std::range_error;
 
 namespace
@@ -105,58 +103,69 @@ uint64_t readU64(const RVNGInputStreamPtr_t &input, bool bigEndian)
   throw EndOfStreamException();
 }
 
-uint64_t readUVar(const RVNGInputStreamPtr_t &input)
+namespace
 {
-  if (!input || input->isEnd())
-    throw EndOfStreamException();
 
-  vector<unsigned char> bytes;
-  bytes.reserve(8);
+/// Maximal length of a varint that can hold a 64-bit value.
+const unsigned MAX_VAR_LENGTH = 10;
 
-  bool cont = true;
-  while (!input->isEnd() && cont)
+void addVarByte(uint64_t &value, const unsigned index, const unsigned char c)
+{
+  const uint64_t bits = c & 0x7f;
+  if (index == MAX_VAR_LENGTH - 1)
   {
-    const unsigned char c = readU8(input);
-    bytes.push_back((unsigned char)(c & ~0x80));
-    cont = c & 0x80;
+    if (bits > 1) // overflow
+      throw range_error("Number too big");
+  }
+  else if (index >= MAX_VAR_LENGTH)
+  {
+    throw range_error("Number too big");
   }
+  value |= bits << (7 * index);
+}
 
-  if (cont && input->isEnd())
-    throw EndOfStreamException();
+}
 
-  uint64_t value = 0;
+namespace detail
+{
 
-  for (vector<unsigned char>::const_reverse_iterator it = bytes.rbegin(); it != bytes.rend(); ++it)
+uint64_t readUVarSlow(const unsigned char *&p, const unsigned char *const end)
+{
+  uint64_t value = 0;
+  for (const unsigned char *it = p; it != end; ++it)
   {
-    if (numeric_limits<uint64_t>::max() >> 7 < value) // overflow
-      throw range_error("Number too big");
-    if (numeric_limits<uint64_t>::max() - (value << 7) < *it) // overflow
-      throw range_error("Number too big");
-    value = (value << 7) + *it;
+    addVarByte(value, unsigned(it - p), *it);
+    if (!(*it & 0x80))
+    {
+      p = it + 1;
+      return value;
+    }
   }
+  throw EndOfStreamException();
+}
 
-  return value;
 }
 
-int64_t readSVar(const RVNGInputStreamPtr_t &input)
+uint64_t readUVar(const RVNGInputStreamPtr_t &input)
 {
-  const uint64_t encoded = readUVar(input);
-  const unsigned mod = encoded % 2;
-
-  const uint64_t val = (encoded / 2 + mod);
+  checkStream(input);
 
-  // sanity check
-  if (!mod && (val > uint64_t(numeric_limits<int64_t>::max())))
-    throw range_error("Number too big");
-  assert(-numeric_limits<int64_t>::max() == numeric_limits<int64_t>::min() + 1);
-  if (mod && (val > 0) && (val - 1 > uint64_t(std::abs(numeric_limits<int64_t>::min() + 1))))
-    throw range_error("Number too small");
+  uint64_t value = 0;
+  for (unsigned i = 0; !input->isEnd(); ++i)
+  {
+    const unsigned char c = readU8(input);
+    addVarByte(value, i, c);
+    if (!(c & 0x80))
+      return value;
+  }
 
-  // special handling, as the abs. value of minimal int64_t number doesn't fit into int64_t
-  if (mod && (val > 0) && (val - 1 == uint64_t(std::abs(numeric_limits<int64_t>::min() + 1))))
-    return numeric_limits<int64_t>::min();
+  throw EndOfStreamException();
+}
 
-  return mod ? -int64_t(val) : int64_t(val);
+int64_t readSVar(const RVNGInputStreamPtr_t &input)
+{
+  const uint64_t encoded = readUVar(input);
+  return int64_t(encoded >> 1) ^ -int64_t(encoded & 1);
 }
 
 double readDouble(const RVNGInputStreamPtr_t &input)
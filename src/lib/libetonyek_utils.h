@@ -15,6 +15,7 @@
 #endif
 
 #include <cmath>
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -89,6 +90,26 @@ uint64_t readU64(const RVNGInputStreamPtr_t &input, bool bigEndian=false);
 uint64_t readUVar(const RVNGInputStreamPtr_t &input);
 int64_t readSVar(const RVNGInputStreamPtr_t &input);
 
+/** Read an unsigned varint from a contiguous buffer.
+  *
+  * This is the fast counterpart of readUVar(const RVNGInputStreamPtr_t &),
+  * intended for data that are already in memory.
+  *
+  * @arg[in,out] p the current position in the buffer; it is advanced
+  *   past the read value
+  * @arg[in] end the end of the buffer
+  * @returns the read value
+  * @throws EndOfStreamException if the value is not complete
+  * @throws std::range_error if the value does not fit into 64 bits
+  */
+inline uint64_t readUVar(const unsigned char *&p, const unsigned char *end);
+
+/** Read a signed (zigzag-encoded) varint from a contiguous buffer.
+  *
+  * @see readUVar(const unsigned char *&, const unsigned char *)
+  */
+inline int64_t readSVar(const unsigned char *&p, const unsigned char *end);
+
 double readDouble(const RVNGInputStreamPtr_t &input);
 float readFloat(const RVNGInputStreamPtr_t &input);
 
@@ -154,6 +175,33 @@ class GenericException
 {
 };
 
+namespace detail
+{
+
+uint64_t readUVarSlow(const unsigned char *&p, const unsigned char *end);
+
+}
+
+uint64_t readUVar(const unsigned char *&p, const unsigned char *const end)
+{
+  // most values in IWA files are small: lengths, ids, enums
+  if ((p != end) && !(p[0] & 0x80))
+    return *p++;
+  if ((end - p >= 2) && !(p[1] & 0x80))
+  {
+    const uint64_t value = uint64_t(p[0] & 0x7f) | (uint64_t(p[1]) << 7);
+    p += 2;
+    return value;
+  }
+  return detail::readUVarSlow(p, end);
+}
+
+int64_t readSVar(const unsigned char *&p, const unsigned char *const end)
+{
+  const uint64_t encoded = readUVar(p, end);
+  return int64_t(encoded >> 1) ^ -int64_t(encoded & 1);
+}
+
 } // namespace libetonyek
 
 #endif // LIBETONYEK_UTILS_H_INCLUDED
@@ -10,8 +10,14 @@
 #include "libetonyek_xml.h"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
 
-#include <boost/lexical_cast.hpp>
+#include <boost/lexical_cast/bad_lexical_cast.hpp>
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
 
@@ -20,7 +26,6 @@
 #include "IWORKTokenizer.h"
 
 using boost::bad_lexical_cast;
-using boost::lexical_cast;
 using boost::none;
 using boost::optional;
 
@@ -53,6 +58,97 @@ extern "C" int closeStream(void * /* context */)
 namespace libetonyek
 {
 
+namespace
+{
+
+const int MAX_MANTISSA_DIGITS = 19;
+const uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+const int MAX_EXACT_POWER = 22;
+const int MAX_EXPONENT = 100000;
+
+const double POWERS_OF_10[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+bool isDigit(const char c)
+{
+  return (c >= '0') && (c <= '9');
+}
+
+/// Check for a case-insensitive match of a lowercase word.
+bool matchWord(const char *const begin, const char *const end, const char *const word)
+{
+  const std::size_t length = std::strlen(word);
+  if (std::size_t(end - begin) < length)
+    return false;
+  for (std::size_t i = 0; i != length; ++i)
+  {
+    if ((begin[i] | 0x20) != word[i])
+      return false;
+  }
+  return true;
+}
+
+/// Parse infinity or NaN, without sign.
+const char *parseSpecial(const char *const begin, const char *const end, double &value)
+{
+  if (matchWord(begin, end, "infinity"))
+  {
+    value = std::numeric_limits<double>::infinity();
+    return begin + 8;
+  }
+  if (matchWord(begin, end, "inf"))
+  {
+    value = std::numeric_limits<double>::infinity();
+    return begin + 3;
+  }
+  if (matchWord(begin, end, "nan"))
+  {
+    value = std::numeric_limits<double>::quiet_NaN();
+    return begin + 3;
+  }
+  return nullptr;
+}
+
+/// Parse decimal digits, up to a limit.
+const char *parseMagnitude(const char *const begin, const char *const end, const unsigned limit, unsigned &value)
+{
+  unsigned result = 0;
+  const char *p = begin;
+  for (; (p != end) && isDigit(*p); ++p)
+  {
+    const unsigned digit = unsigned(*p - '0');
+    if (result > (limit - digit) / 10)
+      return begin;
+    result = result * 10 + digit;
+  }
+  if (p != begin)
+    value = result;
+  return p;
+}
+
+bool parseWhole(const char *const value, double &result)
+{
+  const char *const end = value + std::strlen(value);
+  return (value != end) && (parseDouble(value, end, result) == end);
+}
+
+bool parseWhole(const char *const value, int &result)
+{
+  const char *const end = value + std::strlen(value);
+  return (value != end) && (parseInt(value, end, result) == end);
+}
+
+bool parseWhole(const char *const value, unsigned &result)
+{
+  const char *const end = value + std::strlen(value);
+  return (value != end) && (parseUnsigned(value, end, result) == end);
+}
+
+}
+
 std::unique_ptr<xmlTextReader, void (*)(xmlTextReaderPtr)> xmlReaderForStream(const RVNGInputStreamPtr_t &input)
 {
   return std::unique_ptr<xmlTextReader, void (*)(xmlTextReaderPtr)>(
@@ -85,34 +181,194 @@ boost::optional<bool> try_bool_cast(const char *value)
   return none;
 }
 
-double double_cast(const char *value)
+const char *parseDouble(const char *const begin, const char *const end, double &value)
+{
+  const char *p = begin;
+  bool negative = false;
+  if ((p != end) && ((*p == '+') || (*p == '-')))
+  {
+    negative = *p == '-';
+    ++p;
+  }
+
+  if (const char *const afterSpecial = parseSpecial(p, end, value))
+  {
+    if (negative)
+      value = -value;
+    return afterSpecial;
+  }
+
+  // collect up to 19 significant digits, which always fit into 64 bits
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool anyDigit = false;
+  for (; (p != end) && isDigit(*p); ++p)
+  {
+    anyDigit = true;
+    const unsigned digit = unsigned(*p - '0');
+    if (digits < MAX_MANTISSA_DIGITS)
+    {
+      mantissa = mantissa * 10 + digit;
+      if (mantissa != 0)
+        ++digits;
+    }
+    else
+    {
+      ++exponent;
+      truncated |= digit != 0;
+    }
+  }
+  if ((p != end) && (*p == '.'))
+  {
+    const char *q = p + 1;
+    for (; (q != end) && isDigit(*q); ++q)
+    {
+      anyDigit = true;
+      const unsigned digit = unsigned(*q - '0');
+      if (digits < MAX_MANTISSA_DIGITS)
+      {
+        mantissa = mantissa * 10 + digit;
+        if (mantissa != 0)
+          ++digits;
+        --exponent;
+      }
+      else
+      {
+        truncated |= digit != 0;
+      }
+    }
+    if (anyDigit)
+      p = q;
+  }
+  if (!anyDigit)
+    return begin;
+
+  if ((p != end) && ((*p == 'e') || (*p == 'E')))
+  {
+    const char *q = p + 1;
+    bool negativeExponent = false;
+    if ((q != end) && ((*q == '+') || (*q == '-')))
+    {
+      negativeExponent = *q == '-';
+      ++q;
+    }
+    if ((q != end) && isDigit(*q))
+    {
+      int explicitExponent = 0;
+      for (; (q != end) && isDigit(*q); ++q)
+      {
+        if (explicitExponent < MAX_EXPONENT)
+          explicitExponent = explicitExponent * 10 + (*q - '0');
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+      p = q;
+    }
+  }
+
+  if (mantissa == 0)
+  {
+    value = negative ? -0.0 : 0.0;
+    return p;
+  }
+
+  // Both the mantissa and the power of 10 are exact, so a single
+  // operation gives a correctly rounded result.
+  if (!truncated && (mantissa <= MAX_EXACT_MANTISSA) && (exponent >= -MAX_EXACT_POWER) && (exponent <= MAX_EXACT_POWER))
+  {
+    const double result = exponent < 0 ? double(mantissa) / POWERS_OF_10[-exponent] : double(mantissa) * POWERS_OF_10[exponent];
+    value = negative ? -result : result;
+    return p;
+  }
+
+  // the rare rest, with too many digits or a big exponent
+  std::istringstream stream(string(begin, p));
+  stream.imbue(std::locale::classic());
+  double result = 0;
+  stream >> result;
+  if (!stream || (stream.peek() != std::char_traits<char>::eof()))
+    return begin;
+  value = result;
+  return p;
+}
+
+const char *parseInt(const char *const begin, const char *const end, int &value)
 {
-  return lexical_cast<double, const char *>(value);
+  const char *p = begin;
+  bool negative = false;
+  if ((p != end) && ((*p == '+') || (*p == '-')))
+  {
+    negative = *p == '-';
+    ++p;
+  }
+  // the magnitude of INT_MIN is one more than INT_MAX
+  const unsigned limit = negative ? unsigned(std::numeric_limits<int>::max()) + 1 : unsigned(std::numeric_limits<int>::max());
+  unsigned magnitude = 0;
+  const char *const afterNumber = parseMagnitude(p, end, limit, magnitude);
+  if (afterNumber == p)
+    return begin;
+  value = negative ? int(-static_cast<long long>(magnitude)) : int(magnitude);
+  return afterNumber;
 }
 
-boost::optional<double> try_double_cast(const char *value) try
+const char *parseUnsigned(const char *const begin, const char *const end, unsigned &value)
 {
-  return double_cast(value);
+  const char *p = begin;
+  if ((p != end) && (*p == '+'))
+    ++p;
+  unsigned magnitude = 0;
+  const char *const afterNumber = parseMagnitude(p, end, std::numeric_limits<unsigned>::max(), magnitude);
+  if (afterNumber == p)
+    return begin;
+  value = magnitude;
+  return afterNumber;
 }
-catch (const bad_lexical_cast &)
+
+double double_cast(const char *value)
 {
-  ETONYEK_DEBUG_MSG(("'%s' is not a valid double\n", value));
-  return none;
+  double result = 0;
+  if (!parseWhole(value, result))
+    throw bad_lexical_cast();
+  return result;
+}
+
+boost::optional<double> try_double_cast(const char *value)
+{
+  double result = 0;
+  if (!parseWhole(value, result))
+  {
+    ETONYEK_DEBUG_MSG(("'%s' is not a valid double\n", value));
+    return none;
+  }
+  return result;
 }
 
 int int_cast(const char *value)
 {
-  return lexical_cast<int, const char *>(value);
+  int result = 0;
+  if (!parseWhole(value, result))
+    throw bad_lexical_cast();
+  return result;
 }
 
-boost::optional<int> try_int_cast(const char *value) try
+boost::optional<int> try_int_cast(const char *value)
 {
-  return int_cast(value);
+  int result = 0;
+  if (!parseWhole(value, result))
+  {
+    ETONYEK_DEBUG_MSG(("'%s' is not a valid integer\n", value));
+    return none;
+  }
+  return result;
 }
-catch (const bad_lexical_cast &)
+
+unsigned unsigned_cast(const char *value)
 {
-  ETONYEK_DEBUG_MSG(("'%s' is not a valid integer\n", value));
-  return none;
+  unsigned result = 0;
+  if (!parseWhole(value, result))
+    throw bad_lexical_cast();
+  return result;
 }
 
 const char *char_cast(const char *const c)
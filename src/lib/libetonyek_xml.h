@@ -32,12 +32,37 @@ std::unique_ptr<xmlTextReader, void (*)(xmlTextReaderPtr)> xmlReaderForStream(co
 bool bool_cast(const char *value);
 boost::optional<bool> try_bool_cast(const char *value);
 
+/** Parse a number at the start of a string.
+  *
+  * This works like std::from_chars: it does not skip whitespace, does
+  * not depend on the locale and does not throw. A leading '+' is
+  * accepted, as boost::lexical_cast does. Infinity and NaN are
+  * accepted too.
+  *
+  * @arg[in] begin the start of the string
+  * @arg[in] end the end of the string
+  * @arg[out] value the parsed number; it is only set on success
+  * @returns the position after the number, or begin if there is no
+  *   number or it is out of range
+  */
+const char *parseDouble(const char *begin, const char *end, double &value);
+const char *parseInt(const char *begin, const char *end, int &value);
+const char *parseUnsigned(const char *begin, const char *end, unsigned &value);
+
+/** Convert string value to a number.
+  *
+  * The whole string must be the number. The plain casts throw
+  * boost::bad_lexical_cast if it is not, the try_ variants return
+  * none.
+  */
 double double_cast(const char *value);
 boost::optional<double> try_double_cast(const char *value);
 
 int int_cast(const char *value);
 boost::optional<int> try_int_cast(const char *value);
 
+unsigned unsigned_cast(const char *value);
+
 const char *char_cast(const char *c);
 const char *char_cast(const signed char *c);
 const char *char_cast(const unsigned char *c);
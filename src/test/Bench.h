@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCH_H_INCLUDED
+#define BENCH_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+/** Registers a benchmark with the bench program.
+  *
+  * Create a static instance of this class for each benchmark.
+  */
+class BenchmarkRegistration
+{
+public:
+  BenchmarkRegistration(const char *name, void (*function)());
+};
+
+/** Measure the run time of a function and print it.
+  *
+  * The function is called repeatedly, in several rounds of at least
+  * 0.1 s each, and the best round is reported.
+  *
+  * @arg[in] label the label of the result
+  * @arg[in] function the measured function
+  * @arg[in] bytes the number of bytes processed by one call, for
+  *   throughput in MB/s, or 0
+  * @arg[in] items the number of items (values, names, ...) processed
+  *   by one call, for throughput in items/s, or 0
+  */
+void measure(const std::string &label, const std::function<void()> &function, std::size_t bytes = 0, std::size_t items = 0);
+
+/** Keep the compiler from optimizing away the computation of @c value.
+  */
+void keep(uint64_t value);
+
+/** Get the path of a file in the test data directory.
+  *
+  * @arg[in] name the name of the file, relative to the directory
+  */
+std::string getDataPath(const std::string &name);
+
+/** Read a file from the test data directory.
+  *
+  * @arg[in] name the name of the file, relative to the directory
+  */
+std::vector<unsigned char> readDataFile(const std::string &name);
+
+/** Read a gzipped file from the test data directory and uncompress it.
+  *
+  * @arg[in] name the name of the file, relative to the directory
+  */
+std::string readCompressedDataFile(const std::string &name);
+
+}
+
+#endif // BENCH_H_INCLUDED
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
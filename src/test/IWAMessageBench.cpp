@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "IWAMessage.h"
+#include "IWORKMemoryStream.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWAMessage;
+using libetonyek::IWORKMemoryStream;
+using libetonyek::RVNGInputStreamPtr_t;
+
+const std::size_t MESSAGES = 20000;
+
+/// A message of the kind seen in IWAMessageTest: five fields, one of them nested and one repeated.
+const unsigned char MESSAGE[] =
+  "\x8\x96\x1" // 1: uint32 = 150
+  "\x12\x6\x8\x4\x12\x2\x10\xa" // 2: {1: uint32 = 4, 2: {2: uint32 = 10}}
+  "\x1a\x5hello" // 3: string = "hello"
+  "\x20\x1\x20\x2\x20\x3" // 4: uint32 = 1, 2, 3
+  "\x29\x0\x0\x0\x0\x0\x0\xf8\x3f" // 5: double = 1.5
+  ;
+const std::size_t MESSAGE_LENGTH = sizeof(MESSAGE) - 1;
+
+uint64_t readAll(const IWAMessage &msg)
+{
+  uint64_t sum = msg.uint32(1).get();
+  const IWAMessage &nested = msg.message(2).get();
+  sum += nested.uint32(1).get();
+  sum += nested.message(2).get().uint32(2).get();
+  sum += msg.string(3).get().size();
+  for (std::size_t i = 0; i < msg.uint32(4).size(); ++i)
+    sum += msg.uint32(4)[i];
+  sum += uint64_t(msg.double_(5).get());
+  return sum;
+}
+
+void benchMessage()
+{
+  std::vector<unsigned char> data;
+  for (std::size_t i = 0; i < MESSAGES; ++i)
+    data.insert(data.end(), MESSAGE, MESSAGE + MESSAGE_LENGTH);
+  const RVNGInputStreamPtr_t input(new IWORKMemoryStream(data));
+
+  measure("construct", [&input]()
+  {
+    uint64_t sum = 0;
+    for (std::size_t i = 0; i < MESSAGES; ++i)
+    {
+      const long start = long(i * MESSAGE_LENGTH);
+      const IWAMessage msg(input, start, start + long(MESSAGE_LENGTH));
+      sum += bool(msg.uint32(1));
+    }
+    keep(sum);
+  }, data.size(), MESSAGES);
+
+  measure("construct and read all fields", [&input]()
+  {
+    uint64_t sum = 0;
+    for (std::size_t i = 0; i < MESSAGES; ++i)
+    {
+      const long start = long(i * MESSAGE_LENGTH);
+      const IWAMessage msg(input, start, start + long(MESSAGE_LENGTH));
+      sum += readAll(msg);
+    }
+    keep(sum);
+  }, data.size(), MESSAGES);
+}
+
+const BenchmarkRegistration messageRegistration("message", &benchMessage);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
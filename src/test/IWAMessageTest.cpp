@@ -51,6 +51,9 @@ private:
   CPPUNIT_TEST(testNestedMessageWithTrailingData);
   CPPUNIT_TEST(testEmptyMessage);
   CPPUNIT_TEST(testEmptyString);
+  CPPUNIT_TEST(testUnorderedFields);
+  CPPUNIT_TEST(testWireTypeMismatch);
+  CPPUNIT_TEST(testMemoryUsage);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -64,6 +67,9 @@ private:
   void testNestedMessageWithTrailingData();
   void testEmptyMessage();
   void testEmptyString();
+  void testUnorderedFields();
+  void testWireTypeMismatch();
+  void testMemoryUsage();
 };
 
 void IWAMessageTest::setUp()
@@ -213,6 +219,53 @@ void IWAMessageTest::testEmptyString()
   CPPUNIT_ASSERT_EQUAL(string(), get(msg.string(2)));
 }
 
+void IWAMessageTest::testUnorderedFields()
+{
+  IWAMessage msg(makeStream(BYTES("\x10\x1\x8\x4\x10\x2\x1a\x1x\x10\x3")), 12); // {2: 1, 1: 4, 2: 2, 3: "x", 2: 3}
+  CPPUNIT_ASSERT(msg.uint32(1));
+  CPPUNIT_ASSERT_EQUAL(uint32_t(4), msg.uint32(1).get());
+  CPPUNIT_ASSERT(msg.uint32(2));
+  CPPUNIT_ASSERT_EQUAL(size_t(3), msg.uint32(2).size());
+  CPPUNIT_ASSERT_EQUAL(uint32_t(1), msg.uint32(2)[0]);
+  CPPUNIT_ASSERT_EQUAL(uint32_t(2), msg.uint32(2)[1]);
+  CPPUNIT_ASSERT_EQUAL(uint32_t(3), msg.uint32(2)[2]);
+  CPPUNIT_ASSERT(msg.string(3));
+  CPPUNIT_ASSERT_EQUAL(string("x"), msg.string(3).get());
+  CPPUNIT_ASSERT(!msg.uint32(4));
+}
+
+void IWAMessageTest::testWireTypeMismatch()
+{
+  IWAMessage msg(makeStream(BYTES("\x8\x4\xd\x1\x0\x0\x0\x8\x5")), 9); // {1: 4, 1: fixed32 1, 1: 5}
+  CPPUNIT_ASSERT(msg.uint32(1));
+  CPPUNIT_ASSERT_EQUAL(size_t(2), msg.uint32(1).size());
+  CPPUNIT_ASSERT_EQUAL(uint32_t(4), msg.uint32(1)[0]);
+  CPPUNIT_ASSERT_EQUAL(uint32_t(5), msg.uint32(1)[1]);
+}
+
+void IWAMessageTest::testMemoryUsage()
+{
+  IWAMessage msg(makeStream(BYTES("\xa\x6\x8\x4\x12\x2\x10\xa\x10\x1")), 10); // {1: {1: uint32, 2: {2: uint32}}, 2: uint32}
+  const size_t undecoded = msg.memoryUsage();
+
+  // decoded fields are kept in the message
+  CPPUNIT_ASSERT(msg.uint32(2));
+  const size_t decoded = msg.memoryUsage();
+  CPPUNIT_ASSERT(decoded > undecoded);
+
+  // and so are nested messages
+  CPPUNIT_ASSERT(msg.message(1));
+  const size_t nested = msg.memoryUsage();
+  CPPUNIT_ASSERT(nested >= decoded + sizeof(IWAMessage));
+  CPPUNIT_ASSERT(msg.message(1).get().message(2));
+  CPPUNIT_ASSERT(msg.memoryUsage() > nested);
+
+  // accessing a decoded field again does not change anything
+  CPPUNIT_ASSERT(msg.uint32(2));
+  CPPUNIT_ASSERT(msg.message(1).get().message(2));
+  CPPUNIT_ASSERT_EQUAL(msg.memoryUsage(), msg.memoryUsage());
+}
+
 #undef BYTES
 
 CPPUNIT_TEST_SUITE_REGISTRATION(IWAMessageTest);
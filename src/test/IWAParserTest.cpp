@@ -0,0 +1,225 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "IWAParser.h"
+#include "KEYCollector.h"
+
+#if !defined ETONYEK_STREAMS_TEST_DIR
+#error ETONYEK_STREAMS_TEST_DIR not defined, cannot test
+#endif
+
+namespace test
+{
+
+using libetonyek::IWAParser;
+using libetonyek::KEYCollector;
+using libetonyek::RVNGInputStreamPtr_t;
+
+using std::deque;
+using std::string;
+
+namespace
+{
+
+const unsigned MAX_ID = 10000;
+
+/// Finds the ids of existing objects.
+class ObjectFinder : public IWAParser
+{
+public:
+  ObjectFinder(const RVNGInputStreamPtr_t &fragments, KEYCollector &collector, std::size_t count);
+
+  const deque<unsigned> &getObjects() const;
+
+private:
+  bool parseDocument() override;
+
+private:
+  const std::size_t m_count;
+  deque<unsigned> m_objects;
+};
+
+ObjectFinder::ObjectFinder(const RVNGInputStreamPtr_t &fragments, KEYCollector &collector, const std::size_t count)
+  : IWAParser(fragments, fragments, collector)
+  , m_count(count)
+  , m_objects()
+{
+}
+
+const deque<unsigned> &ObjectFinder::getObjects() const
+{
+  return m_objects;
+}
+
+bool ObjectFinder::parseDocument()
+{
+  for (unsigned id = 1; (id <= MAX_ID) && (m_objects.size() < m_count); ++id)
+  {
+    if (ObjectMessage(*this, id))
+      m_objects.push_back(id);
+  }
+  return true;
+}
+
+/** Opens objects nested in each other and records which of them can
+  * be opened.
+  */
+class NestingParser : public IWAParser
+{
+public:
+  NestingParser(const RVNGInputStreamPtr_t &fragments, KEYCollector &collector, const deque<unsigned> &ids);
+
+  const deque<bool> &getOpened() const;
+
+private:
+  bool parseDocument() override;
+  void open(deque<unsigned>::const_iterator it);
+
+private:
+  const deque<unsigned> m_ids;
+  deque<bool> m_opened;
+};
+
+NestingParser::NestingParser(const RVNGInputStreamPtr_t &fragments, KEYCollector &collector, const deque<unsigned> &ids)
+  : IWAParser(fragments, fragments, collector)
+  , m_ids(ids)
+  , m_opened()
+{
+}
+
+const deque<bool> &NestingParser::getOpened() const
+{
+  return m_opened;
+}
+
+bool NestingParser::parseDocument()
+{
+  open(m_ids.begin());
+  return true;
+}
+
+void NestingParser::open(const deque<unsigned>::const_iterator it)
+{
+  if (it == m_ids.end())
+    return;
+  const ObjectMessage msg(*this, *it);
+  m_opened.push_back(bool(msg));
+  open(it + 1);
+}
+
+RVNGInputStreamPtr_t openDocument()
+{
+  const string path(string(ETONYEK_STREAMS_TEST_DIR) + "/keynote6-file.key");
+  return RVNGInputStreamPtr_t(new librevenge::RVNGFileStream(path.c_str()));
+}
+
+/** Open objects nested in each other.
+  *
+  * @arg[in] ids the ids of the objects, from the outermost one
+  * @arg[in] maxDepth the limit of nesting, or 0 for the default
+  * @returns whether each object could be opened
+  */
+deque<bool> open(const deque<unsigned> &ids, const unsigned maxDepth = 0)
+{
+  KEYCollector collector(nullptr);
+  NestingParser parser(openDocument(), collector, ids);
+  if (maxDepth != 0)
+    parser.setMaxNestingDepth(maxDepth);
+  CPPUNIT_ASSERT(parser.parse());
+  return parser.getOpened();
+}
+
+/// Find the ids of the first @c count existing objects.
+deque<unsigned> findObjects(const std::size_t count)
+{
+  KEYCollector collector(nullptr);
+  ObjectFinder finder(openDocument(), collector, count);
+  CPPUNIT_ASSERT(finder.parse());
+  return finder.getObjects();
+}
+
+}
+
+class IWAParserTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp();
+  virtual void tearDown();
+
+private:
+  CPPUNIT_TEST_SUITE(IWAParserTest);
+  CPPUNIT_TEST(testRecursion);
+  CPPUNIT_TEST(testMaxNestingDepth);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testRecursion();
+  void testMaxNestingDepth();
+};
+
+void IWAParserTest::setUp()
+{
+}
+
+void IWAParserTest::tearDown()
+{
+}
+
+void IWAParserTest::testRecursion()
+{
+  const deque<unsigned> objects(findObjects(2));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(2), objects.size());
+
+  // an object being parsed cannot be entered again
+  deque<unsigned> ids;
+  ids.push_back(objects[0]);
+  ids.push_back(objects[1]);
+  ids.push_back(objects[0]);
+  ids.push_back(objects[1]);
+  const deque<bool> opened(open(ids));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(4), opened.size());
+  CPPUNIT_ASSERT(opened[0]);
+  CPPUNIT_ASSERT(opened[1]);
+  CPPUNIT_ASSERT(!opened[2]);
+  CPPUNIT_ASSERT(!opened[3]);
+}
+
+void IWAParserTest::testMaxNestingDepth()
+{
+  const deque<unsigned> ids(findObjects(4));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(4), ids.size());
+
+  // the default limit is far away
+  CPPUNIT_ASSERT(open(ids) == deque<bool>(4, true));
+
+  // objects nested deeper than the limit are refused
+  deque<bool> expected(3, true);
+  expected.push_back(false);
+  CPPUNIT_ASSERT(open(ids, 3) == expected);
+
+  expected[1] = expected[2] = false;
+  CPPUNIT_ASSERT(open(ids, 1) == expected);
+
+  CPPUNIT_ASSERT(open(ids, 4) == deque<bool>(4, true));
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IWAParserTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
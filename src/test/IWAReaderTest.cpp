@@ -74,6 +74,21 @@ void IWAReaderTest::testBytes()
   CPPUNIT_ASSERT(!input->isEnd());
   CPPUNIT_ASSERT_EQUAL(4ul, getLength(input));
   CPPUNIT_ASSERT_EQUAL(0x12345678u, readU32(input));
+
+  // the data are shared with the source stream
+  const RVNGInputStreamPtr_t source(makeStream(BYTES("\x1\x2\x3\x4\x5")));
+  source->seek(1, librevenge::RVNG_SEEK_SET);
+  const RVNGInputStreamPtr_t window(IWAReader::Bytes::read(source, 3));
+  CPPUNIT_ASSERT_EQUAL(4L, source->tell());
+  CPPUNIT_ASSERT_EQUAL(3ul, getLength(window));
+  unsigned long sourceRead = 0;
+  unsigned long windowRead = 0;
+  source->seek(1, librevenge::RVNG_SEEK_SET);
+  const unsigned char *const sourceData = source->read(3, sourceRead);
+  const unsigned char *const windowData = window->read(3, windowRead);
+  CPPUNIT_ASSERT_EQUAL(3ul, windowRead);
+  CPPUNIT_ASSERT(sourceData == windowData);
+  CPPUNIT_ASSERT(window->isEnd());
 }
 
 #undef BYTES
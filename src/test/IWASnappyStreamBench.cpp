@@ -0,0 +1,145 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "IWASnappyStream.h"
+#include "IWORKMemoryStream.h"
+#include "libetonyek_utils.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWASnappyStream;
+using libetonyek::IWORKMemoryStream;
+using libetonyek::RVNGInputStreamPtr_t;
+
+typedef std::vector<unsigned char> Data_t;
+
+/// Read all .iwa fragments of a document.
+void readFragments(const char *const name, std::vector<Data_t> &fragments)
+{
+  librevenge::RVNGFileStream file(getDataPath(name).c_str());
+  for (unsigned i = 0; i < file.subStreamCount(); ++i)
+  {
+    const char *const subName = file.subStreamName(i);
+    const std::size_t length = subName ? std::strlen(subName) : 0;
+    if ((length < 4) || (std::strcmp(subName + length - 4, ".iwa") != 0))
+      continue;
+    const std::unique_ptr<librevenge::RVNGInputStream> input(file.getSubStreamById(i));
+    if (!input)
+      continue;
+    Data_t data;
+    unsigned long read = 0;
+    while (const unsigned char *const bytes = input->read(65536, read))
+    {
+      if (read == 0)
+        break;
+      data.insert(data.end(), bytes, bytes + read);
+    }
+    fragments.push_back(data);
+  }
+}
+
+/// Split a fragment into its Snappy blocks.
+void splitBlocks(const Data_t &fragment, std::vector<Data_t> &blocks)
+{
+  std::size_t pos = 0;
+  while ((pos + 4 <= fragment.size()) && (fragment[pos] == 0))
+  {
+    const std::size_t length = fragment[pos + 1] | (std::size_t(fragment[pos + 2]) << 8) | (std::size_t(fragment[pos + 3]) << 16);
+    pos += 4;
+    if (pos + length > fragment.size())
+      break;
+    blocks.push_back(Data_t(fragment.begin() + long(pos), fragment.begin() + long(pos + length)));
+    pos += length;
+  }
+}
+
+std::size_t readAll(librevenge::RVNGInputStream &input)
+{
+  std::size_t size = 0;
+  unsigned long read = 0;
+  while (!input.isEnd() && input.read(65536, read) && (read != 0))
+    size += read;
+  return size;
+}
+
+void benchSnappy()
+{
+  std::vector<Data_t> fragments;
+  readFragments("keynote6-file.key", fragments);
+  readFragments("numbers3-file.numbers", fragments);
+  readFragments("pages5-file.pages", fragments);
+
+  std::vector<RVNGInputStreamPtr_t> blocks;
+  {
+    std::vector<Data_t> blockData;
+    for (const auto &fragment : fragments)
+      splitBlocks(fragment, blockData);
+    for (const auto &block : blockData)
+      blocks.push_back(std::make_shared<IWORKMemoryStream>(block));
+  }
+
+  std::size_t compressed = 0;
+  std::size_t uncompressed = 0;
+  for (const auto &fragment : fragments)
+  {
+    compressed += fragment.size();
+    IWASnappyStream stream(std::make_shared<IWORKMemoryStream>(fragment));
+    uncompressed += readAll(stream);
+  }
+  std::printf("  %u fragments, %u blocks, %u bytes compressed, %u bytes uncompressed\n",
+              unsigned(fragments.size()), unsigned(blocks.size()), unsigned(compressed), unsigned(uncompressed));
+
+  measure("uncompressBlock", [&blocks]()
+  {
+    std::size_t size = 0;
+    for (const auto &block : blocks)
+    {
+      block->seek(0, librevenge::RVNG_SEEK_SET);
+      size += libetonyek::getLength(IWASnappyStream::uncompressBlock(block));
+    }
+    keep(size);
+  }, uncompressed);
+
+  std::vector<RVNGInputStreamPtr_t> inputs;
+  for (const auto &fragment : fragments)
+    inputs.push_back(std::make_shared<IWORKMemoryStream>(fragment));
+  measure("IWASnappyStream, read all", [&inputs]()
+  {
+    std::size_t size = 0;
+    for (const auto &input : inputs)
+    {
+      input->seek(0, librevenge::RVNG_SEEK_SET);
+      IWASnappyStream stream(input);
+      size += readAll(stream);
+    }
+    keep(size);
+  }, uncompressed);
+}
+
+const BenchmarkRegistration snappyRegistration("snappy", &benchSnappy);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
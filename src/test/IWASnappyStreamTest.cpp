@@ -81,12 +81,16 @@ private:
   CPPUNIT_TEST(testBlock);
   CPPUNIT_TEST(testInvalid);
   CPPUNIT_TEST(testFull);
+  CPPUNIT_TEST(testRandomAccess);
+  CPPUNIT_TEST(testLazy);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   void testBlock();
   void testInvalid();
   void testFull();
+  void testRandomAccess();
+  void testLazy();
 };
 
 void IWASnappyStreamTest::setUp()
@@ -136,6 +140,58 @@ void IWASnappyStreamTest::testFull()
                        ));
 }
 
+void IWASnappyStreamTest::testRandomAccess()
+{
+  const unsigned char compressed[] =
+    "\x0\x3\x0\x0\x1\x0\x61" // block 1
+    "\x0\x4\x0\x0\x2\x4\x62\x63" // block 2
+    "\x0\x3\x0\x0\x1\x0\x64" // block 3
+    ;
+  const RVNGInputStreamPtr_t stream(new IWORKMemoryStream(compressed, sizeof(compressed) - 1));
+  IWASnappyStream uncompressedStream(stream);
+
+  CPPUNIT_ASSERT_EQUAL(0, uncompressedStream.seek(0, librevenge::RVNG_SEEK_END));
+  CPPUNIT_ASSERT_EQUAL(4L, uncompressedStream.tell());
+
+  unsigned long numBytesRead = 0;
+  CPPUNIT_ASSERT_EQUAL(0, uncompressedStream.seek(2, librevenge::RVNG_SEEK_SET));
+  const unsigned char *data = uncompressedStream.read(2, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(2ul, numBytesRead);
+  CPPUNIT_ASSERT(std::equal(data, data + 2, reinterpret_cast<const unsigned char *>("cd")));
+  CPPUNIT_ASSERT(uncompressedStream.isEnd());
+
+  CPPUNIT_ASSERT_EQUAL(0, uncompressedStream.seek(0, librevenge::RVNG_SEEK_SET));
+  data = uncompressedStream.read(4, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(4ul, numBytesRead);
+  CPPUNIT_ASSERT(std::equal(data, data + 4, reinterpret_cast<const unsigned char *>("abcd")));
+
+  const RVNGInputStreamPtr_t view(uncompressedStream.view(1, 2));
+  CPPUNIT_ASSERT(bool(view));
+  data = view->read(2, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(2ul, numBytesRead);
+  CPPUNIT_ASSERT(std::equal(data, data + 2, reinterpret_cast<const unsigned char *>("bc")));
+  CPPUNIT_ASSERT(!uncompressedStream.view(3, 2));
+}
+
+void IWASnappyStreamTest::testLazy()
+{
+  const unsigned char compressed[] =
+    "\x0\x3\x0\x0\x1\x0\x61" // block 1
+    "\x0\x3\x0\x0\x1\x3\x0" // broken block 2
+    ;
+  const RVNGInputStreamPtr_t stream(new IWORKMemoryStream(compressed, sizeof(compressed) - 1));
+  IWASnappyStream uncompressedStream(stream);
+
+  // the first block can be read, because the second is not touched
+  unsigned long numBytesRead = 0;
+  const unsigned char *const data = uncompressedStream.read(1, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(1ul, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>('a'), data[0]);
+
+  uncompressedStream.read(1, numBytesRead);
+  CPPUNIT_ASSERT_EQUAL(0ul, numBytesRead);
+}
+
 #undef BYTES
 
 CPPUNIT_TEST_SUITE_REGISTRATION(IWASnappyStreamTest);
@@ -0,0 +1,305 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "IWAText.h"
+#include "IWORKLanguageManager.h"
+#include "IWORKOutputElements.h"
+#include "IWORKPropertyMap.h"
+#include "IWORKStyle.h"
+#include "IWORKText.h"
+#include "TestDocumentInterface.h"
+
+using boost::none;
+
+using libetonyek::IWAText;
+using libetonyek::IWORKLanguageManager;
+using libetonyek::IWORKOutputElements;
+using libetonyek::IWORKPropertyMap;
+using libetonyek::IWORKStyle;
+using libetonyek::IWORKStylePtr_t;
+using libetonyek::IWORKText;
+
+using std::string;
+
+namespace test
+{
+
+namespace
+{
+
+typedef std::multimap<unsigned, std::function<void(unsigned, bool &)> > Attachments_t;
+typedef std::function<void(IWORKText &)> Filler_t;
+
+string draw(IWORKText &text)
+{
+  IWORKOutputElements elements;
+  text.draw(elements);
+  RecordingDocumentInterface iface;
+  elements.write(&iface);
+  return iface.getLog();
+}
+
+/** Parse @c input into a text and get its output.
+  *
+  * @arg[in] prepare called before the parsing, e.g., to add attachments
+  */
+string parse(const string &input, const std::function<void(IWAText &, IWORKText &)> &prepare = nullptr)
+{
+  IWORKLanguageManager langManager;
+  IWORKText text(langManager, false, true);
+  IWAText parser(input, langManager);
+  if (prepare)
+    prepare(parser, text);
+  parser.parse(text);
+  return draw(text);
+}
+
+/** Get the output of a text filled with the calls that the parser
+  * is expected to make.
+  */
+string expect(const Filler_t &fill)
+{
+  IWORKLanguageManager langManager;
+  IWORKText text(langManager, false, true);
+  fill(text);
+  // the end of IWAText::parse
+  text.flushParagraph();
+  text.setListLevel(0);
+  text.flushList();
+  text.flushLayout();
+  return draw(text);
+}
+
+string expectText(const string &content)
+{
+  return expect([&content](IWORKText &text)
+  {
+    text.insertText(content);
+  });
+}
+
+IWORKStylePtr_t makeStyle()
+{
+  return std::make_shared<IWORKStyle>(IWORKPropertyMap(), none, none);
+}
+
+}
+
+class IWATextTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp();
+  virtual void tearDown();
+
+private:
+  CPPUNIT_TEST_SUITE(IWATextTest);
+  CPPUNIT_TEST(testPlainText);
+  CPPUNIT_TEST(testSpaces);
+  CPPUNIT_TEST(testControlCharacters);
+  CPPUNIT_TEST(testUTF8);
+  CPPUNIT_TEST(testAttachments);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testPlainText();
+  void testSpaces();
+  void testControlCharacters();
+  void testUTF8();
+  void testAttachments();
+};
+
+void IWATextTest::setUp()
+{
+}
+
+void IWATextTest::tearDown()
+{
+}
+
+void IWATextTest::testPlainText()
+{
+  const string text("Hello world, this is a plain text.");
+  const string log = parse(text);
+  CPPUNIT_ASSERT(log.find("insertText [" + text + "]") != string::npos);
+  CPPUNIT_ASSERT_EQUAL(expectText(text), log);
+
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &) {}), parse(""));
+  CPPUNIT_ASSERT_EQUAL(expectText("a"), parse("a"));
+}
+
+void IWATextTest::testSpaces()
+{
+  // the two spaces are split between two 8-byte words
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("abcdefg ");
+    text.insertSpace();
+    text.insertText("hijklmnop");
+  }), parse("abcdefg  hijklmnop"));
+
+  // a word full of spaces
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("abcdefgh ");
+    for (int i = 0; i < 7; ++i)
+      text.insertSpace();
+    text.insertText("ijklmnop");
+  }), parse("abcdefgh        ijklmnop"));
+
+  // two spaces within a word
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("ab ");
+    text.insertSpace();
+    text.insertText("cdefghijklmnop");
+  }), parse("ab  cdefghijklmnop"));
+
+  // single spaces are just text
+  CPPUNIT_ASSERT_EQUAL(expectText("a b c d e f g h i j k"), parse("a b c d e f g h i j k"));
+
+  // leading spaces
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText(" ");
+    text.insertSpace();
+    text.insertText("abcdefghij");
+  }), parse("  abcdefghij"));
+}
+
+void IWATextTest::testControlCharacters()
+{
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("one");
+    text.insertTab();
+    text.insertText("two");
+    text.insertLineBreak();
+    text.insertText("three");
+    text.flushParagraph();
+    text.insertText("four");
+  }), parse("one\ttwo\rthree\nfour"));
+
+  // within 8-byte words
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("abcdefghij");
+    text.insertTab();
+    text.insertText("klmnopqrstuvwxyz");
+    text.flushParagraph();
+  }), parse("abcdefghij\tklmnopqrstuvwxyz\n"));
+
+  // a page break
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("page");
+    text.flushParagraph();
+    text.insertPageBreak();
+    text.insertText("next page");
+  }), parse("page\x05next page"));
+
+  // unknown characters and column breaks outside of sections are dropped
+  CPPUNIT_ASSERT_EQUAL(expectText("onetwothree and more"), parse("one\x01two\x0cthree and more"));
+  CPPUNIT_ASSERT_EQUAL(expectText("abcdefghijklmnop"), parse("abcdefgh\x02ijklmnop"));
+}
+
+void IWATextTest::testUTF8()
+{
+  CPPUNIT_ASSERT_EQUAL(expectText("gr\xc3\xbc\xc3\x9f Gott, \xe2\x82\xac 5"), parse("gr\xc3\xbc\xc3\x9f Gott, \xe2\x82\xac 5"));
+
+  // positions are in characters, not bytes
+  const IWORKStylePtr_t first = makeStyle();
+  const IWORKStylePtr_t second = makeStyle();
+  CPPUNIT_ASSERT_EQUAL(expect([&](IWORKText &text)
+  {
+    text.setSpanStyle(first);
+    text.insertText("h\xc3\xa9llo ");
+    text.flushSpan();
+    text.setSpanStyle(second);
+    text.insertText("w\xc3\xb6rld, and the rest");
+  }), parse("h\xc3\xa9llo w\xc3\xb6rld, and the rest", [&](IWAText &parser, IWORKText &)
+  {
+    std::map<unsigned, IWORKStylePtr_t> spans;
+    spans[0] = first;
+    spans[6] = second;
+    parser.setSpans(spans);
+  }));
+
+  // truncated characters at the end of the text
+  CPPUNIT_ASSERT_EQUAL(expectText("abc\xc3"), parse("abc\xc3"));
+  CPPUNIT_ASSERT_EQUAL(expectText("abcdefghijk\xe2\x82"), parse("abcdefghijk\xe2\x82"));
+  CPPUNIT_ASSERT_EQUAL(expectText("abcdefgh\xf0\x9f\x98"), parse("abcdefgh\xf0\x9f\x98"));
+}
+
+void IWATextTest::testAttachments()
+{
+  // an attachment replacing its character
+  std::vector<unsigned> positions;
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("abc");
+    text.insertTab();
+    text.insertText("def ghijklmnop");
+  }), parse("abc\xef\xbf\xbc" "def ghijklmnop", [&positions](IWAText &parser, IWORKText &text)
+  {
+    Attachments_t attachments;
+    attachments.insert(std::make_pair(3u, [&positions, &text](unsigned pos, bool &ignore)
+    {
+      positions.push_back(pos);
+      text.insertTab();
+      ignore = true;
+    }));
+    parser.setAttachments(attachments);
+  }));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(1), positions.size());
+  CPPUNIT_ASSERT_EQUAL(3u, positions[0]);
+
+  // an attachment keeping its character, after multi-byte characters
+  positions.clear();
+  CPPUNIT_ASSERT_EQUAL(expect([](IWORKText &text)
+  {
+    text.insertText("\xc3\xa9t\xc3\xa9 ");
+    text.insertText("x-y");
+  }), parse("\xc3\xa9t\xc3\xa9 x-y", [&positions](IWAText &parser, IWORKText &)
+  {
+    Attachments_t attachments;
+    attachments.insert(std::make_pair(4u, [&positions](unsigned pos, bool &)
+    {
+      positions.push_back(pos);
+    }));
+    parser.setAttachments(attachments);
+  }));
+  CPPUNIT_ASSERT_EQUAL(std::size_t(1), positions.size());
+  CPPUNIT_ASSERT_EQUAL(4u, positions[0]);
+
+  // an ignored character at the end of the text
+  CPPUNIT_ASSERT_EQUAL(expectText("abcdefghij"), parse("abcdefghij\xef\xbf\xbc", [](IWAText &parser, IWORKText &)
+  {
+    Attachments_t attachments;
+    attachments.insert(std::make_pair(10u, [](unsigned, bool &ignore)
+    {
+      ignore = true;
+    }));
+    parser.setAttachments(attachments);
+  }));
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IWATextTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
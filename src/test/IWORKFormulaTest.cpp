@@ -36,6 +36,8 @@ private:
   CPPUNIT_TEST(testFunctions);
   CPPUNIT_TEST(testExpressions);
   CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST(testRepeated);
+  CPPUNIT_TEST(testShifted);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -46,6 +48,8 @@ private:
   void testFunctions();
   void testExpressions();
   void testInvalid();
+  void testRepeated();
+  void testShifted();
 };
 
 void IWORKFormulaTest::setUp()
@@ -249,6 +253,97 @@ void IWORKFormulaTest::testInvalid()
   CPPUNIT_ASSERT(!formula.parse("=SUM(9:B)"));
 }
 
+void IWORKFormulaTest::testRepeated()
+{
+  // the same formula parsed in different cells
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(1);
+    CPPUNIT_ASSERT(formula1.parse("=A1+$B$1"));
+    CPPUNIT_ASSERT(formula2.parse("=A1+$B$1"));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A1]+[.$B$1]"), formula1.str(0u));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A1]+[.$B$1]"), formula2.str(1u));
+    CPPUNIT_ASSERT_EQUAL(string("=[.B1]+[.$B$1]"), formula1.str(1u));
+  }
+
+  // reparsing replaces the previous formula
+  {
+    IWORKFormula formula(none);
+    CPPUNIT_ASSERT(formula.parse("=4"));
+    CPPUNIT_ASSERT(formula.parse("=5"));
+    CPPUNIT_ASSERT_EQUAL(string("=5"), formula.str(none));
+    CPPUNIT_ASSERT(formula.parse("=4"));
+    CPPUNIT_ASSERT_EQUAL(string("=4"), formula.str(none));
+  }
+
+  // invalid formula stays invalid and does not change the parsed one
+  {
+    IWORKFormula formula(none);
+    CPPUNIT_ASSERT(formula.parse("=4"));
+    CPPUNIT_ASSERT(!formula.parse("=SHEET1;B5"));
+    CPPUNIT_ASSERT(!formula.parse("=SHEET1;B5"));
+    CPPUNIT_ASSERT_EQUAL(string("=4"), formula.str(none));
+  }
+}
+
+void IWORKFormulaTest::testShifted()
+{
+  // a filled down column
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(256);
+    IWORKFormula formula3(512);
+    CPPUNIT_ASSERT(formula1.parse("=A1*$B$1"));
+    CPPUNIT_ASSERT(formula2.parse("=A2*$B$1"));
+    CPPUNIT_ASSERT(formula3.parse("=A3*$B$1"));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A1]*[.$B$1]"), formula1.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A2]*[.$B$1]"), formula2.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A3]*[.$B$1]"), formula3.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=[.A2]*[.$B$1]"), formula2.str(256u));
+    CPPUNIT_ASSERT_EQUAL(string("=[.B4]*[.$B$1]"), formula2.str(769u));
+  }
+
+  // the same text in different cells is a different relative formula
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(256);
+    CPPUNIT_ASSERT(formula1.parse("=C1+1"));
+    CPPUNIT_ASSERT(formula2.parse("=C1+1"));
+    CPPUNIT_ASSERT_EQUAL(string("=[.C1]+1"), formula1.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=[.C1]+1"), formula2.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=[.C2]+1"), formula1.str(256u));
+  }
+
+  // function names and strings are not references
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(256);
+    CPPUNIT_ASSERT(formula1.parse("=LOG10(A1)+LEN(\"A1\")"));
+    CPPUNIT_ASSERT(formula2.parse("=LOG10(A2)+LEN(\"A1\")"));
+    CPPUNIT_ASSERT_EQUAL(formula1.str(256u), formula2.str(none));
+  }
+
+  // column and row ranges are not normalized, so the same text in
+  // another cell must not get the parse of the first one
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(1);
+    CPPUNIT_ASSERT(formula1.parse("=SUM(B:C)"));
+    CPPUNIT_ASSERT(formula2.parse("=SUM(B:C)"));
+    CPPUNIT_ASSERT_EQUAL(string("=SUM([.B:.C])"), formula1.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=SUM([.B:.C])"), formula2.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=SUM([.C:.D])"), formula1.str(1u));
+  }
+  {
+    IWORKFormula formula1(0);
+    IWORKFormula formula2(256);
+    CPPUNIT_ASSERT(formula1.parse("=SUM(7:9)"));
+    CPPUNIT_ASSERT(formula2.parse("=SUM(7:9)"));
+    CPPUNIT_ASSERT_EQUAL(string("=SUM([.7:.9])"), formula2.str(none));
+    CPPUNIT_ASSERT_EQUAL(string("=SUM([.8:.10])"), formula1.str(256u));
+  }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(IWORKFormulaTest);
 
 }
@@ -0,0 +1,342 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "IWORKFormula.h"
+#include "IWORKOutputElements.h"
+#include "TestDocumentInterface.h"
+
+using boost::none;
+
+using libetonyek::IWORKFormula;
+using libetonyek::IWORKOutputElements;
+using libetonyek::IWORKTableNameMap_t;
+using libetonyek::IWORKTableNameMapPtr_t;
+
+using std::string;
+
+namespace test
+{
+
+namespace
+{
+
+librevenge::RVNGPropertyList makeProps(const char *const key, const char *const value)
+{
+  librevenge::RVNGPropertyList props;
+  props.insert(key, value);
+  return props;
+}
+
+string record(const IWORKOutputElements &elements)
+{
+  RecordingDocumentInterface iface;
+  elements.write(&iface);
+  return iface.getLog();
+}
+
+/// Create a paragraph with one span of text.
+void addParagraph(IWORKOutputElements &elements, const char *const text)
+{
+  elements.addOpenParagraph(makeProps("fo:text-align", "center"));
+  elements.addOpenSpan(makeProps("style:font-name", "Arial"));
+  elements.addInsertText(text);
+  elements.addCloseSpan();
+  elements.addCloseParagraph();
+}
+
+string paragraphLog(const char *const text)
+{
+  return string("openParagraph {fo:text-align=center;}\nopenSpan {style:font-name=Arial;}\ninsertText [") + text + "]\ncloseSpan\ncloseParagraph\n";
+}
+
+}
+
+class IWORKOutputElementsTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp();
+  virtual void tearDown();
+
+private:
+  CPPUNIT_TEST_SUITE(IWORKOutputElementsTest);
+  CPPUNIT_TEST(testWrite);
+  CPPUNIT_TEST(testAppend);
+  CPPUNIT_TEST(testSelfAppend);
+  CPPUNIT_TEST(testCopy);
+  CPPUNIT_TEST(testFreedPayloads);
+  CPPUNIT_TEST(testShapesInSpreadsheet);
+  CPPUNIT_TEST(testFormulaCell);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testWrite();
+  void testAppend();
+  void testSelfAppend();
+  void testCopy();
+  void testFreedPayloads();
+  void testShapesInSpreadsheet();
+  void testFormulaCell();
+
+private:
+  IWORKOutputElements::StoragePtr_t m_previousStorage;
+};
+
+void IWORKOutputElementsTest::setUp()
+{
+  m_previousStorage = IWORKOutputElements::setDefaultStorage(IWORKOutputElements::createStorage());
+}
+
+void IWORKOutputElementsTest::tearDown()
+{
+  IWORKOutputElements::setDefaultStorage(m_previousStorage);
+  m_previousStorage.reset();
+}
+
+void IWORKOutputElementsTest::testWrite()
+{
+  IWORKOutputElements elements;
+  CPPUNIT_ASSERT(elements.empty());
+  CPPUNIT_ASSERT_EQUAL(string(), record(elements));
+
+  addParagraph(elements, "hello");
+  elements.addInsertSpace();
+  elements.addInsertTab();
+  elements.addInsertLineBreak();
+  CPPUNIT_ASSERT(!elements.empty());
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("hello") + "insertSpace\ninsertTab\ninsertLineBreak\n", record(elements));
+
+  // payloads that are not shared
+  librevenge::RVNGPropertyList path;
+  librevenge::RVNGPropertyListVector d;
+  d.append(makeProps("librevenge:path-action", "M"));
+  d.append(makeProps("librevenge:path-action", "Z"));
+  path.insert("svg:d", d);
+  elements.clear();
+  elements.addOpenFrame(makeProps("svg:x", "1in"));
+  elements.addDrawPath(path);
+  elements.addDrawPath(path);
+  elements.addDrawGraphicObject(makeProps("librevenge:mime-type", "image/png"));
+  elements.addCloseFrame();
+  CPPUNIT_ASSERT_EQUAL(
+    string("openFrame {svg:x=1in;}\n")
+    + "drawPath {svg:d=[{librevenge:path-action=M;}{librevenge:path-action=Z;}];}\n"
+    + "drawPath {svg:d=[{librevenge:path-action=M;}{librevenge:path-action=Z;}];}\n"
+    + "drawGraphicObject {librevenge:mime-type=image/png;}\n"
+    + "closeFrame\n",
+    record(elements));
+
+  elements.clear();
+  CPPUNIT_ASSERT(elements.empty());
+  CPPUNIT_ASSERT_EQUAL(string(), record(elements));
+}
+
+void IWORKOutputElementsTest::testAppend()
+{
+  // within one storage
+  IWORKOutputElements elements;
+  addParagraph(elements, "one");
+  {
+    IWORKOutputElements other;
+    addParagraph(other, "two");
+    elements.append(other);
+    other.clear();
+    CPPUNIT_ASSERT_EQUAL(paragraphLog("one") + paragraphLog("two"), record(elements));
+  }
+
+  // appending nothing
+  elements.append(IWORKOutputElements());
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("one") + paragraphLog("two"), record(elements));
+
+  // across storages; the other storage goes away with the other elements
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::createStorage());
+  {
+    IWORKOutputElements other;
+    addParagraph(other, "three");
+    other.addOpenSpan(makeProps("style:font-name", "Courier"));
+    other.addCloseSpan();
+    elements.append(other);
+  }
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::StoragePtr_t());
+  const string expected = paragraphLog("one") + paragraphLog("two") + paragraphLog("three") + "openSpan {style:font-name=Courier;}\ncloseSpan\n";
+  CPPUNIT_ASSERT_EQUAL(expected, record(elements));
+
+  // into elements without a storage
+  IWORKOutputElements empty;
+  empty.append(elements);
+  elements.clear();
+  CPPUNIT_ASSERT_EQUAL(expected, record(empty));
+}
+
+void IWORKOutputElementsTest::testSelfAppend()
+{
+  IWORKOutputElements elements;
+  addParagraph(elements, "again");
+  elements.append(elements);
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("again") + paragraphLog("again"), record(elements));
+
+  IWORKOutputElements table;
+  table.addOpenTable(makeProps("table:name", "Table 1"));
+  table.addCloseTable();
+  table.addShapesInSpreadsheet(table);
+  CPPUNIT_ASSERT_EQUAL(string("openTable {table:name=Table 1;}\nopenTable {table:name=Table 1;}\ncloseTable\ncloseTable\n"), record(table));
+}
+
+void IWORKOutputElementsTest::testCopy()
+{
+  IWORKOutputElements elements;
+  addParagraph(elements, "copied");
+
+  IWORKOutputElements copy(elements);
+  elements.clear();
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("copied"), record(copy));
+
+  IWORKOutputElements assigned;
+  addParagraph(assigned, "overwritten");
+  assigned = copy;
+  copy.clear();
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("copied"), record(assigned));
+
+  IWORKOutputElements moved(std::move(assigned));
+  CPPUNIT_ASSERT(assigned.empty());
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("copied"), record(moved));
+
+  IWORKOutputElements moveAssigned;
+  moveAssigned = std::move(moved);
+  CPPUNIT_ASSERT(moved.empty());
+  CPPUNIT_ASSERT_EQUAL(paragraphLog("copied"), record(moveAssigned));
+}
+
+void IWORKOutputElementsTest::testFreedPayloads()
+{
+  const librevenge::RVNGPropertyList first(makeProps("style:font-name", "Arial"));
+  const librevenge::RVNGPropertyList second(makeProps("style:font-name", "Courier"));
+
+  {
+    IWORKOutputElements elements;
+    elements.addOpenSpan(first);
+    elements.addInsertText("gone");
+  }
+
+  // the freed payloads are reused, without being found as the old ones
+  IWORKOutputElements elements;
+  elements.addOpenSpan(second);
+  elements.addInsertText("kept");
+  IWORKOutputElements other;
+  other.addOpenSpan(first);
+  CPPUNIT_ASSERT_EQUAL(string("openSpan {style:font-name=Courier;}\ninsertText [kept]\n"), record(elements));
+  CPPUNIT_ASSERT_EQUAL(string("openSpan {style:font-name=Arial;}\n"), record(other));
+
+  // a shared payload stays as long as anybody uses it
+  IWORKOutputElements sharing;
+  sharing.addOpenSpan(second);
+  elements.clear();
+  IWORKOutputElements third;
+  third.addOpenSpan(makeProps("style:font-name", "Times"));
+  CPPUNIT_ASSERT_EQUAL(string("openSpan {style:font-name=Courier;}\n"), record(sharing));
+  CPPUNIT_ASSERT_EQUAL(string("openSpan {style:font-name=Times;}\n"), record(third));
+}
+
+void IWORKOutputElementsTest::testShapesInSpreadsheet()
+{
+  const string sheetStart("openTable {table:name=Sheet;}\n");
+  const string sheetEnd("openTableRow {}\ncloseTableRow\ncloseTable\n");
+  const string shapes("openFrame {svg:x=1in;}\ncloseFrame\nopenGroup {}\ncloseGroup\n");
+
+  IWORKOutputElements sheet;
+  sheet.addOpenTable(makeProps("table:name", "Sheet"));
+  sheet.addOpenTableRow(librevenge::RVNGPropertyList());
+  sheet.addCloseTableRow();
+  sheet.addCloseTable();
+
+  // nothing to add to
+  IWORKOutputElements empty;
+  empty.addShapesInSpreadsheet(sheet);
+  CPPUNIT_ASSERT(empty.empty());
+
+  // within one storage
+  {
+    IWORKOutputElements frame;
+    frame.addOpenFrame(makeProps("svg:x", "1in"));
+    frame.addCloseFrame();
+    frame.addOpenGroup(librevenge::RVNGPropertyList());
+    frame.addCloseGroup();
+    sheet.addShapesInSpreadsheet(frame);
+  }
+  CPPUNIT_ASSERT_EQUAL(sheetStart + shapes + sheetEnd, record(sheet));
+
+  // across storages
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::createStorage());
+  {
+    IWORKOutputElements frame;
+    frame.addOpenFrame(makeProps("svg:x", "2in"));
+    frame.addCloseFrame();
+    sheet.addShapesInSpreadsheet(frame);
+  }
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::StoragePtr_t());
+  CPPUNIT_ASSERT_EQUAL(sheetStart + "openFrame {svg:x=2in;}\ncloseFrame\n" + shapes + sheetEnd, record(sheet));
+}
+
+void IWORKOutputElementsTest::testFormulaCell()
+{
+  const librevenge::RVNGPropertyList cellProps(makeProps("librevenge:value-type", "float"));
+  const IWORKTableNameMapPtr_t tableNameMap = std::make_shared<IWORKTableNameMap_t>();
+  IWORKFormula formula(none);
+  CPPUNIT_ASSERT(formula.parse("=SUM(A1:B2)+1"));
+
+  RecordingDocumentInterface iface;
+  {
+    librevenge::RVNGPropertyList props(cellProps);
+    librevenge::RVNGPropertyListVector formulaProps;
+    formula.write(none, formulaProps, tableNameMap);
+    props.insert("librevenge:formula", formulaProps);
+    iface.openTableCell(props);
+    iface.closeTableCell();
+  }
+  const string expected = iface.getLog();
+  CPPUNIT_ASSERT(expected.find("librevenge:formula=[{") != string::npos);
+
+  IWORKOutputElements cell;
+  cell.addOpenFormulaCell(cellProps, formula, none, tableNameMap);
+  cell.addCloseTableCell();
+  CPPUNIT_ASSERT_EQUAL(expected, record(cell));
+
+  // the property list of the cell is shared with a plain cell
+  IWORKOutputElements plain;
+  plain.addOpenTableCell(cellProps);
+
+  // within one storage
+  IWORKOutputElements elements;
+  elements.append(cell);
+
+  // across storages
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::createStorage());
+  IWORKOutputElements copied;
+  copied.addInsertTab();
+  copied.append(cell);
+  IWORKOutputElements::setDefaultStorage(IWORKOutputElements::StoragePtr_t());
+
+  cell.clear();
+  CPPUNIT_ASSERT_EQUAL(expected, record(elements));
+  CPPUNIT_ASSERT_EQUAL("insertTab\n" + expected, record(copied));
+  elements.clear();
+  CPPUNIT_ASSERT_EQUAL(string("openTableCell {librevenge:value-type=float;}\n"), record(plain));
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IWORKOutputElementsTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,170 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "IWORKChainedTokenizer.h"
+#include "IWORKMemoryStream.h"
+#include "IWORKParser.h"
+#include "IWORKToken.h"
+#include "IWORKXMLContext.h"
+#include "KEY2Token.h"
+#include "NUM1Token.h"
+#include "PAG1Token.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWORKChainedTokenizer;
+using libetonyek::IWORKMemoryStream;
+using libetonyek::IWORKParser;
+using libetonyek::IWORKTokenizer;
+using libetonyek::IWORKXMLContext;
+using libetonyek::IWORKXMLContextPtr_t;
+using libetonyek::RVNGInputStreamPtr_t;
+
+/// Counts the element and attribute names it gets.
+class CountingContext : public IWORKXMLContext
+{
+public:
+  explicit CountingContext(unsigned long &names);
+
+private:
+  void startOfElement() override;
+  void attribute(int name, const char *value) override;
+  IWORKXMLContextPtr_t element(int name) override;
+  void text(const char *value) override;
+  void endOfElement() override;
+
+private:
+  unsigned long &m_names;
+};
+
+CountingContext::CountingContext(unsigned long &names)
+  : m_names(names)
+{
+}
+
+void CountingContext::startOfElement()
+{
+}
+
+void CountingContext::attribute(int, const char *)
+{
+  ++m_names;
+}
+
+IWORKXMLContextPtr_t CountingContext::element(int)
+{
+  ++m_names;
+  return libetonyek::allocateContext<CountingContext>(m_names);
+}
+
+void CountingContext::text(const char *)
+{
+}
+
+void CountingContext::endOfElement()
+{
+}
+
+class CountingParser : public IWORKParser
+{
+public:
+  CountingParser(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, unsigned long &names);
+
+private:
+  const IWORKTokenizer &getTokenizer() const override;
+  IWORKXMLContextPtr_t createDocumentContext() override;
+  IWORKXMLContextPtr_t createDiscardContext() override;
+
+private:
+  const IWORKTokenizer &m_tokenizer;
+  unsigned long &m_names;
+};
+
+CountingParser::CountingParser(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, unsigned long &names)
+  : IWORKParser(input, RVNGInputStreamPtr_t())
+  , m_tokenizer(tokenizer)
+  , m_names(names)
+{
+}
+
+const IWORKTokenizer &CountingParser::getTokenizer() const
+{
+  return m_tokenizer;
+}
+
+IWORKXMLContextPtr_t CountingParser::createDocumentContext()
+{
+  return libetonyek::allocateContext<CountingContext>(m_names);
+}
+
+IWORKXMLContextPtr_t CountingParser::createDiscardContext()
+{
+  return libetonyek::allocateContext<CountingContext>(m_names);
+}
+
+unsigned long parse(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, const bool useSAX)
+{
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  unsigned long names = 0;
+  CountingParser parser(input, tokenizer, names);
+  parser.setUseSAX(useSAX);
+  if (!parser.parse())
+    return 0;
+  return names;
+}
+
+/** Measure parsing of a document, with both parser backends.
+  *
+  * The document is uncompressed in advance, so only the XML parsing
+  * and the tokenizing of names are measured.
+  */
+void measureDocument(const char *const name, const IWORKTokenizer &tokenizer)
+{
+  const std::string xml(readCompressedDataFile(name));
+  const RVNGInputStreamPtr_t input(new IWORKMemoryStream(reinterpret_cast<const unsigned char *>(xml.data()), unsigned(xml.size())));
+  const unsigned long names = parse(input, tokenizer, false);
+  std::printf("  %s: %u bytes, %lu names\n", name, unsigned(xml.size()), names);
+
+  measure("xmlTextReader", [&input, &tokenizer]()
+  {
+    keep(parse(input, tokenizer, false));
+  }, xml.size(), names);
+  measure("SAX", [&input, &tokenizer]()
+  {
+    keep(parse(input, tokenizer, true));
+  }, xml.size(), names);
+}
+
+void benchParser()
+{
+  const IWORKChainedTokenizer keynoteTokenizer(libetonyek::KEY2Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  measureDocument("keynote4.apxl.gz", keynoteTokenizer);
+  const IWORKChainedTokenizer numbersTokenizer(libetonyek::NUM1Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  measureDocument("numbers2.xml.gz", numbersTokenizer);
+  const IWORKChainedTokenizer pagesTokenizer(libetonyek::PAG1Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  measureDocument("pages4.xml.gz", pagesTokenizer);
+}
+
+const BenchmarkRegistration parserRegistration("parser", &benchParser);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,399 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "IWORKChainedTokenizer.h"
+#include "IWORKParser.h"
+#include "IWORKToken.h"
+#include "IWORKXMLContext.h"
+#include "IWORKZlibStream.h"
+#include "KEY2Dictionary.h"
+#include "KEY2Parser.h"
+#include "KEY2Token.h"
+#include "KEYCollector.h"
+#include "NUM1Dictionary.h"
+#include "NUM1Parser.h"
+#include "NUM1Token.h"
+#include "NUMCollector.h"
+#include "PAG1Dictionary.h"
+#include "PAG1Parser.h"
+#include "PAG1Token.h"
+#include "PAGCollector.h"
+
+#include "TestDocumentInterface.h"
+
+#if !defined ETONYEK_STREAMS_TEST_DIR
+#error ETONYEK_STREAMS_TEST_DIR not defined, cannot test
+#endif
+
+namespace test
+{
+
+using libetonyek::IWORKChainedTokenizer;
+using libetonyek::IWORKParser;
+using libetonyek::IWORKTokenizer;
+using libetonyek::IWORKXMLContext;
+using libetonyek::IWORKXMLContextPtr_t;
+using libetonyek::IWORKZlibStream;
+using libetonyek::KEY2Dictionary;
+using libetonyek::KEY2Parser;
+using libetonyek::KEYCollector;
+using libetonyek::NUM1Dictionary;
+using libetonyek::NUM1Parser;
+using libetonyek::NUMCollector;
+using libetonyek::PAG1Dictionary;
+using libetonyek::PAG1Parser;
+using libetonyek::PAGCollector;
+using libetonyek::RVNGInputStreamPtr_t;
+
+using std::string;
+
+namespace
+{
+
+/// Records every callback it gets, so the output of two parser backends can be compared.
+class RecordingContext : public IWORKXMLContext
+{
+public:
+  RecordingContext(std::ostringstream &log, bool discard, int skippedName, bool skip);
+
+private:
+  void startOfElement() override;
+  void attribute(int name, const char *value) override;
+  IWORKXMLContextPtr_t element(int name) override;
+  void text(const char *value) override;
+  void CDATA(const char *value) override;
+  void endOfElement() override;
+  bool skipContent() const override;
+
+private:
+  std::ostringstream &m_log;
+  const bool m_discard;
+  const int m_skippedName;
+  const bool m_skip;
+};
+
+RecordingContext::RecordingContext(std::ostringstream &log, const bool discard, const int skippedName, const bool skip)
+  : m_log(log)
+  , m_discard(discard)
+  , m_skippedName(skippedName)
+  , m_skip(skip)
+{
+}
+
+void RecordingContext::startOfElement()
+{
+  m_log << (m_discard ? "start discard\n" : "start\n");
+}
+
+void RecordingContext::attribute(const int name, const char *const value)
+{
+  m_log << "attribute " << name << " [" << value << "]\n";
+}
+
+IWORKXMLContextPtr_t RecordingContext::element(const int name)
+{
+  m_log << "element " << name << "\n";
+  if (m_discard || (name == 0))
+    return IWORKXMLContextPtr_t();
+  return std::make_shared<RecordingContext>(m_log, false, m_skippedName, name == m_skippedName);
+}
+
+void RecordingContext::text(const char *const value)
+{
+  m_log << "text [" << value << "]\n";
+}
+
+void RecordingContext::CDATA(const char *const value)
+{
+  m_log << "CDATA [" << value << "]\n";
+}
+
+void RecordingContext::endOfElement()
+{
+  m_log << "end\n";
+}
+
+bool RecordingContext::skipContent() const
+{
+  return m_skip;
+}
+
+class RecordingParser : public IWORKParser
+{
+public:
+  RecordingParser(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, std::ostringstream &log, int skippedName);
+
+private:
+  const IWORKTokenizer &getTokenizer() const override;
+  IWORKXMLContextPtr_t createDocumentContext() override;
+  IWORKXMLContextPtr_t createDiscardContext() override;
+
+private:
+  const IWORKTokenizer &m_tokenizer;
+  std::ostringstream &m_log;
+  const int m_skippedName;
+};
+
+RecordingParser::RecordingParser(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, std::ostringstream &log, const int skippedName)
+  : IWORKParser(input, RVNGInputStreamPtr_t())
+  , m_tokenizer(tokenizer)
+  , m_log(log)
+  , m_skippedName(skippedName)
+{
+}
+
+const IWORKTokenizer &RecordingParser::getTokenizer() const
+{
+  return m_tokenizer;
+}
+
+IWORKXMLContextPtr_t RecordingParser::createDocumentContext()
+{
+  return std::make_shared<RecordingContext>(m_log, false, m_skippedName, false);
+}
+
+IWORKXMLContextPtr_t RecordingParser::createDiscardContext()
+{
+  return std::make_shared<RecordingContext>(m_log, true, m_skippedName, false);
+}
+
+RVNGInputStreamPtr_t makeStream(const char *const xml)
+{
+  return RVNGInputStreamPtr_t(new librevenge::RVNGStringStream(reinterpret_cast<const unsigned char *>(xml), unsigned(std::strlen(xml))));
+}
+
+string parse(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer, const bool useSAX, const int skippedName = -1)
+{
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  std::ostringstream log;
+  RecordingParser parser(input, tokenizer, log, skippedName);
+  parser.setUseSAX(useSAX);
+  CPPUNIT_ASSERT(parser.parse());
+  return log.str();
+}
+
+void assertSameEvents(const RVNGInputStreamPtr_t &input, const IWORKTokenizer &tokenizer)
+{
+  const string readerLog(parse(input, tokenizer, false));
+  const string saxLog(parse(input, tokenizer, true));
+  CPPUNIT_ASSERT(!readerLog.empty());
+  CPPUNIT_ASSERT_EQUAL(readerLog, saxLog);
+}
+
+void assertSameEvents(const char *const xml, const IWORKTokenizer &tokenizer)
+{
+  assertSameEvents(makeStream(xml), tokenizer);
+}
+
+RVNGInputStreamPtr_t openFile(const char *const name)
+{
+  const string path(string(ETONYEK_STREAMS_TEST_DIR) + "/" + name);
+  return RVNGInputStreamPtr_t(new librevenge::RVNGFileStream(path.c_str()));
+}
+
+void assertSameEventsInFile(const char *const name, const IWORKTokenizer &tokenizer)
+{
+  const RVNGInputStreamPtr_t input(new IWORKZlibStream(openFile(name)));
+  assertSameEvents(input, tokenizer);
+}
+
+string convertKeynote(const char *const name, const bool useSAX)
+{
+  // the compressed file is not a package, but it serves as an empty one
+  const RVNGInputStreamPtr_t file(openFile(name));
+  const RVNGInputStreamPtr_t input(new IWORKZlibStream(file));
+  RecordingDocumentInterface document;
+  {
+    KEYCollector collector(&document);
+    KEY2Dictionary dict;
+    KEY2Parser parser(input, file, collector, dict);
+    parser.setUseSAX(useSAX);
+    CPPUNIT_ASSERT(parser.parse());
+  }
+  return document.getLog();
+}
+
+string convertNumbers(const char *const name, const bool useSAX)
+{
+  const RVNGInputStreamPtr_t file(openFile(name));
+  const RVNGInputStreamPtr_t input(new IWORKZlibStream(file));
+  RecordingDocumentInterface document;
+  {
+    NUMCollector collector(&document);
+    NUM1Dictionary dict;
+    NUM1Parser parser(input, file, collector, &dict);
+    parser.setUseSAX(useSAX);
+    CPPUNIT_ASSERT(parser.parse());
+  }
+  return document.getLog();
+}
+
+string convertPages(const char *const name, const bool useSAX)
+{
+  const RVNGInputStreamPtr_t file(openFile(name));
+  const RVNGInputStreamPtr_t input(new IWORKZlibStream(file));
+  RecordingDocumentInterface document;
+  {
+    PAGCollector collector(&document);
+    PAG1Dictionary dict;
+    PAG1Parser parser(input, file, collector, &dict);
+    parser.setUseSAX(useSAX);
+    CPPUNIT_ASSERT(parser.parse());
+  }
+  return document.getLog();
+}
+
+/// Check that a document is converted the same way by both parser backends.
+void assertSameDocument(string (*const convert)(const char *, bool), const char *const name)
+{
+  const string readerLog(convert(name, false));
+  CPPUNIT_ASSERT(!readerLog.empty());
+  CPPUNIT_ASSERT_EQUAL(readerLog, convert(name, true));
+}
+
+}
+
+class IWORKParserTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp();
+  virtual void tearDown();
+
+private:
+  CPPUNIT_TEST_SUITE(IWORKParserTest);
+  CPPUNIT_TEST(testSnippets);
+  CPPUNIT_TEST(testSkipContent);
+  CPPUNIT_TEST(testContextAllocation);
+  CPPUNIT_TEST(testKeynote);
+  CPPUNIT_TEST(testNumbers);
+  CPPUNIT_TEST(testPages);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testSnippets();
+  void testSkipContent();
+  void testContextAllocation();
+  void testKeynote();
+  void testNumbers();
+  void testPages();
+};
+
+void IWORKParserTest::setUp()
+{
+}
+
+void IWORKParserTest::tearDown()
+{
+}
+
+void IWORKParserTest::testSnippets()
+{
+  const IWORKChainedTokenizer tokenizer(libetonyek::KEY2Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+
+  // no namespace at all
+  assertSameEvents("<presentation><slide/></presentation>", tokenizer);
+  // a default namespace
+  assertSameEvents("<presentation xmlns=\"http://developer.apple.com/namespaces/keynote2\"><slide/></presentation>", tokenizer);
+  // namespace declarations, attributes and unknown elements
+  assertSameEvents(
+    "<?xml version=\"1.0\"?>\n"
+    "<key:presentation xmlns:key=\"http://developer.apple.com/namespaces/keynote2\" xmlns:sf=\"http://developer.apple.com/namespaces/sf\" key:version=\"1\">\n"
+    "  <key:slide sf:ID=\"a&amp;b\" unknown=\"&lt;x&gt;\"><unknown><key:slide/></unknown></key:slide>\n"
+    "  <sf:p>a &amp; b<sf:br/> c &#x41; </sf:p>\n"
+    "</key:presentation>\n",
+    tokenizer);
+  // whitespace, comments, processing instructions and CDATA
+  assertSameEvents(
+    "<key:presentation xmlns:key=\"http://developer.apple.com/namespaces/keynote2\">\n"
+    "  <key:notes>one<!-- comment -->two<?pi data?>three</key:notes>\n"
+    "  <key:notes><![CDATA[<cdata> & more]]></key:notes>\n"
+    "  <key:notes>  </key:notes>\n"
+    "</key:presentation>\n",
+    tokenizer);
+}
+
+void IWORKParserTest::testSkipContent()
+{
+  const IWORKChainedTokenizer tokenizer(libetonyek::KEY2Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  const int notes = tokenizer.getQualifiedId("notes", "http://developer.apple.com/namespaces/keynote2");
+  CPPUNIT_ASSERT(notes != 0);
+
+  // a skipped element looks like an empty one
+  const RVNGInputStreamPtr_t input(makeStream(
+    "<key:presentation xmlns:key=\"http://developer.apple.com/namespaces/keynote2\">"
+    "<key:notes key:version=\"1\">text<key:notes><key:slide/>more</key:notes><![CDATA[x]]><!-- c --></key:notes>"
+    "<key:slide>after</key:slide>"
+    "</key:presentation>"
+  ));
+  const RVNGInputStreamPtr_t expectedInput(makeStream(
+    "<key:presentation xmlns:key=\"http://developer.apple.com/namespaces/keynote2\">"
+    "<key:notes key:version=\"1\"/>"
+    "<key:slide>after</key:slide>"
+    "</key:presentation>"
+  ));
+  const string expected(parse(expectedInput, tokenizer, false));
+  CPPUNIT_ASSERT_EQUAL(expected, parse(input, tokenizer, false, notes));
+  CPPUNIT_ASSERT_EQUAL(expected, parse(input, tokenizer, true, notes));
+}
+
+void IWORKParserTest::testContextAllocation()
+{
+  std::ostringstream log;
+  const void *address = nullptr;
+  {
+    const IWORKXMLContextPtr_t context(libetonyek::allocateContext<RecordingContext>(log, false, -1, false));
+    context->startOfElement();
+    address = context.get();
+  }
+  CPPUNIT_ASSERT_EQUAL(string("start\n"), log.str());
+
+  // the memory of a freed context is used for the next one of the same type
+  const IWORKXMLContextPtr_t context(libetonyek::allocateContext<RecordingContext>(log, false, -1, false));
+  CPPUNIT_ASSERT_EQUAL(address, static_cast<const void *>(context.get()));
+}
+
+void IWORKParserTest::testKeynote()
+{
+  const IWORKChainedTokenizer tokenizer(libetonyek::KEY2Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  assertSameEventsInFile("keynote4.apxl.gz", tokenizer);
+  // the whole conversion, through the real contexts
+  assertSameDocument(&convertKeynote, "keynote4.apxl.gz");
+}
+
+void IWORKParserTest::testNumbers()
+{
+  const IWORKChainedTokenizer tokenizer(libetonyek::NUM1Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  assertSameEventsInFile("numbers2.xml.gz", tokenizer);
+  // the whole conversion, through the real contexts
+  assertSameDocument(&convertNumbers, "numbers2.xml.gz");
+}
+
+void IWORKParserTest::testPages()
+{
+  const IWORKChainedTokenizer tokenizer(libetonyek::PAG1Token::getTokenizer(), libetonyek::IWORKToken::getTokenizer());
+  assertSameEventsInFile("pages4.xml.gz", tokenizer);
+  // the whole conversion, through the real contexts
+  assertSameDocument(&convertPages, "pages4.xml.gz");
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IWORKParserTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
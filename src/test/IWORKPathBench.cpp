@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "IWORKPath.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWORKPath;
+
+typedef std::vector<std::string> Paths_t;
+
+/// Extract the paths of all bezier elements of a document.
+void extractPaths(const char *const name, Paths_t &paths)
+{
+  const std::string xml(readCompressedDataFile(name));
+  const std::string attribute(":path=\"");
+  std::string::size_type pos = 0;
+  while ((pos = xml.find("bezier ", pos)) != std::string::npos)
+  {
+    const std::string::size_type tagEnd = xml.find('>', pos);
+    const std::string::size_type start = xml.find(attribute, pos);
+    pos += 7;
+    if ((start == std::string::npos) || (start > tagEnd))
+      continue;
+    const std::string::size_type end = xml.find('"', start + attribute.size());
+    if (end == std::string::npos)
+      break;
+    paths.push_back(xml.substr(start + attribute.size(), end - start - attribute.size()));
+  }
+}
+
+/** Create a path of curves, like those of vector artwork.
+  *
+  * @arg[in] segments the number of curve segments
+  */
+std::string makeCurvePath(const unsigned segments, std::mt19937 &random)
+{
+  std::uniform_real_distribution<double> coord(0, 1000);
+  std::ostringstream path;
+  path.precision(7);
+  path << "M " << coord(random) << ' ' << coord(random);
+  for (unsigned i = 0; i < segments; ++i)
+  {
+    if (i % 4 == 3)
+      path << " L " << coord(random) << ' ' << coord(random);
+    else
+      path << " C " << coord(random) << ' ' << coord(random) << ' ' << coord(random) << ' ' << coord(random) << ' ' << coord(random) << ' ' << coord(random);
+  }
+  path << " Z";
+  return path.str();
+}
+
+std::size_t getSize(const Paths_t &paths)
+{
+  std::size_t size = 0;
+  for (const auto &path : paths)
+    size += path.size();
+  return size;
+}
+
+void measurePaths(const std::string &label, const Paths_t &paths)
+{
+  const std::size_t size = getSize(paths);
+  std::printf("  %s: %u paths, %u bytes\n", label.c_str(), unsigned(paths.size()), unsigned(size));
+
+  measure("parse", [&paths]()
+  {
+    std::size_t length = 0;
+    for (const auto &path : paths)
+    {
+      const IWORKPath parsed(path);
+      length += parsed.empty() ? 0 : 1;
+    }
+    keep(length);
+  }, size, paths.size());
+
+  std::vector<IWORKPath> parsed;
+  for (const auto &path : paths)
+    parsed.push_back(IWORKPath(path));
+  measure("str", [&parsed]()
+  {
+    std::size_t length = 0;
+    for (const auto &path : parsed)
+      length += path.str().size();
+    keep(length);
+  }, size, paths.size());
+}
+
+void benchPath()
+{
+  Paths_t paths;
+  extractPaths("keynote4.apxl.gz", paths);
+  extractPaths("numbers2.xml.gz", paths);
+  extractPaths("pages4.xml.gz", paths);
+  measurePaths("sample documents", paths);
+
+  // the sample documents only contain a few rectangles
+  std::mt19937 random(42);
+  Paths_t curves;
+  for (unsigned i = 0; i < 1000; ++i)
+    curves.push_back(makeCurvePath(1 + unsigned(random() % 40), random));
+  measurePaths("generated curves", curves);
+}
+
+const BenchmarkRegistration pathRegistration("path", &benchPath);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -14,6 +14,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include "IWORKPath.h"
+#include "IWORKTransformation.h"
 
 using libetonyek::IWORKPath;
 
@@ -32,11 +33,19 @@ private:
   CPPUNIT_TEST_SUITE(IWORKPathTest);
   CPPUNIT_TEST(testConstruction);
   CPPUNIT_TEST(testConversion);
+  CPPUNIT_TEST(testParsing);
+  CPPUNIT_TEST(testInvalid);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testTransformation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   void testConstruction();
   void testConversion();
+  void testParsing();
+  void testInvalid();
+  void testRoundTrip();
+  void testTransformation();
 };
 
 void IWORKPathTest::setUp()
@@ -127,6 +136,92 @@ void  IWORKPathTest::testConversion()
   }
 }
 
+void IWORKPathTest::testParsing()
+{
+  // no whitespace
+  CPPUNIT_ASSERT_EQUAL(string("M 0 0 L 1 1"), IWORKPath("M0 0L1 1").str());
+  CPPUNIT_ASSERT_EQUAL(string("M 1 -2 L 0.5 0.5"), IWORKPath("M1-2L.5 .5").str());
+
+  // other whitespace
+  CPPUNIT_ASSERT_EQUAL(string("M 0 0 L 1 1 Z"), IWORKPath("\t M 0\n0\r\nL 1  1 Z \n").str());
+
+  // number formats
+  CPPUNIT_ASSERT_EQUAL(string("M 10 -0.5 L 0.001 250"), IWORKPath("M 1e1 -.5 L 1E-3 +2.5e+2").str());
+  CPPUNIT_ASSERT_EQUAL(string("M 1 2 L 0.333333 100"), IWORKPath("M 1. 002 L 0.333333333333333333333 100.000000000000000000").str());
+
+  // multiple curves
+  CPPUNIT_ASSERT_EQUAL(string("M 0 0 Q 1 1 2 2 M 3 3 L 4 4 Z"), IWORKPath("M 0 0 Q 1 1 2 2 M 3 3 L 4 4 Z").str());
+
+  // trailing moves are ignored
+  CPPUNIT_ASSERT_EQUAL(string("M 0 0 L 1 1"), IWORKPath("M 0 0 L 1 1 M 2 2 M 3 3").str());
+}
+
+void IWORKPathTest::testInvalid()
+{
+  CPPUNIT_ASSERT_THROW(IWORKPath(""), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath(" "), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("L 1 1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 Z"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1 1 1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0,0 L 1,1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("m 0 0 l 1 1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1 1 Z Z"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1 1 M 2 2 Z"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1 1 M 2 2 L 3 3 M 4 4 L 5 5 M 6"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1 1 M 2 2 M 3 3 L 4 4"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L 1e 1"), IWORKPath::InvalidException);
+  CPPUNIT_ASSERT_THROW(IWORKPath("M 0 0 L - 1 1"), IWORKPath::InvalidException);
+}
+
+void IWORKPathTest::testRoundTrip()
+{
+  const char *const paths[] =
+  {
+    "M 0 0 L 1 1",
+    "M 0 0 L 1 0 L 1 1 L 0 1 Z",
+    "M 10.5 -3.25 C 1 2 3 4 5 6 Q 7 8 9 10 Z M 1 1 L 2 2",
+    "M 1e-05 123456 L 0.5 1e+10",
+  };
+
+  for (const char *path : paths)
+  {
+    const IWORKPath parsed(path);
+    CPPUNIT_ASSERT_EQUAL(string(path), parsed.str());
+    const IWORKPath reparsed(parsed.str());
+    CPPUNIT_ASSERT(parsed == reparsed);
+  }
+}
+
+void IWORKPathTest::testTransformation()
+{
+  using namespace libetonyek::transformations;
+
+  const IWORKPath path("M 0 0 L 1 0 C 1 1 2 2 3 3 Q 4 4 5 5 Z");
+
+  {
+    const IWORKPath transformed(path, translate(1, 2) * scale(2, 3));
+    CPPUNIT_ASSERT_EQUAL(string("M 1 2 L 3 2 C 3 5 5 8 7 11 Q 9 14 11 17 Z"), transformed.str());
+    CPPUNIT_ASSERT(transformed == path * (translate(1, 2) * scale(2, 3)));
+  }
+
+  {
+    IWORKPath transformed(path);
+    transformed *= scale(2, 3);
+    CPPUNIT_ASSERT_EQUAL(string("M 0 0 L 2 0 C 2 3 4 6 6 9 Q 8 12 10 15 Z"), transformed.str());
+  }
+
+  {
+    double minX, minY, maxX, maxY;
+    IWORKPath("M 1 -1 L 3 2 L -2 5 Z").computeBoundingBox(minX, minY, maxX, maxY, 2);
+    CPPUNIT_ASSERT_EQUAL(-4.0, minX);
+    CPPUNIT_ASSERT_EQUAL(-2.0, minY);
+    CPPUNIT_ASSERT_EQUAL(6.0, maxX);
+    CPPUNIT_ASSERT_EQUAL(10.0, maxY);
+  }
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(IWORKPathTest);
 
 }
@@ -7,6 +7,8 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include <string>
+
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -22,6 +24,7 @@ using libetonyek::property::Answer;
 using libetonyek::property::Antwort;
 using libetonyek::IWORKPropertyInfo;
 using libetonyek::IWORKPropertyMap;
+using libetonyek::getPropertyName;
 
 class IWORKPropertyMapTest : public CPPUNIT_NS::TestFixture
 {
@@ -33,11 +36,15 @@ private:
   CPPUNIT_TEST_SUITE(IWORKPropertyMapTest);
   CPPUNIT_TEST(testLookup);
   CPPUNIT_TEST(testLookupWithParent);
+  CPPUNIT_TEST(testPropertyIDs);
+  CPPUNIT_TEST(testFlatten);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   void testLookup();
   void testLookupWithParent();
+  void testPropertyIDs();
+  void testFlatten();
 };
 
 void IWORKPropertyMapTest::setUp()
@@ -135,6 +142,67 @@ void IWORKPropertyMapTest::testLookupWithParent()
   }
 }
 
+void IWORKPropertyMapTest::testPropertyIDs()
+{
+  CPPUNIT_ASSERT(IWORKPropertyInfo<Answer>::id != 0);
+  CPPUNIT_ASSERT(IWORKPropertyInfo<Antwort>::id != 0);
+  CPPUNIT_ASSERT(IWORKPropertyInfo<Answer>::id != IWORKPropertyInfo<Antwort>::id);
+  CPPUNIT_ASSERT_EQUAL(std::string("Answer"), std::string(getPropertyName(IWORKPropertyInfo<Answer>::id)));
+  CPPUNIT_ASSERT_EQUAL(std::string("Antwort"), std::string(getPropertyName(IWORKPropertyInfo<Antwort>::id)));
+  CPPUNIT_ASSERT_EQUAL(std::string(), std::string(getPropertyName(0)));
+}
+
+void IWORKPropertyMapTest::testFlatten()
+{
+  IWORKPropertyMap grandparent;
+  grandparent.put<Answer>(1);
+  grandparent.put<Antwort>(2);
+  IWORKPropertyMap parent(&grandparent);
+  parent.put<Answer>(42);
+  IWORKPropertyMap props(&parent);
+  props.clear<Antwort>();
+
+  props.flatten();
+  grandparent.put<Answer>(3);
+  parent.put<Answer>(4);
+
+  // the values are taken from the closest map and later changes of parents are ignored
+  CPPUNIT_ASSERT(props.isFlattened());
+  CPPUNIT_ASSERT(props.has<Answer>(true));
+  CPPUNIT_ASSERT_EQUAL(42, props.get<Answer>(true));
+  CPPUNIT_ASSERT(!props.has<Antwort>(true));
+  CPPUNIT_ASSERT(props.clears<Antwort>(true));
+
+  // the map itself still only has its own properties
+  CPPUNIT_ASSERT(!props.has<Answer>());
+  CPPUNIT_ASSERT_THROW(props.get<Answer>(), IWORKPropertyMap::NotFoundException);
+  CPPUNIT_ASSERT(props.clears<Antwort>());
+
+  // a change of the map drops the snapshot
+  props.put<Antwort>(5);
+  CPPUNIT_ASSERT(!props.isFlattened());
+  CPPUNIT_ASSERT_EQUAL(4, props.get<Answer>(true));
+  CPPUNIT_ASSERT_EQUAL(5, props.get<Antwort>(true));
+
+  // a map without a parent does not need a snapshot
+  grandparent.flatten();
+  CPPUNIT_ASSERT(!grandparent.isFlattened());
+
+  // a snapshot of the parent is used
+  parent.flatten();
+  grandparent.put<Antwort>(6);
+  IWORKPropertyMap child(&parent);
+  child.flatten();
+  CPPUNIT_ASSERT_EQUAL(4, child.get<Answer>(true));
+  CPPUNIT_ASSERT_EQUAL(2, child.get<Antwort>(true));
+
+  // a new parent drops the snapshot
+  child.setParent(&grandparent);
+  CPPUNIT_ASSERT(!child.isFlattened());
+  CPPUNIT_ASSERT_EQUAL(3, child.get<Answer>(true));
+  CPPUNIT_ASSERT_EQUAL(6, child.get<Antwort>(true));
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(IWORKPropertyMapTest);
 
 }
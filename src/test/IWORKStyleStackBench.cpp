@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "IWORKProperties.h"
+#include "IWORKPropertyMap.h"
+#include "IWORKStyle.h"
+#include "IWORKStyleStack.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWORKPropertyMap;
+using libetonyek::IWORKStyle;
+using libetonyek::IWORKStylePtr_t;
+using libetonyek::IWORKStyleStack;
+
+namespace property = libetonyek::property;
+
+const unsigned LOOKUPS = 100000;
+
+/** Resolve the properties of a text span.
+  *
+  * The properties are found at different depths of the stack, and
+  * one of them is not found at all.
+  */
+uint64_t resolve(const IWORKStyleStack &stack)
+{
+  uint64_t sum = 0;
+  if (stack.has<property::Bold>() && stack.get<property::Bold>())
+    sum += 1;
+  if (stack.has<property::Italic>() && stack.get<property::Italic>())
+    sum += 2;
+  if (stack.has<property::FontSize>())
+    sum += uint64_t(stack.get<property::FontSize>());
+  if (stack.has<property::FontName>())
+    sum += stack.get<property::FontName>().size();
+  if (stack.has<property::Alignment>())
+    sum += uint64_t(stack.get<property::Alignment>());
+  if (stack.has<property::Underline>())
+    sum += 3;
+  return sum;
+}
+
+void benchStyleStack()
+{
+  const boost::optional<std::string> ident;
+
+  IWORKPropertyMap parentProps;
+  parentProps.put<property::FontName>("Helvetica Neue");
+  parentProps.put<property::FontSize>(12);
+  parentProps.put<property::Alignment>(libetonyek::IWORK_ALIGNMENT_JUSTIFY);
+  parentProps.put<property::LeftIndent>(0);
+  parentProps.put<property::RightIndent>(0);
+  const IWORKStylePtr_t parent(new IWORKStyle(parentProps, ident, IWORKStylePtr_t()));
+
+  IWORKPropertyMap paraProps;
+  paraProps.put<property::FontSize>(24);
+  paraProps.put<property::Italic>(false);
+  paraProps.put<property::FirstLineIndent>(10);
+  const IWORKStylePtr_t paraStyle(new IWORKStyle(paraProps, ident, parent));
+
+  IWORKPropertyMap charProps;
+  charProps.put<property::Bold>(true);
+  charProps.clear<property::Underline>();
+  const IWORKStylePtr_t charStyle(new IWORKStyle(charProps, ident, IWORKStylePtr_t()));
+
+  IWORKStyleStack stack;
+  stack.push(paraStyle);
+  stack.push(charStyle);
+
+  // 6 properties per lookup
+  measure("resolve a span style", [&stack]()
+  {
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < LOOKUPS; ++i)
+      sum += resolve(stack);
+    keep(sum);
+  }, 0, 6 * LOOKUPS);
+}
+
+const BenchmarkRegistration styleStackRegistration("stylestack", &benchStyleStack);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,106 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "IWORKMemoryStream.h"
+#include "libetonyek_utils.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+const std::size_t VALUES = 1 << 16;
+
+void appendUVar(uint64_t value, std::vector<unsigned char> &data)
+{
+  while (value >= 0x80)
+  {
+    data.push_back((unsigned char)(value | 0x80));
+    value >>= 7;
+  }
+  data.push_back((unsigned char) value);
+}
+
+/** Create varints of a mix of lengths resembling IWA messages.
+  *
+  * Most values are field keys, small lengths and small numbers that
+  * take 1 or 2 bytes. Object IDs and other big numbers are rarer.
+  */
+std::vector<unsigned char> makeVarints()
+{
+  std::mt19937 random(42);
+  std::vector<unsigned char> data;
+  for (std::size_t i = 0; i < VALUES; ++i)
+  {
+    const unsigned kind = unsigned(random() % 100);
+    uint64_t value;
+    if (kind < 70)
+      value = random() % 0x80;
+    else if (kind < 90)
+      value = 0x80 + random() % (0x4000 - 0x80);
+    else if (kind < 98)
+      value = random();
+    else
+      value = (uint64_t(random()) << 32) | random();
+    appendUVar(value, data);
+  }
+  return data;
+}
+
+void benchVarint()
+{
+  using libetonyek::RVNGInputStreamPtr_t;
+
+  const std::vector<unsigned char> data = makeVarints();
+
+  measure("readUVar(buffer)", [&data]()
+  {
+    const unsigned char *p = data.data();
+    const unsigned char *const end = p + data.size();
+    uint64_t sum = 0;
+    while (p != end)
+      sum += libetonyek::readUVar(p, end);
+    keep(sum);
+  }, data.size(), VALUES);
+
+  measure("readSVar(buffer)", [&data]()
+  {
+    const unsigned char *p = data.data();
+    const unsigned char *const end = p + data.size();
+    uint64_t sum = 0;
+    while (p != end)
+      sum += uint64_t(libetonyek::readSVar(p, end));
+    keep(sum);
+  }, data.size(), VALUES);
+
+  const RVNGInputStreamPtr_t input(new libetonyek::IWORKMemoryStream(data));
+  measure("readUVar(stream)", [&input]()
+  {
+    input->seek(0, librevenge::RVNG_SEEK_SET);
+    uint64_t sum = 0;
+    for (std::size_t i = 0; i < VALUES; ++i)
+      sum += libetonyek::readUVar(input);
+    keep(sum);
+  }, data.size(), VALUES);
+}
+
+const BenchmarkRegistration varintRegistration("varint", &benchVarint);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
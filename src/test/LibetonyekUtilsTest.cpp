@@ -31,6 +31,24 @@ namespace test
 namespace
 {
 
+int64_t readSVarBuffer(const char *const bytes, const size_t len)
+{
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(bytes);
+  const unsigned char *const end = p + len;
+  const int64_t value = readSVar(p, end);
+  CPPUNIT_ASSERT(p == end);
+  return value;
+}
+
+uint64_t readUVarBuffer(const char *const bytes, const size_t len)
+{
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(bytes);
+  const unsigned char *const end = p + len;
+  const uint64_t value = readUVar(p, end);
+  CPPUNIT_ASSERT(p == end);
+  return value;
+}
+
 RVNGInputStreamPtr_t makeStream(const char *const bytes, const size_t len)
 {
   return std::make_shared<IWORKMemoryStream>(reinterpret_cast<const unsigned char *>(bytes), len);
@@ -55,11 +73,15 @@ private:
   CPPUNIT_TEST_SUITE(LibetonyekUtilsTest);
   CPPUNIT_TEST(testReadSVar);
   CPPUNIT_TEST(testReadUVar);
+  CPPUNIT_TEST(testReadSVarBuffer);
+  CPPUNIT_TEST(testReadUVarBuffer);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   void testReadSVar();
   void testReadUVar();
+  void testReadSVarBuffer();
+  void testReadUVarBuffer();
 };
 
 void LibetonyekUtilsTest::setUp()
@@ -102,6 +124,46 @@ void LibetonyekUtilsTest::testReadUVar()
   CPPUNIT_ASSERT_THROW(readUVar(makeStream("\xff\xff", 2)), EndOfStreamException);
 }
 
+void LibetonyekUtilsTest::testReadSVarBuffer()
+{
+  CPPUNIT_ASSERT_EQUAL(int64_t(0), readSVarBuffer("\x0", 1));
+  CPPUNIT_ASSERT_EQUAL(int64_t(-1), readSVarBuffer("\x1", 1));
+  CPPUNIT_ASSERT_EQUAL(int64_t(1), readSVarBuffer("\x2", 1));
+  CPPUNIT_ASSERT_EQUAL(int64_t(-2), readSVarBuffer("\x3", 1));
+  CPPUNIT_ASSERT_EQUAL(int64_t(0x7fffffffL), readSVarBuffer("\xfe\xff\xff\xff\xf", 5));
+  CPPUNIT_ASSERT_EQUAL(int64_t(numeric_limits<int32_t>::min()), readSVarBuffer("\xff\xff\xff\xff\xf", 5));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<int64_t>::max(), readSVarBuffer("\xfe\xff\xff\xff\xff\xff\xff\xff\xff\x1", 10));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<int64_t>::min(), readSVarBuffer("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x1", 10));
+  CPPUNIT_ASSERT_THROW(readSVarBuffer("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x2", 10), std::range_error);
+  CPPUNIT_ASSERT_THROW(readSVarBuffer("", 0), EndOfStreamException);
+  CPPUNIT_ASSERT_THROW(readSVarBuffer("\x80", 1), EndOfStreamException);
+  CPPUNIT_ASSERT_THROW(readSVarBuffer("\xff\xff", 2), EndOfStreamException);
+}
+
+void LibetonyekUtilsTest::testReadUVarBuffer()
+{
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0), readUVarBuffer("\x0", 1));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(1), readUVarBuffer("\x1", 1));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x7f), readUVarBuffer("\x7f", 1));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x80), readUVarBuffer("\x80\x1", 2));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x81), readUVarBuffer("\x81\x1", 2));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x3fff), readUVarBuffer("\xff\x7f", 2));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x4000), readUVarBuffer("\x80\x80\x1", 3));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x12345678UL), readUVarBuffer("\xf8\xac\xd1\x91\x01", 5));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<uint64_t>::max(), readUVarBuffer("\xff\xff\xff\xff\xff\xff\xff\xff\xff\x1", 10));
+  CPPUNIT_ASSERT_THROW(readUVarBuffer("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x2", 10), std::range_error);
+  CPPUNIT_ASSERT_THROW(readUVarBuffer("\x80\x80\x80\x80\x80\x80\x80\x80\x80\x80\x0", 11), std::range_error);
+  CPPUNIT_ASSERT_THROW(readUVarBuffer("", 0), EndOfStreamException);
+  CPPUNIT_ASSERT_THROW(readUVarBuffer("\x80", 1), EndOfStreamException);
+  CPPUNIT_ASSERT_THROW(readUVarBuffer("\xff\xff", 2), EndOfStreamException);
+
+  // only the value is consumed
+  const unsigned char bytes[] = { 0x81, 0x1, 0x2 };
+  const unsigned char *p = bytes;
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0x81), readUVar(p, bytes + 3));
+  CPPUNIT_ASSERT(p == bytes + 2);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(LibetonyekUtilsTest);
 
 }
@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
+
+#include <libxml/xmlreader.h>
+
+#include "libetonyek_xml.h"
+
+#include "Bench.h"
+
+namespace test
+{
+
+namespace
+{
+
+typedef std::vector<std::string> Values_t;
+
+/// Extract the values of all attributes of a document.
+void extractValues(const char *const name, Values_t &values)
+{
+  const std::string xml(readCompressedDataFile(name));
+  const xmlTextReaderPtr reader = xmlReaderForMemory(xml.data(), int(xml.size()), "", nullptr, 0);
+  if (!reader)
+    return;
+  while (xmlTextReaderRead(reader) == 1)
+  {
+    if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT)
+      continue;
+    while (xmlTextReaderMoveToNextAttribute(reader) == 1)
+    {
+      if (xmlTextReaderIsNamespaceDecl(reader) == 1)
+        continue;
+      values.push_back(libetonyek::char_cast(xmlTextReaderConstValue(reader)));
+    }
+  }
+  xmlFreeTextReader(reader);
+}
+
+// the conversions as they were done by boost::lexical_cast
+
+boost::optional<double> lexicalTryDouble(const char *const value) try
+{
+  return boost::lexical_cast<double, const char *>(value);
+}
+catch (const boost::bad_lexical_cast &)
+{
+  return boost::none;
+}
+
+boost::optional<int> lexicalTryInt(const char *const value) try
+{
+  return boost::lexical_cast<int, const char *>(value);
+}
+catch (const boost::bad_lexical_cast &)
+{
+  return boost::none;
+}
+
+void benchXMLNumbers()
+{
+  Values_t values;
+  extractValues("keynote4.apxl.gz", values);
+  extractValues("numbers2.xml.gz", values);
+  extractValues("pages4.xml.gz", values);
+
+  Values_t numbers;
+  for (const auto &value : values)
+  {
+    if (libetonyek::try_double_cast(value.c_str()))
+      numbers.push_back(value);
+  }
+  std::printf("  %u attribute values, %u of them numbers\n", unsigned(values.size()), unsigned(numbers.size()));
+
+  measure("numbers, double_cast", [&numbers]()
+  {
+    double sum = 0;
+    for (const auto &value : numbers)
+      sum += libetonyek::double_cast(value.c_str());
+    keep(uint64_t(sum != 0));
+  }, 0, numbers.size());
+  measure("numbers, lexical_cast<double>", [&numbers]()
+  {
+    double sum = 0;
+    for (const auto &value : numbers)
+      sum += boost::lexical_cast<double, const char *>(value.c_str());
+    keep(uint64_t(sum != 0));
+  }, 0, numbers.size());
+
+  measure("all values, try_double_cast", [&values]()
+  {
+    uint64_t count = 0;
+    for (const auto &value : values)
+      count += libetonyek::try_double_cast(value.c_str()) ? 1 : 0;
+    keep(count);
+  }, 0, values.size());
+  measure("all values, lexical_cast<double> and catch", [&values]()
+  {
+    uint64_t count = 0;
+    for (const auto &value : values)
+      count += lexicalTryDouble(value.c_str()) ? 1 : 0;
+    keep(count);
+  }, 0, values.size());
+
+  measure("all values, try_int_cast", [&values]()
+  {
+    uint64_t count = 0;
+    for (const auto &value : values)
+      count += libetonyek::try_int_cast(value.c_str()) ? 1 : 0;
+    keep(count);
+  }, 0, values.size());
+  measure("all values, lexical_cast<int> and catch", [&values]()
+  {
+    uint64_t count = 0;
+    for (const auto &value : values)
+      count += lexicalTryInt(value.c_str()) ? 1 : 0;
+    keep(count);
+  }, 0, values.size());
+}
+
+const BenchmarkRegistration xmlNumbersRegistration("xmlnumbers", &benchXMLNumbers);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
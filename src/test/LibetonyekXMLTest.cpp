@@ -0,0 +1,178 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <boost/lexical_cast/bad_lexical_cast.hpp>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "libetonyek_xml.h"
+
+using libetonyek::double_cast;
+using libetonyek::int_cast;
+using libetonyek::parseDouble;
+using libetonyek::parseInt;
+using libetonyek::try_double_cast;
+using libetonyek::try_int_cast;
+using libetonyek::unsigned_cast;
+
+using std::numeric_limits;
+
+namespace test
+{
+
+namespace
+{
+
+/// Get the number of characters parseDouble() consumes.
+long parsedLength(const char *const value)
+{
+  double result = 0;
+  return parseDouble(value, value + std::strlen(value), result) - value;
+}
+
+}
+
+class LibetonyekXMLTest : public CPPUNIT_NS::TestFixture
+{
+public:
+  virtual void setUp();
+  virtual void tearDown();
+
+private:
+  CPPUNIT_TEST_SUITE(LibetonyekXMLTest);
+  CPPUNIT_TEST(testDoubleCast);
+  CPPUNIT_TEST(testDoubleRounding);
+  CPPUNIT_TEST(testParseDouble);
+  CPPUNIT_TEST(testIntCast);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  void testDoubleCast();
+  void testDoubleRounding();
+  void testParseDouble();
+  void testIntCast();
+};
+
+void LibetonyekXMLTest::setUp()
+{
+}
+
+void LibetonyekXMLTest::tearDown()
+{
+}
+
+void LibetonyekXMLTest::testDoubleCast()
+{
+  CPPUNIT_ASSERT_EQUAL(0.0, double_cast("0"));
+  CPPUNIT_ASSERT_EQUAL(1.0, double_cast("1"));
+  CPPUNIT_ASSERT_EQUAL(-1.5, double_cast("-1.5"));
+  CPPUNIT_ASSERT_EQUAL(1.5, double_cast("+1.5"));
+  CPPUNIT_ASSERT_EQUAL(0.5, double_cast(".5"));
+  CPPUNIT_ASSERT_EQUAL(5.0, double_cast("5."));
+  CPPUNIT_ASSERT_EQUAL(0.25, double_cast("0.250"));
+  CPPUNIT_ASSERT_EQUAL(1500.0, double_cast("1.5e3"));
+  CPPUNIT_ASSERT_EQUAL(0.0015, double_cast("1.5E-3"));
+  CPPUNIT_ASSERT_EQUAL(1e300, double_cast("1e300"));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<double>::infinity(), double_cast("inf"));
+  CPPUNIT_ASSERT_EQUAL(-numeric_limits<double>::infinity(), double_cast("-Infinity"));
+  CPPUNIT_ASSERT(std::isnan(double_cast("NaN")));
+  CPPUNIT_ASSERT(std::signbit(double_cast("-0")));
+
+  CPPUNIT_ASSERT_THROW(double_cast(""), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("-"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("."), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast(" 1"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("1 "), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("1,5"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("1e"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("1e999"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(double_cast("0x10"), boost::bad_lexical_cast);
+
+  CPPUNIT_ASSERT(try_double_cast("12.75"));
+  CPPUNIT_ASSERT_EQUAL(12.75, get(try_double_cast("12.75")));
+  CPPUNIT_ASSERT(!try_double_cast("abc"));
+  CPPUNIT_ASSERT(!try_double_cast("12.75pt"));
+}
+
+void LibetonyekXMLTest::testDoubleRounding()
+{
+  // the same as the compiler's conversion of the literal
+  CPPUNIT_ASSERT_EQUAL(0.1, double_cast("0.1"));
+  CPPUNIT_ASSERT_EQUAL(0.3, double_cast("0.3"));
+  CPPUNIT_ASSERT_EQUAL(123.456, double_cast("123.456"));
+  CPPUNIT_ASSERT_EQUAL(9007199254740993.0, double_cast("9007199254740993"));
+  CPPUNIT_ASSERT_EQUAL(0.1000000000000000055511151231257827, double_cast("0.1000000000000000055511151231257827"));
+  CPPUNIT_ASSERT_EQUAL(1.7976931348623157e308, double_cast("1.7976931348623157e308"));
+  CPPUNIT_ASSERT_EQUAL(4.9406564584124654e-324, double_cast("4.9406564584124654e-324"));
+  CPPUNIT_ASSERT_EQUAL(123456789012345678901234567890.0, double_cast("123456789012345678901234567890"));
+  CPPUNIT_ASSERT_EQUAL(1e-30, double_cast("0.000000000000000000000000000001"));
+}
+
+void LibetonyekXMLTest::testParseDouble()
+{
+  // parsing stops after the number
+  CPPUNIT_ASSERT_EQUAL(4L, parsedLength("12.5pt"));
+  CPPUNIT_ASSERT_EQUAL(1L, parsedLength("1e"));
+  CPPUNIT_ASSERT_EQUAL(2L, parsedLength("1.e+"));
+  CPPUNIT_ASSERT_EQUAL(3L, parsedLength("1e2 3"));
+  CPPUNIT_ASSERT_EQUAL(0L, parsedLength("x1"));
+  CPPUNIT_ASSERT_EQUAL(0L, parsedLength("+"));
+
+  // the value is not touched on failure
+  double value = 7;
+  const char *const text = "abc";
+  CPPUNIT_ASSERT(parseDouble(text, text + 3, value) == text);
+  CPPUNIT_ASSERT_EQUAL(7.0, value);
+
+  // the end is respected
+  const char *const number = "1234";
+  CPPUNIT_ASSERT(parseDouble(number, number + 2, value) == number + 2);
+  CPPUNIT_ASSERT_EQUAL(12.0, value);
+}
+
+void LibetonyekXMLTest::testIntCast()
+{
+  CPPUNIT_ASSERT_EQUAL(0, int_cast("0"));
+  CPPUNIT_ASSERT_EQUAL(42, int_cast("42"));
+  CPPUNIT_ASSERT_EQUAL(42, int_cast("+42"));
+  CPPUNIT_ASSERT_EQUAL(-42, int_cast("-42"));
+  CPPUNIT_ASSERT_EQUAL(7, int_cast("007"));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<int>::max(), int_cast("2147483647"));
+  CPPUNIT_ASSERT_EQUAL(numeric_limits<int>::min(), int_cast("-2147483648"));
+
+  CPPUNIT_ASSERT_THROW(int_cast(""), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(int_cast("-"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(int_cast("1.0"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(int_cast("2147483648"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(int_cast("-2147483649"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(int_cast("99999999999999999999"), boost::bad_lexical_cast);
+
+  CPPUNIT_ASSERT(!try_int_cast("x"));
+  CPPUNIT_ASSERT_EQUAL(-3, get(try_int_cast("-3")));
+
+  int value = 5;
+  const char *const text = "12;";
+  CPPUNIT_ASSERT(parseInt(text, text + 3, value) == text + 2);
+  CPPUNIT_ASSERT_EQUAL(12, value);
+
+  CPPUNIT_ASSERT_EQUAL(4294967295u, unsigned_cast("4294967295"));
+  CPPUNIT_ASSERT_THROW(unsigned_cast("4294967296"), boost::bad_lexical_cast);
+  CPPUNIT_ASSERT_THROW(unsigned_cast("-1"), boost::bad_lexical_cast);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LibetonyekXMLTest);
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
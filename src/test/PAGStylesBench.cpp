@@ -0,0 +1,97 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <string>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "IWORKMemoryStream.h"
+#include "PAG1Dictionary.h"
+#include "PAG1Parser.h"
+#include "PAG5Parser.h"
+#include "PAGCollector.h"
+
+#include "Bench.h"
+#include "TestDocumentInterface.h"
+
+namespace test
+{
+
+namespace
+{
+
+using libetonyek::IWORKMemoryStream;
+using libetonyek::PAG1Dictionary;
+using libetonyek::PAG1Parser;
+using libetonyek::PAG5Parser;
+using libetonyek::PAGCollector;
+using libetonyek::RVNGInputStreamPtr_t;
+
+uint64_t parseXML(const std::string &xml, const bool flatten)
+{
+  const RVNGInputStreamPtr_t input(new IWORKMemoryStream(reinterpret_cast<const unsigned char *>(xml.data()), unsigned(xml.size())));
+  RecordingDocumentInterface document;
+  PAGCollector collector(&document);
+  collector.setFlattenStyles(flatten);
+  PAG1Dictionary dict;
+  // there is no package, but the parser needs one
+  PAG1Parser parser(input, input, collector, &dict);
+  if (!parser.parse())
+    return 0;
+  return document.getLog().size();
+}
+
+uint64_t parseBinary(const std::string &path, const bool flatten)
+{
+  const RVNGInputStreamPtr_t package(new librevenge::RVNGFileStream(path.c_str()));
+  RecordingDocumentInterface document;
+  PAGCollector collector(&document);
+  PAG5Parser parser(package, package, collector);
+  parser.setFlattenStyles(flatten);
+  if (!parser.parse())
+    return 0;
+  return document.getLog().size();
+}
+
+/** Convert the Pages test documents with and without flattening of
+  * styles.
+  *
+  * Pages 4 documents have a lot of styles, in a hierarchy several
+  * levels deep.
+  */
+void benchStyles()
+{
+  const std::string xml(readCompressedDataFile("pages4.xml.gz"));
+  measure("pages4.xml.gz, linked styles", [&xml]()
+  {
+    keep(parseXML(xml, false));
+  });
+  measure("pages4.xml.gz, flattened styles", [&xml]()
+  {
+    keep(parseXML(xml, true));
+  });
+
+  const std::string path(getDataPath("pages5-file.pages"));
+  measure("pages5-file.pages, linked styles", [&path]()
+  {
+    keep(parseBinary(path, false));
+  });
+  measure("pages5-file.pages, flattened styles", [&path]()
+  {
+    keep(parseBinary(path, true));
+  });
+}
+
+const BenchmarkRegistration stylesRegistration("styles", &benchStyles);
+
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -0,0 +1,548 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TestDocumentInterface.h"
+
+namespace test
+{
+
+namespace
+{
+
+void appendPropList(const librevenge::RVNGPropertyList &propList, std::string &log)
+{
+  log += '{';
+  librevenge::RVNGPropertyList::Iter i(propList);
+  for (i.rewind(); i.next();)
+  {
+    log += i.key();
+    log += '=';
+    if (i.child())
+    {
+      log += '[';
+      for (unsigned long j = 0; j < i.child()->count(); ++j)
+        appendPropList((*i.child())[j], log);
+      log += ']';
+    }
+    else if (i())
+    {
+      log += i()->getStr().cstr();
+    }
+    log += ';';
+  }
+  log += '}';
+}
+
+}
+
+RecordingDocumentInterface::RecordingDocumentInterface()
+  : m_log()
+{
+}
+
+const std::string &RecordingDocumentInterface::getLog() const
+{
+  return m_log;
+}
+
+void RecordingDocumentInterface::setDocumentMetaData(const librevenge::RVNGPropertyList &propList)
+{
+  record("setDocumentMetaData", propList);
+}
+
+void RecordingDocumentInterface::startDocument(const librevenge::RVNGPropertyList &propList)
+{
+  record("startDocument", propList);
+}
+
+void RecordingDocumentInterface::endDocument()
+{
+  record("endDocument");
+}
+
+void RecordingDocumentInterface::definePageStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("definePageStyle", propList);
+}
+
+void RecordingDocumentInterface::defineEmbeddedFont(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineEmbeddedFont", propList);
+}
+
+void RecordingDocumentInterface::openPageSpan(const librevenge::RVNGPropertyList &propList)
+{
+  record("openPageSpan", propList);
+}
+
+void RecordingDocumentInterface::closePageSpan()
+{
+  record("closePageSpan");
+}
+
+void RecordingDocumentInterface::startSlide(const librevenge::RVNGPropertyList &propList)
+{
+  record("startSlide", propList);
+}
+
+void RecordingDocumentInterface::endSlide()
+{
+  record("endSlide");
+}
+
+void RecordingDocumentInterface::startMasterSlide(const librevenge::RVNGPropertyList &propList)
+{
+  record("startMasterSlide", propList);
+}
+
+void RecordingDocumentInterface::endMasterSlide()
+{
+  record("endMasterSlide");
+}
+
+void RecordingDocumentInterface::setStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("setStyle", propList);
+}
+
+void RecordingDocumentInterface::startLayer(const librevenge::RVNGPropertyList &propList)
+{
+  record("startLayer", propList);
+}
+
+void RecordingDocumentInterface::endLayer()
+{
+  record("endLayer");
+}
+
+void RecordingDocumentInterface::openHeader(const librevenge::RVNGPropertyList &propList)
+{
+  record("openHeader", propList);
+}
+
+void RecordingDocumentInterface::closeHeader()
+{
+  record("closeHeader");
+}
+
+void RecordingDocumentInterface::openFooter(const librevenge::RVNGPropertyList &propList)
+{
+  record("openFooter", propList);
+}
+
+void RecordingDocumentInterface::closeFooter()
+{
+  record("closeFooter");
+}
+
+void RecordingDocumentInterface::defineParagraphStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineParagraphStyle", propList);
+}
+
+void RecordingDocumentInterface::openParagraph(const librevenge::RVNGPropertyList &propList)
+{
+  record("openParagraph", propList);
+}
+
+void RecordingDocumentInterface::closeParagraph()
+{
+  record("closeParagraph");
+}
+
+void RecordingDocumentInterface::defineCharacterStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineCharacterStyle", propList);
+}
+
+void RecordingDocumentInterface::openSpan(const librevenge::RVNGPropertyList &propList)
+{
+  record("openSpan", propList);
+}
+
+void RecordingDocumentInterface::closeSpan()
+{
+  record("closeSpan");
+}
+
+void RecordingDocumentInterface::openLink(const librevenge::RVNGPropertyList &propList)
+{
+  record("openLink", propList);
+}
+
+void RecordingDocumentInterface::closeLink()
+{
+  record("closeLink");
+}
+
+void RecordingDocumentInterface::defineSectionStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineSectionStyle", propList);
+}
+
+void RecordingDocumentInterface::openSection(const librevenge::RVNGPropertyList &propList)
+{
+  record("openSection", propList);
+}
+
+void RecordingDocumentInterface::closeSection()
+{
+  record("closeSection");
+}
+
+void RecordingDocumentInterface::insertTab()
+{
+  record("insertTab");
+}
+
+void RecordingDocumentInterface::insertSpace()
+{
+  record("insertSpace");
+}
+
+void RecordingDocumentInterface::insertText(const librevenge::RVNGString &text)
+{
+  record("insertText", text);
+}
+
+void RecordingDocumentInterface::insertLineBreak()
+{
+  record("insertLineBreak");
+}
+
+void RecordingDocumentInterface::insertField(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertField", propList);
+}
+
+void RecordingDocumentInterface::openOrderedListLevel(const librevenge::RVNGPropertyList &propList)
+{
+  record("openOrderedListLevel", propList);
+}
+
+void RecordingDocumentInterface::openUnorderedListLevel(const librevenge::RVNGPropertyList &propList)
+{
+  record("openUnorderedListLevel", propList);
+}
+
+void RecordingDocumentInterface::closeOrderedListLevel()
+{
+  record("closeOrderedListLevel");
+}
+
+void RecordingDocumentInterface::closeUnorderedListLevel()
+{
+  record("closeUnorderedListLevel");
+}
+
+void RecordingDocumentInterface::openListElement(const librevenge::RVNGPropertyList &propList)
+{
+  record("openListElement", propList);
+}
+
+void RecordingDocumentInterface::closeListElement()
+{
+  record("closeListElement");
+}
+
+void RecordingDocumentInterface::openFootnote(const librevenge::RVNGPropertyList &propList)
+{
+  record("openFootnote", propList);
+}
+
+void RecordingDocumentInterface::closeFootnote()
+{
+  record("closeFootnote");
+}
+
+void RecordingDocumentInterface::openEndnote(const librevenge::RVNGPropertyList &propList)
+{
+  record("openEndnote", propList);
+}
+
+void RecordingDocumentInterface::closeEndnote()
+{
+  record("closeEndnote");
+}
+
+void RecordingDocumentInterface::openComment(const librevenge::RVNGPropertyList &propList)
+{
+  record("openComment", propList);
+}
+
+void RecordingDocumentInterface::closeComment()
+{
+  record("closeComment");
+}
+
+void RecordingDocumentInterface::openTextBox(const librevenge::RVNGPropertyList &propList)
+{
+  record("openTextBox", propList);
+}
+
+void RecordingDocumentInterface::closeTextBox()
+{
+  record("closeTextBox");
+}
+
+void RecordingDocumentInterface::defineSheetNumberingStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineSheetNumberingStyle", propList);
+}
+
+void RecordingDocumentInterface::openTable(const librevenge::RVNGPropertyList &propList)
+{
+  record("openTable", propList);
+}
+
+void RecordingDocumentInterface::openTableRow(const librevenge::RVNGPropertyList &propList)
+{
+  record("openTableRow", propList);
+}
+
+void RecordingDocumentInterface::closeTableRow()
+{
+  record("closeTableRow");
+}
+
+void RecordingDocumentInterface::openTableCell(const librevenge::RVNGPropertyList &propList)
+{
+  record("openTableCell", propList);
+}
+
+void RecordingDocumentInterface::closeTableCell()
+{
+  record("closeTableCell");
+}
+
+void RecordingDocumentInterface::insertCoveredTableCell(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertCoveredTableCell", propList);
+}
+
+void RecordingDocumentInterface::closeTable()
+{
+  record("closeTable");
+}
+
+void RecordingDocumentInterface::openFrame(const librevenge::RVNGPropertyList &propList)
+{
+  record("openFrame", propList);
+}
+
+void RecordingDocumentInterface::closeFrame()
+{
+  record("closeFrame");
+}
+
+void RecordingDocumentInterface::insertBinaryObject(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertBinaryObject", propList);
+}
+
+void RecordingDocumentInterface::insertEquation(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertEquation", propList);
+}
+
+void RecordingDocumentInterface::openGroup(const librevenge::RVNGPropertyList &propList)
+{
+  record("openGroup", propList);
+}
+
+void RecordingDocumentInterface::closeGroup()
+{
+  record("closeGroup");
+}
+
+void RecordingDocumentInterface::defineGraphicStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineGraphicStyle", propList);
+}
+
+void RecordingDocumentInterface::drawRectangle(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawRectangle", propList);
+}
+
+void RecordingDocumentInterface::drawEllipse(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawEllipse", propList);
+}
+
+void RecordingDocumentInterface::drawPolygon(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawPolygon", propList);
+}
+
+void RecordingDocumentInterface::drawPolyline(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawPolyline", propList);
+}
+
+void RecordingDocumentInterface::drawPath(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawPath", propList);
+}
+
+void RecordingDocumentInterface::drawGraphicObject(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawGraphicObject", propList);
+}
+
+void RecordingDocumentInterface::drawConnector(const librevenge::RVNGPropertyList &propList)
+{
+  record("drawConnector", propList);
+}
+
+void RecordingDocumentInterface::startTextObject(const librevenge::RVNGPropertyList &propList)
+{
+  record("startTextObject", propList);
+}
+
+void RecordingDocumentInterface::endTextObject()
+{
+  record("endTextObject");
+}
+
+void RecordingDocumentInterface::startNotes(const librevenge::RVNGPropertyList &propList)
+{
+  record("startNotes", propList);
+}
+
+void RecordingDocumentInterface::endNotes()
+{
+  record("endNotes");
+}
+
+void RecordingDocumentInterface::defineChartStyle(const librevenge::RVNGPropertyList &propList)
+{
+  record("defineChartStyle", propList);
+}
+
+void RecordingDocumentInterface::openChart(const librevenge::RVNGPropertyList &propList)
+{
+  record("openChart", propList);
+}
+
+void RecordingDocumentInterface::closeChart()
+{
+  record("closeChart");
+}
+
+void RecordingDocumentInterface::openChartTextObject(const librevenge::RVNGPropertyList &propList)
+{
+  record("openChartTextObject", propList);
+}
+
+void RecordingDocumentInterface::closeChartTextObject()
+{
+  record("closeChartTextObject");
+}
+
+void RecordingDocumentInterface::openChartPlotArea(const librevenge::RVNGPropertyList &propList)
+{
+  record("openChartPlotArea", propList);
+}
+
+void RecordingDocumentInterface::closeChartPlotArea()
+{
+  record("closeChartPlotArea");
+}
+
+void RecordingDocumentInterface::insertChartAxis(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertChartAxis", propList);
+}
+
+void RecordingDocumentInterface::openChartSeries(const librevenge::RVNGPropertyList &propList)
+{
+  record("openChartSeries", propList);
+}
+
+void RecordingDocumentInterface::closeChartSeries()
+{
+  record("closeChartSeries");
+}
+
+void RecordingDocumentInterface::openAnimationSequence(const librevenge::RVNGPropertyList &propList)
+{
+  record("openAnimationSequence", propList);
+}
+
+void RecordingDocumentInterface::closeAnimationSequence()
+{
+  record("closeAnimationSequence");
+}
+
+void RecordingDocumentInterface::openAnimationGroup(const librevenge::RVNGPropertyList &propList)
+{
+  record("openAnimationGroup", propList);
+}
+
+void RecordingDocumentInterface::closeAnimationGroup()
+{
+  record("closeAnimationGroup");
+}
+
+void RecordingDocumentInterface::openAnimationIteration(const librevenge::RVNGPropertyList &propList)
+{
+  record("openAnimationIteration", propList);
+}
+
+void RecordingDocumentInterface::closeAnimationIteration()
+{
+  record("closeAnimationIteration");
+}
+
+void RecordingDocumentInterface::insertMotionAnimation(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertMotionAnimation", propList);
+}
+
+void RecordingDocumentInterface::insertColorAnimation(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertColorAnimation", propList);
+}
+
+void RecordingDocumentInterface::insertAnimation(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertAnimation", propList);
+}
+
+void RecordingDocumentInterface::insertEffect(const librevenge::RVNGPropertyList &propList)
+{
+  record("insertEffect", propList);
+}
+
+void RecordingDocumentInterface::record(const char *const name)
+{
+  m_log += name;
+  m_log += '\n';
+}
+
+void RecordingDocumentInterface::record(const char *const name, const librevenge::RVNGString &text)
+{
+  m_log += name;
+  m_log += " [";
+  m_log += text.cstr();
+  m_log += "]\n";
+}
+
+void RecordingDocumentInterface::record(const char *const name, const librevenge::RVNGPropertyList &propList)
+{
+  m_log += name;
+  m_log += ' ';
+  appendPropList(propList, m_log);
+  m_log += '\n';
+}
+
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */
@@ -12,8 +12,8 @@
 namespace libetonyek
 {
 
-const IWORKPropertyID_t IWORKPropertyInfo<property::Answer>::id = "Answer";
-const IWORKPropertyID_t IWORKPropertyInfo<property::Antwort>::id = "Antwort";
+IWORK_IMPLEMENT_PROPERTY(Answer);
+IWORK_IMPLEMENT_PROPERTY(Antwort);
 
 }
 
@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 2; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/*
+ * This file is part of the libetonyek project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include "IWORKZlibStream.h"
+#include "libetonyek_utils.h"
+
+#include "Bench.h"
+
+#if !defined ETONYEK_BENCH_DATA_DIR
+#error ETONYEK_BENCH_DATA_DIR not defined, cannot benchmark
+#endif
+
+namespace test
+{
+
+namespace
+{
+
+typedef std::vector<std::pair<const char *, void (*)()> > BenchmarkList_t;
+
+BenchmarkList_t &getBenchmarks()
+{
+  static BenchmarkList_t benchmarks;
+  return benchmarks;
+}
+
+const unsigned ROUNDS = 5;
+const double MIN_ROUND_TIME = 0.1; // in seconds
+
+volatile uint64_t sink = 0;
+
+double runRound(const std::function<void()> &function, const unsigned long calls)
+{
+  typedef std::chrono::steady_clock Clock_t;
+  const Clock_t::time_point start = Clock_t::now();
+  for (unsigned long i = 0; i < calls; ++i)
+    function();
+  return std::chrono::duration<double>(Clock_t::now() - start).count();
+}
+
+}
+
+BenchmarkRegistration::BenchmarkRegistration(const char *const name, void (*const function)())
+{
+  getBenchmarks().push_back(std::make_pair(name, function));
+}
+
+void measure(const std::string &label, const std::function<void()> &function, const std::size_t bytes, const std::size_t items)
+{
+  // find a number of calls that takes long enough to be measured
+  unsigned long calls = 1;
+  while (runRound(function, calls) < MIN_ROUND_TIME)
+    calls *= 2;
+
+  double best = 0;
+  for (unsigned round = 0; round < ROUNDS; ++round)
+  {
+    const double time = runRound(function, calls) / double(calls);
+    if ((round == 0) || (time < best))
+      best = time;
+  }
+
+  std::printf("  %-44s %12.3f us", label.c_str(), best * 1e6);
+  if (bytes != 0)
+    std::printf(" %10.1f MB/s", double(bytes) / best / 1e6);
+  if (items != 0)
+    std::printf(" %10.2f M/s", double(items) / best / 1e6);
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+void keep(const uint64_t value)
+{
+  sink = sink + value;
+}
+
+std::string getDataPath(const std::string &name)
+{
+  return std::string(ETONYEK_BENCH_DATA_DIR) + "/" + name;
+}
+
+std::vector<unsigned char> readDataFile(const std::string &name)
+{
+  const std::string path(getDataPath(name));
+  std::ifstream input(path.c_str(), std::ios::binary);
+  if (!input)
+    throw std::runtime_error("cannot open " + path);
+  return std::vector<unsigned char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+std::string readCompressedDataFile(const std::string &name)
+{
+  const std::string path(getDataPath(name));
+  const libetonyek::RVNGInputStreamPtr_t file(new librevenge::RVNGFileStream(path.c_str()));
+  libetonyek::IWORKZlibStream input(file);
+  std::string data;
+  unsigned long read = 0;
+  while (!input.isEnd())
+  {
+    const unsigned char *const bytes = input.read(65536, read);
+    if (!bytes || (read == 0))
+      break;
+    data.append(reinterpret_cast<const char *>(bytes), read);
+  }
+  if (data.empty())
+    throw std::runtime_error("cannot read " + path);
+  return data;
+}
+
+}
+
+/** Run the benchmarks whose names contain one of the arguments, or all
+  * of them if there are no arguments.
+  */
+int main(int argc, char **argv)
+{
+  for (const auto &benchmark : test::getBenchmarks())
+  {
+    bool selected = argc < 2;
+    for (int i = 1; (i < argc) && !selected; ++i)
+      selected = std::strstr(benchmark.first, argv[i]);
+    if (!selected)
+      continue;
+    std::printf("%s\n", benchmark.first);
+    benchmark.second();
+  }
+  return 0;
+}
+
+/* vim:set shiftwidth=2 softtabstop=2 expandtab: */